@@ -0,0 +1,74 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "ClpSimplex.hpp"
+#include "ClpQuadraticObjective.hpp"
+#include "CoinTime.hpp"
+#include <cstdio>
+#include <cmath>
+int main(int argc, const char *argv[])
+{
+     /* Times quadratic primal (ClpSimplexNonlinear) with and without
+        incremental gradient.
+
+        Arguments are QP files in QUADOBJ format (e.g. the Maros-Meszaros
+        set) - benchQP AUG2DC.SIF CVXQP1_M.SIF ...
+        If no arguments does share2qp from the sample directory.
+     */
+     int numberFiles = argc - 1;
+     const char **files = argv + 1;
+#if defined(SAMPLEDIR)
+     const char *defaultFile = SAMPLEDIR "/share2qp.mps";
+#else
+     const char *defaultFile = "share2qp.mps";
+#endif
+     if (!numberFiles) {
+          numberFiles = 1;
+          files = &defaultFile;
+     }
+     printf("%-20s %8s %8s %10s %10s %6s %6s %18s %10s\n", "problem", "rows", "columns",
+            "full(s)", "update(s)", "upd", "full", "objective", "difference");
+     int numberBad = 0;
+     for (int iFile = 0; iFile < numberFiles; iFile++) {
+          ClpSimplex model;
+          model.setLogLevel(0);
+          if (model.readMps(files[iFile])) {
+               printf("%-20s errors on input\n", files[iFile]);
+               numberBad++;
+               continue;
+          }
+          ClpQuadraticObjective *quadraticObj =
+               dynamic_cast< ClpQuadraticObjective * >(model.objectiveAsObject());
+          if (!quadraticObj) {
+               printf("%-20s not a QP\n", files[iFile]);
+               continue;
+          }
+          double time[2];
+          double objective[2];
+          int status[2];
+          for (int iPass = 0; iPass < 2; iPass++) {
+               ClpSimplex solver(model);
+               solver.setLogLevel(0);
+               ClpQuadraticObjective *obj =
+                    static_cast< ClpQuadraticObjective * >(solver.objectiveAsObject());
+               // first pass full gradient every time
+               obj->setIncrementalGradient(iPass != 0);
+               double time1 = CoinCpuTime();
+               solver.primal();
+               time[iPass] = CoinCpuTime() - time1;
+               objective[iPass] = solver.objectiveValue();
+               status[iPass] = solver.status();
+               if (iPass)
+                    printf("%-20s %8d %8d %10.3f %10.3f %6d %6d %18.10g %10.2g%s\n",
+                           files[iFile], model.numberRows(), model.numberColumns(),
+                           time[0], time[1], obj->numberIncrementalGradients(),
+                           obj->numberFullGradients(), objective[1],
+                           objective[1] - objective[0],
+                           status[0] || status[1] ? " (not optimal)" : "");
+          }
+          if (fabs(objective[1] - objective[0]) > 1.0e-6 * (1.0 + fabs(objective[0])))
+               numberBad++;
+     }
+     return numberBad ? 1 : 0;
+}
@@ -82,6 +82,10 @@ ClpPdcoBase * myPdco::clone() const
      return new myPdco(*this);
 }
 
+/* The matrix is never formed (model has a ClpDummyMatrix) so products
+   are done from the links here.  If the matrix were loaded into model
+   then ClpPdcoBase::matrixVecMult and matrixPrecon could be used
+   instead (and are split over ClpTaskPool threads). */
 void myPdco::matVecMult(ClpInterior * model,  int mode, double* x_elts, double* y_elts) const
 {
      int nrow = model->numberRows();
@@ -324,6 +324,16 @@ public:
   {
     coinAbcFactorization_->areaFactor(value);
   }
+  /// Memory mode (1 size areas from last time, 2 huge pages)
+  inline int memoryMode() const
+  {
+    return coinAbcFactorization_->memoryMode();
+  }
+  /// Set memory mode
+  inline void setMemoryMode(int value)
+  {
+    coinAbcFactorization_->setMemoryMode(value);
+  }
   /// Zero tolerance
   inline double zeroTolerance() const
   {
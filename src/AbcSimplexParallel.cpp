@@ -15,6 +15,7 @@
 #include "AbcDualRowDantzig.hpp"
 #include "ClpMessage.hpp"
 #include "ClpLinearObjective.hpp"
+#include "ClpTaskPool.hpp"
 #include <cfloat>
 #include <cassert>
 #include <string>
@@ -1867,16 +1868,17 @@ void parallelDual5(AbcSimplexFactorization *factorization,
    2 Left Lower Transpose Unit
    3 Left Upper Transpose NonUnit
 */
-static void CoinAbcDtrsmFactor(int m, int n, double *COIN_RESTRICT a, int lda)
+static void CoinAbcDtrsmFactor(int m, int n, double *COIN_RESTRICT a,
+  double *COIN_RESTRICT b, int lda)
 {
   assert((m & (BLOCKING8 - 1)) == 0 && (n & (BLOCKING8 - 1)) == 0);
   assert(m == BLOCKING8);
   // 0 Left Lower NoTranspose Unit
   /* entry for column j and row i (when multiple of BLOCKING8)
      is at aBlocked+j*m+i*BLOCKING8
+     b is first column to be updated (normally a+lda*BLOCKING8)
   */
-  double *COIN_RESTRICT aBase2 = a;
-  double *COIN_RESTRICT bBase2 = aBase2 + lda * BLOCKING8;
+  double *COIN_RESTRICT bBase2 = b;
   for (int jj = 0; jj < n; jj += BLOCKING8) {
     double *COIN_RESTRICT bBase = bBase2;
     for (int j = jj; j < jj + BLOCKING8; j++) {
@@ -2488,6 +2490,44 @@ static int CoinAbcDgetrf2(int m, int n, double *COIN_RESTRICT a, int *ipiv)
   return 0;
 }
 
+#if ABC_PARALLEL != 2
+// Trailing columns below this many are updated serially
+#define ABC_DGETRF_PARALLEL 256
+typedef struct {
+  double *a;
+  int *ipiv;
+  int lda;
+  int n;
+  int start;
+  int end;
+} abcDgetrfTrailing;
+/* Update of trailing columns [first,last) (in blocks of BLOCKING8) after
+   strip start to end has been factorized.  Each block of columns only
+   touches its own columns so blocks can be done in any order and
+   arithmetic is the same as doing all at once. */
+static void abcDgetrfTrailingRange(void *info, int first, int last, int)
+{
+  abcDgetrfTrailing *stuff = reinterpret_cast< abcDgetrfTrailing * >(info);
+  double *COIN_RESTRICT a = stuff->a;
+  int lda = stuff->lda;
+  int n = stuff->n;
+  int start = stuff->start;
+  int end = stuff->end;
+  int firstColumn = end + first * BLOCKING8;
+  int numberColumns = (last - first) * BLOCKING8;
+  // swap >=end
+  CoinAbcDlaswp(numberColumns, a + firstColumn * lda, lda, start, end, stuff->ipiv);
+  CoinAbcDtrsmFactor(end - start, numberColumns, a + (start * lda + start * BLOCKING8),
+    a + (firstColumn * lda + start * BLOCKING8), lda);
+  CoinAbcDgemm(n - end, numberColumns, end - start,
+    a + start * lda + end * BLOCKING8, lda,
+    a + firstColumn * lda + start * BLOCKING8, a + firstColumn * lda + end * BLOCKING8);
+}
+#endif
+/* If ClpTaskPool::shared has been created with threads then (when not
+   using cilk) the update of trailing columns is split between threads.
+   Pivoting is still done one strip at a time so the pivot sequence
+   and result are the same as the serial code. */
 int CoinAbcDgetrf(int m, int n, double *COIN_RESTRICT a, int lda, int *ipiv
 #if ABC_PARALLEL == 2
   ,
@@ -2500,6 +2540,11 @@ int CoinAbcDgetrf(int m, int n, double *COIN_RESTRICT a, int lda, int *ipiv
   if (m < BLOCKING8) {
     return CoinAbcDgetrf2(m, n, a, ipiv);
   } else {
+#if ABC_PARALLEL != 2
+    ClpTaskPool *pool = ClpTaskPool::sharedIfExists();
+    if (pool && !pool->numberThreads())
+      pool = NULL;
+#endif
     for (int j = 0; j < n; j += BLOCKING8) {
       int start = j;
       int newSize = CoinMin(BLOCKING8, n - j);
@@ -2513,9 +2558,25 @@ int CoinAbcDgetrf(int m, int n, double *COIN_RESTRICT a, int lda, int *ipiv
         // swap 0<start
         CoinAbcDlaswp(start, a, lda, start, end, ipiv);
         if (end < n) {
+#if ABC_PARALLEL != 2
+          if (pool && n - end >= ABC_DGETRF_PARALLEL) {
+            abcDgetrfTrailing stuff;
+            stuff.a = a;
+            stuff.ipiv = ipiv;
+            stuff.lda = lda;
+            stuff.n = n;
+            stuff.start = start;
+            stuff.end = end;
+            // work in blocks of columns - at least 64 columns each
+            pool->parallelFor(0, (n - end) / BLOCKING8, 64 / BLOCKING8,
+              abcDgetrfTrailingRange, &stuff);
+            continue;
+          }
+#endif
           // swap >=end
           CoinAbcDlaswp(n - end, a + end * lda, lda, start, end, ipiv);
-          CoinAbcDtrsmFactor(newSize, n - end, a + (start * lda + start * BLOCKING8), lda);
+          CoinAbcDtrsmFactor(newSize, n - end, a + (start * lda + start * BLOCKING8),
+            a + (end * lda + start * BLOCKING8), lda);
           CoinAbcDgemm(n - end, n - end, newSize,
             a + start * lda + end * BLOCKING8, lda,
             a + end * lda + start * BLOCKING8, a + end * lda + end * BLOCKING8
@@ -1668,6 +1668,18 @@ void establishParams(std::vector< CbcOrClpParam > &parameters)
     "Decide whether to use A Basic Optimization Code (Accelerated?) \
 and whether to try going parallel!");
   parameters.push_back(paramAboca);
+  {
+    CbcOrClpParam p("abcMem!ory", "How Aboca factorization gets memory",
+      "off", CLP_PARAM_STR_ABCMEMORY, 7, 0);
+    p.append("size");
+    p.append("huge");
+    p.append("both");
+    p.setLonghelp(
+      "If 'size' then factorization areas are sized from what the last \
+factorization used, so fewer reallocations.  If 'huge' then large areas \
+are advised to use huge pages (Linux).  'both' does both.");
+    parameters.push_back(p);
+  }
 #endif
   {
     CbcOrClpParam p("allC!ommands", "Whether to print less used commands",
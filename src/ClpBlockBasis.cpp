@@ -0,0 +1,1069 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <cassert>
+#include <cmath>
+
+#include "CoinPragma.hpp"
+#include "ClpBlockBasis.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "ClpSimplex.hpp"
+#include "ClpMatrixBase.hpp"
+#include "ClpTaskPool.hpp"
+#include "CoinIndexedVector.hpp"
+
+//#############################################################################
+// Constructors / Destructor / Assignment
+//#############################################################################
+
+//-------------------------------------------------------------------
+// Default Constructor
+//-------------------------------------------------------------------
+ClpBlockBasis::ClpBlockBasis()
+  : numberRows_(0)
+  , numberBlocks_(0)
+  , largestBlock_(0)
+  , numberEtas_(0)
+  , maximumEtas_(0)
+  , etaCapacity_(0)
+  , zeroTolerance_(1.0e-13)
+  , numberBorder_(0)
+  , order_(NULL)
+  , blockStart_(NULL)
+  , offStart_(NULL)
+  , offRow_(NULL)
+  , offElement_(NULL)
+  , denseStart_(NULL)
+  , dense_(NULL)
+  , densePivot_(NULL)
+  , etaRow_(NULL)
+  , etaPivot_(NULL)
+  , etaStart_(NULL)
+  , etaIndex_(NULL)
+  , etaElement_(NULL)
+  , blockWork_(NULL)
+  , schur_(NULL)
+  , schurPivot_(NULL)
+  , borderWork_(NULL)
+{
+}
+//-------------------------------------------------------------------
+// Copy constructor
+//-------------------------------------------------------------------
+ClpBlockBasis::ClpBlockBasis(const ClpBlockBasis &rhs)
+{
+  gutsOfCopy(rhs);
+}
+//-------------------------------------------------------------------
+// Destructor
+//-------------------------------------------------------------------
+ClpBlockBasis::~ClpBlockBasis()
+{
+  gutsOfDelete();
+}
+//----------------------------------------------------------------
+// Assignment operator
+//-------------------------------------------------------------------
+ClpBlockBasis &
+ClpBlockBasis::operator=(const ClpBlockBasis &rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+// Frees everything
+void ClpBlockBasis::gutsOfDelete()
+{
+  delete[] order_;
+  delete[] blockStart_;
+  delete[] offStart_;
+  delete[] offRow_;
+  delete[] offElement_;
+  delete[] denseStart_;
+  delete[] dense_;
+  delete[] densePivot_;
+  delete[] etaRow_;
+  delete[] etaPivot_;
+  delete[] etaStart_;
+  delete[] etaIndex_;
+  delete[] etaElement_;
+  delete[] blockWork_;
+  delete[] schur_;
+  delete[] schurPivot_;
+  delete[] borderWork_;
+  order_ = NULL;
+  blockStart_ = NULL;
+  offStart_ = NULL;
+  offRow_ = NULL;
+  offElement_ = NULL;
+  denseStart_ = NULL;
+  dense_ = NULL;
+  densePivot_ = NULL;
+  etaRow_ = NULL;
+  etaPivot_ = NULL;
+  etaStart_ = NULL;
+  etaIndex_ = NULL;
+  etaElement_ = NULL;
+  blockWork_ = NULL;
+  schur_ = NULL;
+  schurPivot_ = NULL;
+  borderWork_ = NULL;
+  numberRows_ = 0;
+  numberBlocks_ = 0;
+  largestBlock_ = 0;
+  numberEtas_ = 0;
+  maximumEtas_ = 0;
+  etaCapacity_ = 0;
+  numberBorder_ = 0;
+}
+// Copies everything
+void ClpBlockBasis::gutsOfCopy(const ClpBlockBasis &rhs)
+{
+  numberRows_ = rhs.numberRows_;
+  numberBlocks_ = rhs.numberBlocks_;
+  largestBlock_ = rhs.largestBlock_;
+  numberEtas_ = rhs.numberEtas_;
+  maximumEtas_ = rhs.maximumEtas_;
+  etaCapacity_ = rhs.etaCapacity_;
+  zeroTolerance_ = rhs.zeroTolerance_;
+  numberBorder_ = rhs.numberBorder_;
+  CoinBigIndex numberOff = rhs.offStart_ ? rhs.offStart_[numberRows_] : 0;
+  CoinBigIndex numberDense = rhs.denseStart_ ? rhs.denseStart_[numberBlocks_] : 0;
+  order_ = CoinCopyOfArray(rhs.order_, numberRows_);
+  blockStart_ = CoinCopyOfArray(rhs.blockStart_, numberBlocks_ + 1);
+  offStart_ = CoinCopyOfArray(rhs.offStart_, numberRows_ + 1);
+  offRow_ = CoinCopyOfArray(rhs.offRow_, numberOff);
+  offElement_ = CoinCopyOfArray(rhs.offElement_, numberOff);
+  denseStart_ = CoinCopyOfArray(rhs.denseStart_, numberBlocks_ + 1);
+  dense_ = CoinCopyOfArray(rhs.dense_, numberDense);
+  densePivot_ = CoinCopyOfArray(rhs.densePivot_, numberRows_);
+  etaRow_ = CoinCopyOfArray(rhs.etaRow_, maximumEtas_);
+  etaPivot_ = CoinCopyOfArray(rhs.etaPivot_, maximumEtas_);
+  etaStart_ = CoinCopyOfArray(rhs.etaStart_, maximumEtas_ + 1);
+  etaIndex_ = CoinCopyOfArray(rhs.etaIndex_, etaCapacity_);
+  etaElement_ = CoinCopyOfArray(rhs.etaElement_, etaCapacity_);
+  blockWork_ = rhs.blockWork_ ? new double[largestBlock_] : NULL;
+  schur_ = CoinCopyOfArray(rhs.schur_, numberBorder_ * numberBorder_);
+  schurPivot_ = CoinCopyOfArray(rhs.schurPivot_, numberBorder_);
+  if (rhs.borderWork_) {
+    borderWork_ = new double[numberRows_ + numberBorder_];
+    CoinZeroN(borderWork_, numberRows_ + numberBorder_);
+  } else {
+    borderWork_ = NULL;
+  }
+}
+/* Factorizes basis.
+   Basis column k is matched to a row r (maximum transversal) and is
+   then the basic variable for pivot row r.  Strongly connected
+   components of graph with arc r->i if basis column for r has an
+   element in row i give the diagonal blocks.
+   With side rows columns are matched to other rows along a spanning
+   forest and the rest (border) are matched to side rows. */
+int ClpBlockBasis::factorize(ClpSimplex *model, const int *pivotTemp,
+  int numberRowBasic, int maximumBlockSize, double zeroTolerance,
+  const char *sideRow, int maximumBorder)
+{
+  gutsOfDelete();
+  int numberRows = model->numberRows();
+  int numberColumns = model->numberColumns();
+  ClpMatrixBase *matrix = model->clpMatrix();
+  zeroTolerance_ = zeroTolerance;
+  int numberSide = 0;
+  if (sideRow) {
+    for (int i = 0; i < numberRows; i++) {
+      if (sideRow[i])
+        numberSide++;
+    }
+    if (numberSide > maximumBorder)
+      return 1;
+  }
+  // get basis by column (slacks first)
+  int numberColumnBasic = numberRows - numberRowBasic;
+  CoinBigIndex numberElements = numberRowBasic
+    + matrix->countBasis(pivotTemp + numberRowBasic, numberColumnBasic);
+  int *start = new int[numberRows + 1];
+  int *row = new int[numberElements];
+  CoinFactorizationDouble *element = new CoinFactorizationDouble[numberElements];
+  int *rowCount = new int[numberRows];
+  int *columnCount = new int[numberRows];
+  CoinZeroN(rowCount, numberRows);
+  for (int i = 0; i < numberRowBasic; i++) {
+    start[i] = i;
+    row[i] = pivotTemp[i];
+    element[i] = -1.0; // slack value
+    rowCount[pivotTemp[i]]++;
+    columnCount[i] = 1;
+  }
+  start[numberRowBasic] = numberRowBasic;
+  matrix->fillBasis(model, pivotTemp + numberRowBasic, numberColumnBasic,
+    row, start + numberRowBasic, rowCount, columnCount + numberRowBasic,
+    element);
+  assert(numberRowBasic + numberColumnBasic == numberRows);
+  delete[] rowCount;
+  delete[] columnCount;
+  int *rowMatch = new int[numberRows];
+  int *columnMatch = new int[numberRows];
+  int *stackColumn = new int[numberRows];
+  int *stackRow = new int[numberRows];
+  CoinBigIndex *next = new CoinBigIndex[numberRows];
+  int *visited = new int[numberRows];
+  for (int i = 0; i < numberRows; i++) {
+    rowMatch[i] = -1;
+    columnMatch[i] = -1;
+    visited[i] = -1;
+  }
+  bool singular = false;
+  if (!sideRow) {
+    // maximum transversal (depth first with look ahead as MC21)
+    // cheap assignment first
+    for (int k = 0; k < numberRows; k++) {
+      for (CoinBigIndex j = start[k]; j < start[k + 1]; j++) {
+        int iRow = row[j];
+        if (rowMatch[iRow] < 0) {
+          rowMatch[iRow] = k;
+          columnMatch[k] = iRow;
+          break;
+        }
+      }
+    }
+    for (int kStart = 0; kStart < numberRows; kStart++) {
+      if (columnMatch[kStart] >= 0)
+        continue;
+      int depth = 0;
+      stackColumn[0] = kStart;
+      next[kStart] = start[kStart];
+      bool found = false;
+      while (depth >= 0 && !found) {
+        int k = stackColumn[depth];
+        if (next[k] < start[k + 1]) {
+          int iRow = row[next[k]++];
+          if (visited[iRow] == kStart)
+            continue;
+          visited[iRow] = kStart;
+          if (rowMatch[iRow] < 0) {
+            // augment along path
+            stackRow[depth] = iRow;
+            for (int d = depth; d >= 0; d--) {
+              rowMatch[stackRow[d]] = stackColumn[d];
+              columnMatch[stackColumn[d]] = stackRow[d];
+            }
+            found = true;
+          } else {
+            stackRow[depth] = iRow;
+            int kNext = rowMatch[iRow];
+            depth++;
+            stackColumn[depth] = kNext;
+            next[kNext] = start[kNext];
+          }
+        } else {
+          depth--;
+        }
+      }
+      if (!found) {
+        singular = true;
+        break;
+      }
+    }
+  } else {
+    /* Spanning forest on rows which are not side rows (numberRows is
+       ground).  A column with one element in those rows joins row to
+       ground, with two joins the rows and otherwise goes in border.
+       Slacks come first so are in forest if possible. */
+    int *ground = new int[numberRows + 1];
+    int *end0 = new int[numberRows];
+    int *end1 = new int[numberRows];
+    for (int i = 0; i <= numberRows; i++)
+      ground[i] = i;
+    int numberForest = 0;
+    for (int k = 0; k < numberRows; k++) {
+      int n = 0;
+      int ends[2] = { numberRows, numberRows };
+      for (CoinBigIndex j = start[k]; j < start[k + 1]; j++) {
+        int iRow = row[j];
+        if (!sideRow[iRow]) {
+          if (n < 2)
+            ends[n] = iRow;
+          n++;
+        }
+      }
+      end0[k] = -1;
+      if (n < 1 || n > 2)
+        continue;
+      // roots (with path halving)
+      int root0 = ends[0];
+      while (ground[root0] != root0) {
+        ground[root0] = ground[ground[root0]];
+        root0 = ground[root0];
+      }
+      int root1 = ends[1];
+      while (ground[root1] != root1) {
+        ground[root1] = ground[ground[root1]];
+        root1 = ground[root1];
+      }
+      if (root0 == root1)
+        continue; // would make cycle
+      ground[root0] = root1;
+      end0[k] = ends[0];
+      end1[k] = ends[1];
+      numberForest++;
+    }
+    if (numberForest != numberRows - numberSide) {
+      // not spanning
+      singular = true;
+    } else {
+      // tree columns by node (stackRow as count then start)
+      int *nodeStart = new int[numberRows + 2];
+      int *nodeColumn = new int[2 * numberForest];
+      CoinZeroN(nodeStart, numberRows + 2);
+      for (int k = 0; k < numberRows; k++) {
+        if (end0[k] >= 0) {
+          nodeStart[end0[k]]++;
+          nodeStart[end1[k]]++;
+        }
+      }
+      int n = 0;
+      for (int i = 0; i <= numberRows; i++) {
+        int count = nodeStart[i];
+        nodeStart[i] = n;
+        n += count;
+      }
+      nodeStart[numberRows + 1] = n;
+      for (int k = 0; k < numberRows; k++) {
+        if (end0[k] >= 0) {
+          nodeColumn[nodeStart[end0[k]]++] = k;
+          nodeColumn[nodeStart[end1[k]]++] = k;
+        }
+      }
+      for (int i = numberRows; i > 0; i--)
+        nodeStart[i] = nodeStart[i - 1];
+      nodeStart[0] = 0;
+      // breadth first from ground - column matched to node further away
+      int *queue = stackRow;
+      int numberQueue = 0;
+      int iNode = numberRows;
+      int iPut = 0;
+      while (true) {
+        for (int j = nodeStart[iNode]; j < nodeStart[iNode + 1]; j++) {
+          int k = nodeColumn[j];
+          if (columnMatch[k] < 0) {
+            int iOther = (end0[k] == iNode) ? end1[k] : end0[k];
+            columnMatch[k] = iOther;
+            rowMatch[iOther] = k;
+            queue[numberQueue++] = iOther;
+          }
+        }
+        if (iPut == numberQueue)
+          break;
+        iNode = queue[iPut++];
+      }
+      delete[] nodeStart;
+      delete[] nodeColumn;
+      assert(numberQueue == numberForest);
+      // border columns to side rows
+      int k = 0;
+      for (int iRow = 0; iRow < numberRows; iRow++) {
+        if (sideRow[iRow]) {
+          while (end0[k] >= 0)
+            k++;
+          rowMatch[iRow] = k;
+          columnMatch[k++] = iRow;
+        }
+      }
+    }
+    delete[] ground;
+    delete[] end0;
+    delete[] end1;
+  }
+  delete[] visited;
+  delete[] stackRow;
+  if (singular) {
+    delete[] rowMatch;
+    delete[] columnMatch;
+    delete[] stackColumn;
+    delete[] next;
+    delete[] start;
+    delete[] row;
+    delete[] element;
+    return -1;
+  }
+  // strongly connected components (Tarjan - without recursion)
+  int *index = new int[numberRows];
+  int *low = new int[numberRows];
+  int *stack = new int[numberRows];
+  int *emitted = new int[numberRows];
+  int *emittedStart = new int[numberRows + 1];
+  char *onStack = new char[numberRows];
+  for (int i = 0; i < numberRows; i++) {
+    index[i] = -1;
+    onStack[i] = 0;
+  }
+  int numberIndexed = 0;
+  int numberStack = 0;
+  int numberEmitted = 0;
+  int numberBlocks = 0;
+  int largestBlock = 0;
+  emittedStart[0] = 0;
+  for (int iStart = 0; iStart < numberRows && largestBlock <= maximumBlockSize; iStart++) {
+    if (index[iStart] >= 0 || (sideRow && sideRow[iStart]))
+      continue;
+    int depth = 0;
+    stackColumn[0] = iStart;
+    index[iStart] = numberIndexed;
+    low[iStart] = numberIndexed++;
+    stack[numberStack++] = iStart;
+    onStack[iStart] = 1;
+    next[iStart] = start[rowMatch[iStart]];
+    while (depth >= 0) {
+      int iPivot = stackColumn[depth];
+      int k = rowMatch[iPivot];
+      if (next[iPivot] < start[k + 1]) {
+        int iRow = row[next[iPivot]++];
+        if (iRow == iPivot || (sideRow && sideRow[iRow]))
+          continue;
+        if (index[iRow] < 0) {
+          index[iRow] = numberIndexed;
+          low[iRow] = numberIndexed++;
+          stack[numberStack++] = iRow;
+          onStack[iRow] = 1;
+          stackColumn[++depth] = iRow;
+          next[iRow] = start[rowMatch[iRow]];
+        } else if (onStack[iRow]) {
+          low[iPivot] = CoinMin(low[iPivot], index[iRow]);
+        }
+      } else {
+        if (low[iPivot] == index[iPivot]) {
+          // root of component
+          int iRow;
+          do {
+            iRow = stack[--numberStack];
+            onStack[iRow] = 0;
+            emitted[numberEmitted++] = iRow;
+          } while (iRow != iPivot);
+          emittedStart[++numberBlocks] = numberEmitted;
+          largestBlock = CoinMax(largestBlock,
+            numberEmitted - emittedStart[numberBlocks - 1]);
+        }
+        depth--;
+        if (depth >= 0) {
+          int iParent = stackColumn[depth];
+          low[iParent] = CoinMin(low[iParent], low[iPivot]);
+        }
+      }
+    }
+  }
+  delete[] index;
+  delete[] low;
+  delete[] stack;
+  delete[] onStack;
+  delete[] stackColumn;
+  delete[] next;
+  if (largestBlock > maximumBlockSize) {
+    delete[] emitted;
+    delete[] emittedStart;
+    delete[] rowMatch;
+    delete[] columnMatch;
+    delete[] start;
+    delete[] row;
+    delete[] element;
+    return 1;
+  }
+  /* A component is emitted after all those its pivot rows reach, so
+     those must be solved before it - do in reverse order */
+  numberRows_ = numberRows;
+  numberBlocks_ = numberBlocks;
+  largestBlock_ = largestBlock;
+  numberBorder_ = numberSide;
+  order_ = new int[numberRows];
+  blockStart_ = new int[numberBlocks + 1];
+  int *whichBlock = new int[numberRows];
+  int *position = new int[numberRows];
+  int n = 0;
+  for (int iBlock = 0; iBlock < numberBlocks; iBlock++) {
+    blockStart_[iBlock] = n;
+    int jBlock = numberBlocks - 1 - iBlock;
+    for (int j = emittedStart[jBlock]; j < emittedStart[jBlock + 1]; j++) {
+      int iRow = emitted[j];
+      whichBlock[iRow] = iBlock;
+      position[iRow] = n - blockStart_[iBlock];
+      order_[n++] = iRow;
+    }
+  }
+  blockStart_[numberBlocks] = n;
+  // side rows after blocks
+  if (numberSide) {
+    for (int iRow = 0; iRow < numberRows; iRow++) {
+      if (sideRow[iRow]) {
+        whichBlock[iRow] = -1;
+        order_[n++] = iRow;
+      }
+    }
+  }
+  assert(n == numberRows);
+  delete[] emitted;
+  delete[] emittedStart;
+  // split elements into blocks and outside
+  denseStart_ = new CoinBigIndex[numberBlocks + 1];
+  CoinBigIndex numberDense = 0;
+  for (int iBlock = 0; iBlock < numberBlocks; iBlock++) {
+    denseStart_[iBlock] = numberDense;
+    int size = blockStart_[iBlock + 1] - blockStart_[iBlock];
+    numberDense += size * size;
+  }
+  denseStart_[numberBlocks] = numberDense;
+  dense_ = new double[numberDense];
+  CoinZeroN(dense_, numberDense);
+  densePivot_ = new int[numberRows];
+  offStart_ = new CoinBigIndex[numberRows + 1];
+  offRow_ = new int[numberElements];
+  offElement_ = new double[numberElements];
+  CoinBigIndex numberOff = 0;
+  int *pivotVariable = model->pivotVariable();
+  for (int iPivot = 0; iPivot < numberRows; iPivot++) {
+    offStart_[iPivot] = numberOff;
+    int k = rowMatch[iPivot];
+    if (k < numberRowBasic)
+      pivotVariable[iPivot] = pivotTemp[k] + numberColumns;
+    else
+      pivotVariable[iPivot] = pivotTemp[k];
+    int iBlock = whichBlock[iPivot];
+    if (iBlock < 0) {
+      // border - all outside blocks
+      for (CoinBigIndex j = start[k]; j < start[k + 1]; j++) {
+        offRow_[numberOff] = row[j];
+        offElement_[numberOff++] = element[j];
+      }
+      continue;
+    }
+    int size = blockStart_[iBlock + 1] - blockStart_[iBlock];
+    double *denseColumn = dense_ + denseStart_[iBlock] + position[iPivot] * size;
+    for (CoinBigIndex j = start[k]; j < start[k + 1]; j++) {
+      int iRow = row[j];
+      if (whichBlock[iRow] == iBlock) {
+        denseColumn[position[iRow]] = element[j];
+      } else {
+        offRow_[numberOff] = iRow;
+        offElement_[numberOff++] = element[j];
+      }
+    }
+  }
+  offStart_[numberRows] = numberOff;
+  delete[] whichBlock;
+  delete[] position;
+  delete[] rowMatch;
+  delete[] columnMatch;
+  delete[] start;
+  delete[] row;
+  delete[] element;
+  // factorize blocks bigger than one (in parallel if possible)
+  int *status = new int[numberBlocks];
+  int *bigBlock = new int[numberBlocks];
+  int numberBig = 0;
+  for (int iBlock = 0; iBlock < numberBlocks; iBlock++) {
+    int size = blockStart_[iBlock + 1] - blockStart_[iBlock];
+    status[iBlock] = 0;
+    if (size > 1) {
+      bigBlock[numberBig++] = iBlock;
+    } else {
+      densePivot_[blockStart_[iBlock]] = 0;
+      if (fabs(dense_[denseStart_[iBlock]]) < 1.0e-10)
+        status[iBlock] = 1;
+    }
+  }
+  void *info[3];
+  info[0] = this;
+  info[1] = bigBlock;
+  info[2] = status;
+  ClpTaskPool *pool = ClpTaskPool::sharedIfExists();
+  if (pool && pool->numberThreads() && largestBlock_ > 16)
+    pool->parallelFor(0, numberBig, 1, factorBlocks, info);
+  else
+    factorBlocks(info, 0, numberBig, 0);
+  delete[] bigBlock;
+  singular = false;
+  for (int iBlock = 0; iBlock < numberBlocks; iBlock++) {
+    if (status[iBlock])
+      singular = true;
+  }
+  delete[] status;
+  if (singular) {
+    gutsOfDelete();
+    return -1;
+  }
+  if (numberBorder_) {
+    /* Schur complement - column for border column is what is left in
+       side rows after solving with blocks.  Each thread has own work */
+    schur_ = new double[numberBorder_ * numberBorder_];
+    schurPivot_ = new int[numberBorder_];
+    int numberWork = 1;
+    if (pool && pool->numberThreads() && numberBorder_ > 8)
+      numberWork += pool->numberThreads();
+    int length = numberRows_ + largestBlock_;
+    double *work = new double[numberWork * length];
+    CoinZeroN(work, numberWork * length);
+    info[1] = work;
+    if (numberWork > 1)
+      pool->parallelFor(0, numberBorder_, 4, schurColumns, info);
+    else
+      schurColumns(info, 0, numberBorder_, 0);
+    delete[] work;
+    if (denseFactor(schur_, schurPivot_, numberBorder_)) {
+      gutsOfDelete();
+      return -1;
+    }
+    borderWork_ = new double[numberRows_ + numberBorder_];
+    CoinZeroN(borderWork_, numberRows_ + numberBorder_);
+  }
+  blockWork_ = new double[largestBlock_];
+  // room for updates
+  maximumEtas_ = 100;
+  etaCapacity_ = 4 * numberRows + 1000;
+  etaRow_ = new int[maximumEtas_];
+  etaPivot_ = new double[maximumEtas_];
+  etaStart_ = new CoinBigIndex[maximumEtas_ + 1];
+  etaStart_[0] = 0;
+  etaIndex_ = new int[etaCapacity_];
+  etaElement_ = new double[etaCapacity_];
+  return 0;
+}
+// Does dense LU of blocks (for ClpTaskPool)
+void ClpBlockBasis::factorBlocks(void *info, int first, int last, int)
+{
+  void **stuff = reinterpret_cast< void ** >(info);
+  ClpBlockBasis *basis = reinterpret_cast< ClpBlockBasis * >(stuff[0]);
+  const int *bigBlock = reinterpret_cast< const int * >(stuff[1]);
+  int *status = reinterpret_cast< int * >(stuff[2]);
+  for (int i = first; i < last; i++) {
+    int iBlock = bigBlock[i];
+    status[iBlock] = basis->factorBlock(iBlock);
+  }
+}
+// Computes columns of Schur complement (for ClpTaskPool)
+void ClpBlockBasis::schurColumns(void *info, int first, int last, int iThread)
+{
+  void **stuff = reinterpret_cast< void ** >(info);
+  ClpBlockBasis *basis = reinterpret_cast< ClpBlockBasis * >(stuff[0]);
+  int numberRows = basis->numberRows_;
+  int numberBorder = basis->numberBorder_;
+  double *COIN_RESTRICT work = reinterpret_cast< double * >(stuff[1])
+    + iThread * (numberRows + basis->largestBlock_);
+  const int *COIN_RESTRICT borderRow = basis->order_ + numberRows - numberBorder;
+  const CoinBigIndex *COIN_RESTRICT offStart = basis->offStart_;
+  for (int k = first; k < last; k++) {
+    int iPivot = borderRow[k];
+    for (CoinBigIndex j = offStart[iPivot]; j < offStart[iPivot + 1]; j++)
+      work[basis->offRow_[j]] = basis->offElement_[j];
+    basis->solveBlocks(work, work + numberRows);
+    double *COIN_RESTRICT column = basis->schur_ + k * numberBorder;
+    for (int i = 0; i < numberBorder; i++)
+      column[i] = work[borderRow[i]];
+    CoinZeroN(work, numberRows);
+  }
+}
+// Dense LU of one block with partial pivoting
+int ClpBlockBasis::factorBlock(int iBlock)
+{
+  int size = blockStart_[iBlock + 1] - blockStart_[iBlock];
+  return denseFactor(dense_ + denseStart_[iBlock],
+    densePivot_ + blockStart_[iBlock], size);
+}
+// Dense LU with partial pivoting - returns nonzero if singular
+int ClpBlockBasis::denseFactor(double *a, int *pivot, int size)
+{
+  for (int j = 0; j < size; j++) {
+    double *COIN_RESTRICT aj = a + j * size;
+    int iPivot = j;
+    double largest = fabs(aj[j]);
+    for (int i = j + 1; i < size; i++) {
+      if (fabs(aj[i]) > largest) {
+        largest = fabs(aj[i]);
+        iPivot = i;
+      }
+    }
+    if (largest < 1.0e-10)
+      return 1;
+    pivot[j] = iPivot;
+    if (iPivot != j) {
+      for (int k = 0; k < size; k++) {
+        double *COIN_RESTRICT ak = a + k * size;
+        double temp = ak[j];
+        ak[j] = ak[iPivot];
+        ak[iPivot] = temp;
+      }
+    }
+    double multiplier = 1.0 / aj[j];
+    for (int i = j + 1; i < size; i++)
+      aj[i] *= multiplier;
+    for (int k = j + 1; k < size; k++) {
+      double *COIN_RESTRICT ak = a + k * size;
+      double value = ak[j];
+      if (value) {
+        for (int i = j + 1; i < size; i++)
+          ak[i] -= value * aj[i];
+      }
+    }
+  }
+  return 0;
+}
+// Solves with dense LU (in place)
+void ClpBlockBasis::denseSolve(const double *a, const int *pivot, int size,
+  double *work)
+{
+  // interchanges (L has whole rows swapped so do all first)
+  for (int j = 0; j < size; j++) {
+    int iPivot = pivot[j];
+    double value = work[iPivot];
+    work[iPivot] = work[j];
+    work[j] = value;
+  }
+  // L
+  for (int j = 0; j < size; j++) {
+    double value = work[j];
+    if (value) {
+      const double *COIN_RESTRICT aj = a + j * size;
+      for (int i = j + 1; i < size; i++)
+        work[i] -= aj[i] * value;
+    }
+  }
+  // U
+  for (int j = size - 1; j >= 0; j--) {
+    const double *COIN_RESTRICT aj = a + j * size;
+    double value = work[j];
+    if (value) {
+      value /= aj[j];
+      work[j] = value;
+      for (int i = 0; i < j; i++)
+        work[i] -= aj[i] * value;
+    }
+  }
+}
+// Solves with transpose of dense LU (in place)
+void ClpBlockBasis::denseSolveTranspose(const double *a, const int *pivot,
+  int size, double *work)
+{
+  // U transpose
+  for (int j = 0; j < size; j++) {
+    const double *COIN_RESTRICT aj = a + j * size;
+    double value = work[j];
+    for (int i = 0; i < j; i++)
+      value -= aj[i] * work[i];
+    work[j] = value / aj[j];
+  }
+  // L transpose
+  for (int j = size - 1; j >= 0; j--) {
+    const double *COIN_RESTRICT aj = a + j * size;
+    double value = work[j];
+    for (int i = j + 1; i < size; i++)
+      value -= aj[i] * work[i];
+    work[j] = value;
+  }
+  // undo interchanges
+  for (int j = size - 1; j >= 0; j--) {
+    int iPivot = pivot[j];
+    double value = work[iPivot];
+    work[iPivot] = work[j];
+    work[j] = value;
+  }
+}
+// Forward solve with diagonal blocks
+void ClpBlockBasis::solveBlocks(double *region, double *work) const
+{
+  // blocks in order - anything outside block goes to later blocks
+  for (int iBlock = 0; iBlock < numberBlocks_; iBlock++) {
+    const int *COIN_RESTRICT rows = order_ + blockStart_[iBlock];
+    int size = blockStart_[iBlock + 1] - blockStart_[iBlock];
+    const double *COIN_RESTRICT a = dense_ + denseStart_[iBlock];
+    if (size == 1) {
+      int iPivot = rows[0];
+      double value = region[iPivot];
+      if (value) {
+        value /= a[0];
+        region[iPivot] = value;
+        for (CoinBigIndex j = offStart_[iPivot]; j < offStart_[iPivot + 1]; j++)
+          region[offRow_[j]] -= offElement_[j] * value;
+      }
+      continue;
+    }
+    bool nonZero = false;
+    for (int i = 0; i < size; i++) {
+      work[i] = region[rows[i]];
+      if (work[i])
+        nonZero = true;
+    }
+    if (!nonZero)
+      continue;
+    denseSolve(a, densePivot_ + blockStart_[iBlock], size, work);
+    for (int i = 0; i < size; i++) {
+      int iPivot = rows[i];
+      double value = work[i];
+      region[iPivot] = value;
+      if (value) {
+        for (CoinBigIndex j = offStart_[iPivot]; j < offStart_[iPivot + 1]; j++)
+          region[offRow_[j]] -= offElement_[j] * value;
+      }
+    }
+  }
+}
+// Backward solve with transpose of diagonal blocks
+void ClpBlockBasis::solveBlocksTranspose(double *region, double *work) const
+{
+  // blocks backwards - elements outside block are in later blocks
+  for (int iBlock = numberBlocks_ - 1; iBlock >= 0; iBlock--) {
+    const int *COIN_RESTRICT rows = order_ + blockStart_[iBlock];
+    int size = blockStart_[iBlock + 1] - blockStart_[iBlock];
+    const double *COIN_RESTRICT a = dense_ + denseStart_[iBlock];
+    bool nonZero = false;
+    for (int i = 0; i < size; i++) {
+      int iPivot = rows[i];
+      double value = region[iPivot];
+      for (CoinBigIndex j = offStart_[iPivot]; j < offStart_[iPivot + 1]; j++)
+        value -= offElement_[j] * region[offRow_[j]];
+      work[i] = value;
+      if (value)
+        nonZero = true;
+    }
+    if (!nonZero) {
+      // may have cancelled
+      for (int i = 0; i < size; i++)
+        region[rows[i]] = 0.0;
+      continue;
+    }
+    if (size == 1) {
+      region[rows[0]] = work[0] / a[0];
+      continue;
+    }
+    denseSolveTranspose(a, densePivot_ + blockStart_[iBlock], size, work);
+    for (int i = 0; i < size; i++)
+      region[rows[i]] = work[i];
+  }
+}
+/* Replaces one Column to basis,
+   returns 0=OK, 1=Probably OK, 2=singular!!
+*/
+int ClpBlockBasis::replaceColumn(const CoinIndexedVector *tableauColumn,
+  int pivotRow, double pivotCheck)
+{
+  const double *COIN_RESTRICT array = tableauColumn->denseVector();
+  const int *COIN_RESTRICT index = tableauColumn->getIndices();
+  int number = tableauColumn->getNumElements();
+  bool packed = tableauColumn->packedMode();
+  double pivotValue = 0.0;
+  for (int i = 0; i < number; i++) {
+    int iRow = index[i];
+    if (iRow == pivotRow)
+      pivotValue = packed ? array[i] : array[iRow];
+  }
+  if (fabs(pivotValue) < 1.0e-11)
+    return 2;
+  // make sure room
+  if (numberEtas_ == maximumEtas_) {
+    int newMaximum = 2 * maximumEtas_;
+    int *newRow = new int[newMaximum];
+    double *newPivot = new double[newMaximum];
+    CoinBigIndex *newStart = new CoinBigIndex[newMaximum + 1];
+    CoinMemcpyN(etaRow_, maximumEtas_, newRow);
+    CoinMemcpyN(etaPivot_, maximumEtas_, newPivot);
+    CoinMemcpyN(etaStart_, maximumEtas_ + 1, newStart);
+    delete[] etaRow_;
+    delete[] etaPivot_;
+    delete[] etaStart_;
+    etaRow_ = newRow;
+    etaPivot_ = newPivot;
+    etaStart_ = newStart;
+    maximumEtas_ = newMaximum;
+  }
+  CoinBigIndex put = etaStart_[numberEtas_];
+  if (put + number > etaCapacity_) {
+    CoinBigIndex newCapacity = 2 * etaCapacity_ + number;
+    int *newIndex = new int[newCapacity];
+    double *newElement = new double[newCapacity];
+    CoinMemcpyN(etaIndex_, put, newIndex);
+    CoinMemcpyN(etaElement_, put, newElement);
+    delete[] etaIndex_;
+    delete[] etaElement_;
+    etaIndex_ = newIndex;
+    etaElement_ = newElement;
+    etaCapacity_ = newCapacity;
+  }
+  for (int i = 0; i < number; i++) {
+    int iRow = index[i];
+    double value = packed ? array[i] : array[iRow];
+    if (iRow != pivotRow && fabs(value) > zeroTolerance_) {
+      etaIndex_[put] = iRow;
+      etaElement_[put++] = value;
+    }
+  }
+  etaRow_[numberEtas_] = pivotRow;
+  etaPivot_[numberEtas_] = pivotValue;
+  etaStart_[++numberEtas_] = put;
+  // same test as in ClpSimplex for accuracy
+  if (fabs(pivotValue - pivotCheck) > 1.0e-8 * (1.0 + fabs(pivotCheck)))
+    return 1;
+  return 0;
+}
+/* Updates one column (FTRAN) from regionSparse2 */
+int ClpBlockBasis::updateColumn(CoinIndexedVector *regionSparse,
+  CoinIndexedVector *regionSparse2) const
+{
+  double *COIN_RESTRICT region = regionSparse->denseVector();
+  double *COIN_RESTRICT region2 = regionSparse2->denseVector();
+  int *COIN_RESTRICT regionIndex2 = regionSparse2->getIndices();
+  int numberNonZero = regionSparse2->getNumElements();
+  bool packed = regionSparse2->packedMode();
+  // unpack into work region
+  for (int i = 0; i < numberNonZero; i++) {
+    int iRow = regionIndex2[i];
+    if (packed) {
+      region[iRow] = region2[i];
+      region2[i] = 0.0;
+    } else {
+      region[iRow] = region2[iRow];
+      region2[iRow] = 0.0;
+    }
+  }
+  solveBlocks(region, blockWork_);
+  if (numberBorder_) {
+    /* side rows now have what is left for Schur complement - solve
+       and take border columns out of block part (solving again) */
+    const int *COIN_RESTRICT borderRow = order_ + numberRows_ - numberBorder_;
+    double *COIN_RESTRICT work = borderWork_;
+    double *COIN_RESTRICT border = borderWork_ + numberRows_;
+    bool nonZero = false;
+    for (int k = 0; k < numberBorder_; k++) {
+      border[k] = region[borderRow[k]];
+      if (border[k])
+        nonZero = true;
+    }
+    if (nonZero) {
+      denseSolve(schur_, schurPivot_, numberBorder_, border);
+      for (int k = 0; k < numberBorder_; k++) {
+        int iPivot = borderRow[k];
+        double value = border[k];
+        region[iPivot] = value;
+        if (value) {
+          for (CoinBigIndex j = offStart_[iPivot]; j < offStart_[iPivot + 1]; j++)
+            work[offRow_[j]] += offElement_[j] * value;
+        }
+      }
+      for (int k = 0; k < numberBorder_; k++)
+        work[borderRow[k]] = 0.0;
+      solveBlocks(work, blockWork_);
+      for (int i = 0; i < numberRows_ - numberBorder_; i++) {
+        int iPivot = order_[i];
+        region[iPivot] -= work[iPivot];
+        work[iPivot] = 0.0;
+      }
+      for (int k = 0; k < numberBorder_; k++)
+        work[borderRow[k]] = 0.0;
+    }
+  }
+  // updates
+  for (int iEta = 0; iEta < numberEtas_; iEta++) {
+    int iPivot = etaRow_[iEta];
+    double value = region[iPivot];
+    if (value) {
+      value /= etaPivot_[iEta];
+      region[iPivot] = value;
+      for (CoinBigIndex j = etaStart_[iEta]; j < etaStart_[iEta + 1]; j++)
+        region[etaIndex_[j]] -= etaElement_[j] * value;
+    }
+  }
+  // pack back
+  numberNonZero = 0;
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    double value = region[iRow];
+    if (value) {
+      region[iRow] = 0.0;
+      if (fabs(value) > zeroTolerance_) {
+        if (packed)
+          region2[numberNonZero] = value;
+        else
+          region2[iRow] = value;
+        regionIndex2[numberNonZero++] = iRow;
+      }
+    }
+  }
+  regionSparse2->setNumElements(numberNonZero);
+  if (!numberNonZero)
+    regionSparse2->setPackedMode(false);
+  return numberNonZero;
+}
+/* Updates one column (BTRAN) from regionSparse2 */
+int ClpBlockBasis::updateColumnTranspose(CoinIndexedVector *regionSparse,
+  CoinIndexedVector *regionSparse2) const
+{
+  double *COIN_RESTRICT region = regionSparse->denseVector();
+  double *COIN_RESTRICT region2 = regionSparse2->denseVector();
+  int *COIN_RESTRICT regionIndex2 = regionSparse2->getIndices();
+  int numberNonZero = regionSparse2->getNumElements();
+  bool packed = regionSparse2->packedMode();
+  // unpack into work region
+  for (int i = 0; i < numberNonZero; i++) {
+    int iRow = regionIndex2[i];
+    if (packed) {
+      region[iRow] = region2[i];
+      region2[i] = 0.0;
+    } else {
+      region[iRow] = region2[iRow];
+      region2[iRow] = 0.0;
+    }
+  }
+  // updates backwards
+  for (int iEta = numberEtas_ - 1; iEta >= 0; iEta--) {
+    int iPivot = etaRow_[iEta];
+    double value = region[iPivot];
+    for (CoinBigIndex j = etaStart_[iEta]; j < etaStart_[iEta + 1]; j++)
+      value -= etaElement_[j] * region[etaIndex_[j]];
+    region[iPivot] = value / etaPivot_[iEta];
+  }
+  if (numberBorder_) {
+    /* solve block part with side rows zero to get right hand side
+       for Schur complement - then side rows are known */
+    const int *COIN_RESTRICT borderRow = order_ + numberRows_ - numberBorder_;
+    double *COIN_RESTRICT work = borderWork_;
+    double *COIN_RESTRICT border = borderWork_ + numberRows_;
+    int numberBlockRows = numberRows_ - numberBorder_;
+    for (int i = 0; i < numberBlockRows; i++) {
+      int iPivot = order_[i];
+      work[iPivot] = region[iPivot];
+    }
+    solveBlocksTranspose(work, blockWork_);
+    for (int k = 0; k < numberBorder_; k++) {
+      int iPivot = borderRow[k];
+      double value = region[iPivot];
+      for (CoinBigIndex j = offStart_[iPivot]; j < offStart_[iPivot + 1]; j++)
+        value -= offElement_[j] * work[offRow_[j]];
+      border[k] = value;
+    }
+    for (int i = 0; i < numberBlockRows; i++)
+      work[order_[i]] = 0.0;
+    denseSolveTranspose(schur_, schurPivot_, numberBorder_, border);
+    for (int k = 0; k < numberBorder_; k++)
+      region[borderRow[k]] = border[k];
+  }
+  solveBlocksTranspose(region, blockWork_);
+  // pack back
+  numberNonZero = 0;
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    double value = region[iRow];
+    if (value) {
+      region[iRow] = 0.0;
+      if (fabs(value) > zeroTolerance_) {
+        if (packed)
+          region2[numberNonZero] = value;
+        else
+          region2[iRow] = value;
+        regionIndex2[numberNonZero++] = iRow;
+      }
+    }
+  }
+  regionSparse2->setNumElements(numberNonZero);
+  if (!numberNonZero)
+    regionSparse2->setPackedMode(false);
+  return numberNonZero;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,218 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef ClpBlockBasis_H
+#define ClpBlockBasis_H
+
+class CoinIndexedVector;
+class ClpSimplex;
+#include "CoinTypes.h"
+#include "ClpConfig.h"
+
+/** This deals with Factorization and Updates for bases which are
+    (nearly) block triangular.
+
+    The basis is permuted to block triangular form (a maximum transversal
+    followed by strongly connected components of the graph of the
+    matrix - the Dulmage-Mendelsohn fine decomposition).  Each diagonal
+    block is factorized on its own by dense LU with partial pivoting and
+    the blocks are factorized in parallel if ClpTaskPool::shared has
+    threads.  Elements outside diagonal blocks are just kept as they are
+    so there is no fill outside the blocks.
+
+    Basic variables pivot on the row they are matched to so the
+    permutation is the identity as far as the rest of Clp is concerned.
+    Updates are product form (one eta per replaceColumn).
+
+    ClpFactorization only uses this if no diagonal block is bigger than
+    ClpFactorization::blockTriangular(), otherwise CoinFactorization
+    is used as normal.
+
+    It can also be given a set of side rows (e.g. the rows not in the
+    network found by ClpModel::findNetwork).  Then basic columns which
+    form a spanning forest on the other rows (so a triangular tree basis
+    if those rows are a network) are the block triangular part and the
+    rest are a border whose Schur complement (one dense matrix with a
+    row and column for each side row) is factorized by dense LU.
+    This is ClpFactorization::embeddedNetwork().
+ */
+
+class CLPLIB_EXPORT ClpBlockBasis {
+
+public:
+  /**@name Constructors and destructor and copy */
+  //@{
+  /// Default constructor
+  ClpBlockBasis();
+  /// Copy constructor
+  ClpBlockBasis(const ClpBlockBasis &other);
+
+  /// Destructor
+  ~ClpBlockBasis();
+  /// = copy
+  ClpBlockBasis &operator=(const ClpBlockBasis &other);
+  //@}
+
+  /**@name Do factorization */
+  //@{
+  /** Factorizes basis given as in ClpFactorization - pivotTemp has
+      numberRowBasic basic rows and then basic columns (numberRows in all).
+      If okay pivotVariable in model is set and returns 0.
+      Returns 1 if a diagonal block is bigger than maximumBlockSize
+      and -1 if singular (structurally or numerically).  In both cases
+      ordinary factorization should be used.
+      If sideRow is given then rows with nonzero sideRow are a border
+      as above and 1 is also returned if more than maximumBorder. */
+  int factorize(ClpSimplex *model, const int *pivotTemp,
+    int numberRowBasic, int maximumBlockSize, double zeroTolerance,
+    const char *sideRow = NULL, int maximumBorder = 0);
+  //@}
+
+  /**@name rank one updates which do exist */
+  //@{
+
+  /** Replaces one Column to basis given updated column,
+      returns 0=OK, 1=Probably OK, 2=singular!!
+     */
+  int replaceColumn(const CoinIndexedVector *tableauColumn,
+    int pivotRow, double pivotCheck);
+  //@}
+
+  /**@name various uses of factorization (return code number elements)
+      which user may want to know about */
+  //@{
+  /** Updates one column (FTRAN) from regionSparse2.
+      regionSparse is work region which starts and ends as zero.
+      If regionSparse2 packed on input - will be packed on output */
+  int updateColumn(CoinIndexedVector *regionSparse,
+    CoinIndexedVector *regionSparse2) const;
+  /** Updates one column (BTRAN) from regionSparse2.
+      regionSparse is work region which starts and ends as zero.
+      If regionSparse2 packed on input - will be packed on output */
+  int updateColumnTranspose(CoinIndexedVector *regionSparse,
+    CoinIndexedVector *regionSparse2) const;
+  //@}
+
+  /**@name Information */
+  //@{
+  /// Number of diagonal blocks
+  inline int numberBlocks() const
+  {
+    return numberBlocks_;
+  }
+  /// Size of largest diagonal block
+  inline int largestBlock() const
+  {
+    return largestBlock_;
+  }
+  /// Number of side rows (size of Schur complement)
+  inline int numberBorder() const
+  {
+    return numberBorder_;
+  }
+  /// Number of elements in blocks, outside blocks and Schur complement
+  inline CoinBigIndex numberElements() const
+  {
+    return (numberBlocks_ ? denseStart_[numberBlocks_] : 0)
+      + (numberRows_ ? offStart_[numberRows_] : 0)
+      + numberBorder_ * numberBorder_;
+  }
+  /// Number of updates since factorization
+  inline int numberEtas() const
+  {
+    return numberEtas_;
+  }
+  /// Number of elements in updates
+  inline CoinBigIndex numberEtaElements() const
+  {
+    return numberEtas_ ? etaStart_[numberEtas_] : 0;
+  }
+  //@}
+
+private:
+  /// Does dense LU of blocks (for ClpTaskPool)
+  static void factorBlocks(void *info, int first, int last, int iThread);
+  /// Dense LU of one block - returns nonzero if singular
+  int factorBlock(int iBlock);
+  /// Computes columns of Schur complement (for ClpTaskPool)
+  static void schurColumns(void *info, int first, int last, int iThread);
+  /** Dense LU with partial pivoting - returns nonzero if singular.
+      As LAPACK dgetrf whole rows (L part too) are interchanged so
+      P A = L U and solves apply all interchanges before L */
+  static int denseFactor(double *a, int *pivot, int size);
+  /// Solves with dense LU (in place)
+  static void denseSolve(const double *a, const int *pivot, int size,
+    double *work);
+  /// Solves with transpose of dense LU (in place)
+  static void denseSolveTranspose(const double *a, const int *pivot,
+    int size, double *work);
+  /** Forward solve with diagonal blocks - region by pivot row.
+      Elements outside blocks are subtracted from rows further on
+      (including side rows).  work is largestBlock_ long */
+  void solveBlocks(double *region, double *work) const;
+  /** Backward solve with transpose of diagonal blocks.
+      Side rows in region are taken as already solved */
+  void solveBlocksTranspose(double *region, double *work) const;
+  /// Frees everything
+  void gutsOfDelete();
+  /// Copies everything
+  void gutsOfCopy(const ClpBlockBasis &rhs);
+  /**@name data */
+  //@{
+  /// Number of Rows in factorization
+  int numberRows_;
+  /// Number of diagonal blocks
+  int numberBlocks_;
+  /// Size of largest diagonal block
+  int largestBlock_;
+  /// Number of updates
+  int numberEtas_;
+  /// Room for updates
+  int maximumEtas_;
+  /// Room for update elements
+  CoinBigIndex etaCapacity_;
+  /// Values smaller than this are dropped from results
+  double zeroTolerance_;
+  /// Number of side rows
+  int numberBorder_;
+  /// Rows in block order (FTRAN does blocks in this order) then side rows
+  int *order_;
+  /// Start of each block in order_ (numberBlocks_+1)
+  int *blockStart_;
+  /// Start of elements outside blocks for each pivot row (numberRows_+1)
+  CoinBigIndex *offStart_;
+  /// Row of elements outside blocks
+  int *offRow_;
+  /// Elements outside blocks
+  double *offElement_;
+  /// Start of dense LU for each block (numberBlocks_+1)
+  CoinBigIndex *denseStart_;
+  /// Dense LU of blocks (by column)
+  double *dense_;
+  /// Row interchanges of blocks (as order_)
+  int *densePivot_;
+  /// Pivot row of each update
+  int *etaRow_;
+  /// Pivot of each update
+  double *etaPivot_;
+  /// Start of each update (numberEtas_+1)
+  CoinBigIndex *etaStart_;
+  /// Rows in updates
+  int *etaIndex_;
+  /// Elements in updates
+  double *etaElement_;
+  /// Work array for one block
+  double *blockWork_;
+  /// Dense LU of Schur complement (by column)
+  double *schur_;
+  /// Row interchanges of Schur complement
+  int *schurPivot_;
+  /// Work array for border (numberRows_ + numberBorder_)
+  double *borderWork_;
+  //@}
+};
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
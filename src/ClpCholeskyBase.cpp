@@ -22,6 +22,7 @@
 #include "CoinPragma.hpp"
 
 #include <iostream>
+#include <cstdio>
 
 #include "ClpCholeskyBase.hpp"
 #include "ClpInterior.hpp"
@@ -31,6 +32,7 @@
 #include "ClpCholeskyDense.hpp"
 #include "ClpMessage.hpp"
 #include "ClpQuadraticObjective.hpp"
+#include "ClpTaskPool.hpp"
 
 //#############################################################################
 // Constructors / Destructor / Assignment
@@ -69,6 +71,14 @@ ClpCholeskyBase::ClpCholeskyBase(int denseThreshold)
   , denseColumn_(NULL)
   , dense_(NULL)
   , denseThreshold_(denseThreshold)
+  , patternHash_(0)
+  , reuseSymbolic_(true)
+  , symbolicReused_(false)
+  , numberColumns_(0)
+  , saveDiagonal_(NULL)
+  , rowDiagonal_(NULL)
+  , normalWork_(NULL)
+  , sizeNormalWork_(0)
 {
   memset(integerParameters_, 0, 64 * sizeof(int));
   memset(doubleParameters_, 0, 64 * sizeof(double));
@@ -110,11 +120,19 @@ ClpCholeskyBase::ClpCholeskyBase(const ClpCholeskyBase &rhs)
   clique_ = ClpCopyOfArray(rhs.clique_, numberRows_);
   CoinMemcpyN(rhs.integerParameters_, 64, integerParameters_);
   CoinMemcpyN(rhs.doubleParameters_, 64, doubleParameters_);
-  rowCopy_ = rhs.rowCopy_->clone();
+  rowCopy_ = rhs.rowCopy_ ? rhs.rowCopy_->clone() : NULL;
   whichDense_ = NULL;
   denseColumn_ = NULL;
   dense_ = NULL;
   denseThreshold_ = rhs.denseThreshold_;
+  patternHash_ = rhs.patternHash_;
+  reuseSymbolic_ = rhs.reuseSymbolic_;
+  symbolicReused_ = rhs.symbolicReused_;
+  numberColumns_ = rhs.numberColumns_;
+  sizeNormalWork_ = rhs.sizeNormalWork_;
+  saveDiagonal_ = ClpCopyOfArray(rhs.saveDiagonal_, numberRows_ + numberColumns_);
+  rowDiagonal_ = ClpCopyOfArray(rhs.rowDiagonal_, numberRows_);
+  normalWork_ = ClpCopyOfArray(rhs.normalWork_, sizeNormalWork_);
 }
 
 //-------------------------------------------------------------------
@@ -138,6 +156,9 @@ ClpCholeskyBase::~ClpCholeskyBase()
   delete[] whichDense_;
   delete[] denseColumn_;
   delete dense_;
+  delete[] saveDiagonal_;
+  delete[] rowDiagonal_;
+  delete[] normalWork_;
 }
 
 //----------------------------------------------------------------
@@ -193,14 +214,76 @@ ClpCholeskyBase::operator=(const ClpCholeskyBase &rhs)
     link_ = ClpCopyOfArray(rhs.link_, numberRows_);
     workInteger_ = ClpCopyOfArray(rhs.workInteger_, numberRows_);
     clique_ = ClpCopyOfArray(rhs.clique_, numberRows_);
-    rowCopy_ = rhs.rowCopy_->clone();
+    rowCopy_ = rhs.rowCopy_ ? rhs.rowCopy_->clone() : NULL;
     whichDense_ = NULL;
     denseColumn_ = NULL;
     dense_ = NULL;
     denseThreshold_ = rhs.denseThreshold_;
+    patternHash_ = rhs.patternHash_;
+    reuseSymbolic_ = rhs.reuseSymbolic_;
+    symbolicReused_ = rhs.symbolicReused_;
+    deleteNormalVectors();
+    numberColumns_ = rhs.numberColumns_;
+    sizeNormalWork_ = rhs.sizeNormalWork_;
+    saveDiagonal_ = ClpCopyOfArray(rhs.saveDiagonal_, numberRows_ + numberColumns_);
+    rowDiagonal_ = ClpCopyOfArray(rhs.rowDiagonal_, numberRows_);
+    normalWork_ = ClpCopyOfArray(rhs.normalWork_, sizeNormalWork_);
   }
   return *this;
 }
+// Gets vectors for normal equations times vector
+int ClpCholeskyBase::createNormalVectors(int numberRowWork)
+{
+  deleteNormalVectors();
+  sizeNormalWork_ = numberRowWork * numberRows_ + numberColumns_;
+  try {
+    saveDiagonal_ = new CoinWorkDouble[numberRows_ + numberColumns_];
+    rowDiagonal_ = new CoinWorkDouble[numberRows_];
+    normalWork_ = new CoinWorkDouble[sizeNormalWork_];
+  } catch (...) {
+    // no memory
+    deleteNormalVectors();
+    return -1;
+  }
+  return 0;
+}
+// Frees vectors for normal equations times vector
+void ClpCholeskyBase::deleteNormalVectors()
+{
+  delete[] saveDiagonal_;
+  delete[] rowDiagonal_;
+  delete[] normalWork_;
+  saveDiagonal_ = NULL;
+  rowDiagonal_ = NULL;
+  normalWork_ = NULL;
+  sizeNormalWork_ = 0;
+}
+// y = (A D A' + diagonal) * x for rows not dropped
+void ClpCholeskyBase::normalTimes(const CoinWorkDouble *x, CoinWorkDouble *y)
+{
+  CoinWorkDouble *columnWork = normalWork_ + sizeNormalWork_ - numberColumns_;
+  CoinZeroN(columnWork, numberColumns_);
+  model_->clpMatrix()->transposeTimes(1.0, x, columnWork);
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++)
+    columnWork[iColumn] *= saveDiagonal_[iColumn];
+  for (int iRow = 0; iRow < numberRows_; iRow++)
+    y[iRow] = rowDiagonal_[iRow] * x[iRow];
+  model_->clpMatrix()->times(1.0, columnWork, y);
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    if (rowsDropped_[iRow])
+      y[iRow] = 0.0;
+  }
+}
+// Message when iterative solve gives up
+void ClpCholeskyBase::switchMessage(const char *before, int numberSolves,
+  const char *after) const
+{
+  char line[200];
+  sprintf(line, "%s after %d solves - using %s", before, numberSolves, after);
+  model_->messageHandler()->message(CLP_GENERAL2, *model_->messagesPointer())
+    << line
+    << CoinMessageEol;
+}
 // reset numberRowsDropped and rowsDropped.
 void ClpCholeskyBase::resetRowsDropped()
 {
@@ -288,6 +371,91 @@ ClpCholeskyBase *ClpCholeskyBase::clone() const
 {
   return new ClpCholeskyBase(*this);
 }
+/* Decides which columns are dense.  They are taken out of A D A' and
+   put back by a low rank (Sherman-Morrison-Woodbury) correction using
+   a small dense Cholesky.  If automatic then only long columns which
+   would give a good part of the work in forming A D A' are taken and
+   no more than will fit in reasonable space. */
+int ClpCholeskyBase::chooseDense()
+{
+  delete[] whichDense_;
+  delete[] denseColumn_;
+  delete dense_;
+  whichDense_ = NULL;
+  denseColumn_ = NULL;
+  dense_ = NULL;
+  int numberColumns = model_->numberColumns();
+  const int *columnLength = model_->clpMatrix()->getVectorLengths();
+  int threshold = denseThreshold_;
+  int maximumDense = 100;
+  if (threshold == -2) {
+    // not too much space for dense columns
+    maximumDense = CoinMin(maximumDense,
+      CoinMax(1, 50000000 / CoinMax(numberRows_, 1)));
+    int *count = new int[numberRows_ + 1];
+    CoinZeroN(count, numberRows_ + 1);
+    double numberElements = 0.0;
+    double work = 0.0;
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+      int length = CoinMin(columnLength[iColumn], numberRows_);
+      count[length]++;
+      numberElements += length;
+      work += static_cast< double >(length) * length;
+    }
+    double average = numberElements / CoinMax(numberColumns, 1);
+    int minimumLength = CoinMax(static_cast< int >(10.0 * average), 50);
+    // go down from longest while not too many
+    threshold = 0;
+    int numberLong = 0;
+    double longWork = 0.0;
+    for (int length = numberRows_; length >= minimumLength; length--) {
+      if (numberLong + count[length] > maximumDense)
+        break;
+      if (count[length]) {
+        numberLong += count[length];
+        longWork += static_cast< double >(length) * length * count[length];
+        threshold = length;
+      }
+    }
+    delete[] count;
+    if (longWork < 0.1 * work)
+      threshold = 0; // not worth it
+    if (threshold)
+      COIN_DETAIL_PRINT(printf("%d columns of length >= %d are %g of work\n",
+        numberLong, threshold, longWork / work));
+  }
+  int numberDense = 0;
+  if (threshold > 0) {
+    whichDense_ = new char[numberColumns];
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+      if (columnLength[iColumn] < threshold) {
+        whichDense_[iColumn] = 0;
+      } else {
+        whichDense_[iColumn] = 1;
+        numberDense++;
+      }
+    }
+    if (!numberDense || numberDense > maximumDense) {
+      // free
+      delete[] whichDense_;
+      whichDense_ = NULL;
+      numberDense = 0;
+    } else {
+      // space for dense columns
+      denseColumn_ = new longDouble[numberDense * numberRows_];
+      // dense cholesky
+      dense_ = new ClpCholeskyDense();
+      dense_->reserveSpace(NULL, numberDense);
+      COIN_DETAIL_PRINT(printf("Taking %d columns as dense\n", numberDense));
+    }
+  }
+  return numberDense;
+}
+// Number of columns taken out as dense
+int ClpCholeskyBase::numberDense() const
+{
+  return dense_ ? dense_->numberRows() : 0;
+}
 // Forms ADAT - returns nonzero if not enough memory
 int ClpCholeskyBase::preOrder(bool lowerTriangular, bool includeDiagonal, bool doKKT)
 {
@@ -313,52 +481,8 @@ int ClpCholeskyBase::preOrder(bool lowerTriangular, bool includeDiagonal, bool d
     int iRow;
     sizeFactor_ = 0;
     int numberColumns = model_->numberColumns();
-    int numberDense = 0;
-    //denseThreshold_=3;
-    if (denseThreshold_ > 0) {
-      delete[] whichDense_;
-      delete[] denseColumn_;
-      delete dense_;
-      whichDense_ = new char[numberColumns];
-      int iColumn;
-      used[numberRows_] = 0;
-      for (iColumn = 0; iColumn < numberColumns; iColumn++) {
-        int length = columnLength[iColumn];
-        used[length] += 1;
-      }
-      int nLong = 0;
-      int stop = CoinMax(denseThreshold_ / 2, 100);
-      for (iRow = numberRows_; iRow >= stop; iRow--) {
-        if (used[iRow])
-          COIN_DETAIL_PRINT(printf("%d columns are of length %d\n", used[iRow], iRow));
-        nLong += used[iRow];
-        if (nLong > 50 || nLong > (numberColumns >> 2))
-          break;
-      }
-      CoinZeroN(used, numberRows_);
-      for (iColumn = 0; iColumn < numberColumns; iColumn++) {
-        if (columnLength[iColumn] < denseThreshold_) {
-          whichDense_[iColumn] = 0;
-        } else {
-          whichDense_[iColumn] = 1;
-          numberDense++;
-        }
-      }
-      if (!numberDense || numberDense > 100) {
-        // free
-        delete[] whichDense_;
-        whichDense_ = NULL;
-        denseColumn_ = NULL;
-        dense_ = NULL;
-      } else {
-        // space for dense columns
-        denseColumn_ = new longDouble[numberDense * numberRows_];
-        // dense cholesky
-        dense_ = new ClpCholeskyDense();
-        dense_->reserveSpace(NULL, numberDense);
-        COIN_DETAIL_PRINT(printf("Taking %d columns as dense\n", numberDense));
-      }
-    }
+    // take out dense columns
+    chooseDense();
     int offset = includeDiagonal ? 0 : 1;
     if (lowerTriangular)
       offset = -offset;
@@ -630,6 +754,19 @@ int ClpCholeskyBase::preOrder(bool lowerTriangular, bool includeDiagonal, bool d
 int ClpCholeskyBase::order(ClpInterior *model)
 {
   model_ = model;
+  symbolicReused_ = false;
+  if (reuseSymbolic_ && patternHash_ && choleskyRow_ && patternHash(model) == patternHash_) {
+    // same pattern - keep ordering and symbolic, just values of row copy
+    delete rowCopy_;
+    rowCopy_ = model_->clpMatrix()->reverseOrderedCopy();
+    if (!doKKT_)
+      chooseDense();
+    numberRowsDropped_ = 0;
+    memset(rowsDropped_, 0, numberRows_);
+    symbolicReused_ = true;
+    return 0;
+  }
+  deleteSymbolic();
 #define BASE_ORDER 2
 #if BASE_ORDER > 0
   if (model_->numberRows() > 6) {
@@ -677,51 +814,8 @@ int ClpCholeskyBase::order(ClpInterior *model)
   for (iRow = 0; iRow < numberRows_; iRow++)
     permute_[iRow] = iRow;
   if (!doKKT_) {
-    int numberDense = 0;
-    if (denseThreshold_ > 0) {
-      delete[] whichDense_;
-      delete[] denseColumn_;
-      delete dense_;
-      whichDense_ = new char[numberColumns];
-      int iColumn;
-      used[numberRows_] = 0;
-      for (iColumn = 0; iColumn < numberColumns; iColumn++) {
-        int length = columnLength[iColumn];
-        used[length] += 1;
-      }
-      int nLong = 0;
-      int stop = CoinMax(denseThreshold_ / 2, 100);
-      for (iRow = numberRows_; iRow >= stop; iRow--) {
-        if (used[iRow])
-          COIN_DETAIL_PRINT(printf("%d columns are of length %d\n", used[iRow], iRow));
-        nLong += used[iRow];
-        if (nLong > 50 || nLong > (numberColumns >> 2))
-          break;
-      }
-      CoinZeroN(used, numberRows_);
-      for (iColumn = 0; iColumn < numberColumns; iColumn++) {
-        if (columnLength[iColumn] < denseThreshold_) {
-          whichDense_[iColumn] = 0;
-        } else {
-          whichDense_[iColumn] = 1;
-          numberDense++;
-        }
-      }
-      if (!numberDense || numberDense > 100) {
-        // free
-        delete[] whichDense_;
-        whichDense_ = NULL;
-        denseColumn_ = NULL;
-        dense_ = NULL;
-      } else {
-        // space for dense columns
-        denseColumn_ = new longDouble[numberDense * numberRows_];
-        // dense cholesky
-        dense_ = new ClpCholeskyDense();
-        dense_->reserveSpace(NULL, numberDense);
-        COIN_DETAIL_PRINT(printf("Taking %d columns as dense\n", numberDense));
-      }
-    }
+    // take out dense columns
+    chooseDense();
     /*
              Get row counts and size
           */
@@ -1963,6 +2057,8 @@ int ClpCholeskyBase::orderAMD()
    returns non-zero if not enough memory */
 int ClpCholeskyBase::symbolic()
 {
+  if (symbolicReused_)
+    return 0; // still valid from last time
   const CoinBigIndex *columnStart = model_->clpMatrix()->getVectorStarts();
   const int *columnLength = model_->clpMatrix()->getVectorLengths();
   const int *row = model_->clpMatrix()->getIndices();
@@ -2469,6 +2565,7 @@ int ClpCholeskyBase::symbolic()
     clique_ = NULL;
     return -1;
   }
+  patternHash_ = patternHash(model_);
   return 0;
 }
 int ClpCholeskyBase::symbolic1(const int *Astart, const int *Arow)
@@ -2724,6 +2821,334 @@ int ClpCholeskyBase::symbolic2(const int *Astart, const int *Arow)
   }
   return 0;
 }
+// Adds value to hash a byte at a time (FNV-1a)
+static inline CoinUInt64 clpHashAdd(CoinUInt64 hash, CoinUInt64 value)
+{
+  for (int i = 0; i < 8; i++) {
+    hash ^= value & 255;
+    hash *= 1099511628211ULL;
+    value >>= 8;
+  }
+  return hash;
+}
+/* Hash of sparsity pattern of matrix (and quadratic objective) as seen
+   by this Cholesky.  Never zero */
+CoinUInt64 ClpCholeskyBase::patternHash(ClpInterior *model) const
+{
+  int numberRowsModel = model->numberRows();
+  int numberColumns = model->numberColumns();
+  const CoinBigIndex *columnStart = model->clpMatrix()->getVectorStarts();
+  const int *columnLength = model->clpMatrix()->getVectorLengths();
+  const int *row = model->clpMatrix()->getIndices();
+  CoinUInt64 hash = 14695981039346656037ULL;
+  hash = clpHashAdd(hash, numberRowsModel);
+  hash = clpHashAdd(hash, numberColumns);
+  hash = clpHashAdd(hash, doKKT_ ? 1 : 0);
+  hash = clpHashAdd(hash, static_cast< CoinUInt64 >(denseThreshold_));
+  hash = clpHashAdd(hash, static_cast< CoinUInt64 >(integerParameters_[0]));
+  hash = clpHashAdd(hash, static_cast< CoinUInt64 >(goDense_ * 1.0e8));
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    hash = clpHashAdd(hash, columnLength[iColumn]);
+    CoinBigIndex start = columnStart[iColumn];
+    CoinBigIndex end = start + columnLength[iColumn];
+    for (CoinBigIndex j = start; j < end; j++)
+      hash = clpHashAdd(hash, row[j]);
+  }
+  ClpQuadraticObjective *quadraticObj = (dynamic_cast< ClpQuadraticObjective * >(model->objectiveAsObject()));
+  if (quadraticObj) {
+    CoinPackedMatrix *quadratic = quadraticObj->quadraticObjective();
+    const CoinBigIndex *columnQuadraticStart = quadratic->getVectorStarts();
+    const int *columnQuadraticLength = quadratic->getVectorLengths();
+    const int *columnQuadratic = quadratic->getIndices();
+    int numberQuadratic = quadratic->getNumCols();
+    hash = clpHashAdd(hash, numberQuadratic);
+    for (int iColumn = 0; iColumn < numberQuadratic; iColumn++) {
+      hash = clpHashAdd(hash, columnQuadraticLength[iColumn]);
+      CoinBigIndex start = columnQuadraticStart[iColumn];
+      CoinBigIndex end = start + columnQuadraticLength[iColumn];
+      for (CoinBigIndex j = start; j < end; j++)
+        hash = clpHashAdd(hash, columnQuadratic[j]);
+    }
+  }
+  return hash ? hash : 1;
+}
+// Frees ordering and symbolic arrays (and saved pattern hash)
+void ClpCholeskyBase::deleteSymbolic()
+{
+  delete[] rowsDropped_;
+  rowsDropped_ = NULL;
+  delete[] permuteInverse_;
+  permuteInverse_ = NULL;
+  delete[] permute_;
+  permute_ = NULL;
+  delete[] sparseFactor_;
+  sparseFactor_ = NULL;
+  delete[] choleskyStart_;
+  choleskyStart_ = NULL;
+  delete[] choleskyRow_;
+  choleskyRow_ = NULL;
+  delete[] indexStart_;
+  indexStart_ = NULL;
+  delete[] diagonal_;
+  diagonal_ = NULL;
+  delete[] workDouble_;
+  workDouble_ = NULL;
+  delete[] link_;
+  link_ = NULL;
+  delete[] workInteger_;
+  workInteger_ = NULL;
+  delete[] clique_;
+  clique_ = NULL;
+  delete rowCopy_;
+  rowCopy_ = NULL;
+  patternHash_ = 0;
+  symbolicReused_ = false;
+}
+// Scalars at start of saved symbolic factorization
+typedef struct {
+  CoinUInt64 patternHash;
+  int version;
+  int sizeOfIndex; // sizeof(CoinBigIndex)
+  int numberRows;
+  int sizeFactor;
+  int sizeIndex;
+  int firstDense;
+} clpSymbolicScalars;
+#define CLP_SYMBOLIC_VERSION 1
+/* Writes ordering and symbolic factorization to file.
+   Returns non-zero if none or file could not be written */
+int ClpCholeskyBase::saveSymbolic(const char *fileName) const
+{
+  if (!patternHash_ || !choleskyRow_)
+    return 1;
+  FILE *fp = fopen(fileName, "wb");
+  if (!fp)
+    return 1;
+  clpSymbolicScalars scalars;
+  memset(&scalars, 0, sizeof(clpSymbolicScalars));
+  scalars.patternHash = patternHash_;
+  scalars.version = CLP_SYMBOLIC_VERSION;
+  scalars.sizeOfIndex = static_cast< int >(sizeof(CoinBigIndex));
+  scalars.numberRows = numberRows_;
+  scalars.sizeFactor = sizeFactor_;
+  scalars.sizeIndex = sizeIndex_;
+  scalars.firstDense = firstDense_;
+  size_t n = numberRows_;
+  bool good = fwrite(&scalars, sizeof(clpSymbolicScalars), 1, fp) == 1;
+  good = good && fwrite(permute_, sizeof(CoinBigIndex), n, fp) == n;
+  good = good && fwrite(permuteInverse_, sizeof(CoinBigIndex), n, fp) == n;
+  good = good && fwrite(choleskyStart_, sizeof(CoinBigIndex), n + 1, fp) == n + 1;
+  good = good && fwrite(indexStart_, sizeof(int), n, fp) == n;
+  good = good && fwrite(clique_, sizeof(int), n, fp) == n;
+  if (sizeIndex_)
+    good = good && fwrite(choleskyRow_, sizeof(CoinBigIndex), sizeIndex_, fp) == static_cast< size_t >(sizeIndex_);
+  if (fclose(fp))
+    good = false;
+  return good ? 0 : 1;
+}
+/* Reads ordering and symbolic factorization from file.
+   Returns non-zero if file could not be read */
+int ClpCholeskyBase::restoreSymbolic(const char *fileName)
+{
+  FILE *fp = fopen(fileName, "rb");
+  if (!fp)
+    return 1;
+  clpSymbolicScalars scalars;
+  if (fread(&scalars, sizeof(clpSymbolicScalars), 1, fp) != 1
+    || scalars.version != CLP_SYMBOLIC_VERSION
+    || scalars.sizeOfIndex != static_cast< int >(sizeof(CoinBigIndex))
+    || scalars.numberRows <= 0 || scalars.sizeIndex < 0
+    || scalars.sizeFactor < scalars.sizeIndex) {
+    fclose(fp);
+    return 1;
+  }
+  deleteSymbolic();
+  numberRows_ = scalars.numberRows;
+  sizeFactor_ = scalars.sizeFactor;
+  sizeIndex_ = scalars.sizeIndex;
+  firstDense_ = scalars.firstDense;
+  numberRowsDropped_ = 0;
+  size_t n = numberRows_;
+  bool good = true;
+  try {
+    permute_ = new CoinBigIndex[numberRows_];
+    permuteInverse_ = new CoinBigIndex[numberRows_];
+    choleskyStart_ = new CoinBigIndex[numberRows_ + 1];
+    indexStart_ = new int[numberRows_];
+    clique_ = new int[numberRows_];
+    choleskyRow_ = new CoinBigIndex[CoinMax(sizeIndex_, 1)];
+    rowsDropped_ = new char[numberRows_];
+    link_ = new int[numberRows_];
+    workInteger_ = new int[numberRows_];
+    sparseFactor_ = new longDouble[sizeFactor_];
+#if CLP_LONG_CHOLESKY != 1
+    workDouble_ = new longDouble[numberRows_];
+#else
+    // actually long double
+    workDouble_ = reinterpret_cast< double * >(new CoinWorkDouble[numberRows_]);
+#endif
+    diagonal_ = new longDouble[numberRows_];
+  } catch (...) {
+    // no memory
+    good = false;
+  }
+  good = good && fread(permute_, sizeof(CoinBigIndex), n, fp) == n;
+  good = good && fread(permuteInverse_, sizeof(CoinBigIndex), n, fp) == n;
+  good = good && fread(choleskyStart_, sizeof(CoinBigIndex), n + 1, fp) == n + 1;
+  good = good && fread(indexStart_, sizeof(int), n, fp) == n;
+  good = good && fread(clique_, sizeof(int), n, fp) == n;
+  if (sizeIndex_)
+    good = good && fread(choleskyRow_, sizeof(CoinBigIndex), sizeIndex_, fp) == static_cast< size_t >(sizeIndex_);
+  fclose(fp);
+  if (!good) {
+    deleteSymbolic();
+    return 1;
+  }
+  memset(rowsDropped_, 0, numberRows_);
+  patternHash_ = scalars.patternHash;
+  return 0;
+}
+// Minimum number of KKT rows per chunk if shared ClpTaskPool used
+#ifndef CLP_KKT_GRAIN
+#define CLP_KKT_GRAIN 2048
+#endif
+/* With a quadratic objective each permuted row of the KKT matrix only
+   writes its own part of sparseFactor_ and diagonal_ so rows can be
+   split over the shared ClpTaskPool.  Each thread has its own work
+   vector and largest. */
+typedef struct {
+  CoinWorkDouble largest;
+  double spare[7]; // keep slots on own cache line
+} clpKKTReduce;
+typedef struct {
+  const CoinBigIndex *columnStart;
+  const int *columnLength;
+  const int *row;
+  const double *element;
+  const CoinBigIndex *rowStart;
+  const int *rowLength;
+  const int *column;
+  const double *elementByRow;
+  const int *columnQuadratic;
+  const CoinBigIndex *columnQuadraticStart;
+  const int *columnQuadraticLength;
+  const double *quadraticElement;
+  const CoinWorkDouble *diagonal;
+  const CoinBigIndex *permute;
+  const CoinBigIndex *permuteInverse;
+  const CoinBigIndex *choleskyStart;
+  const CoinBigIndex *choleskyRow;
+  const int *indexStart;
+  longDouble *sparseFactor;
+  longDouble *diagonalOut;
+  // work vector (one per thread if threaded)
+  longDouble *work;
+  CoinWorkDouble delta2;
+  int numberRows;
+  int numberColumns;
+  int numberRowsModel;
+  int numberTotal;
+  clpKKTReduce reduce[CLP_MAX_POOL_THREADS + 1];
+} clpKKTInfo;
+static void clpKKTQuadraticRange(void *stuff, int first, int last, int iThread)
+{
+  clpKKTInfo *info = reinterpret_cast< clpKKTInfo * >(stuff);
+  const CoinBigIndex *columnStart = info->columnStart;
+  const int *columnLength = info->columnLength;
+  const int *row = info->row;
+  const double *element = info->element;
+  const CoinBigIndex *rowStart = info->rowStart;
+  const int *rowLength = info->rowLength;
+  const int *column = info->column;
+  const double *elementByRow = info->elementByRow;
+  const int *columnQuadratic = info->columnQuadratic;
+  const CoinBigIndex *columnQuadraticStart = info->columnQuadraticStart;
+  const int *columnQuadraticLength = info->columnQuadraticLength;
+  const double *quadraticElement = info->quadraticElement;
+  const CoinWorkDouble *diagonal = info->diagonal;
+  const CoinBigIndex *permute = info->permute;
+  const CoinBigIndex *permuteInverse = info->permuteInverse;
+  longDouble *diagonalOut = info->diagonalOut;
+  longDouble *work = info->work + iThread * info->numberRows;
+  CoinWorkDouble delta2 = info->delta2;
+  int numberColumns = info->numberColumns;
+  int numberRowsModel = info->numberRowsModel;
+  int numberTotal = info->numberTotal;
+  CoinWorkDouble largest = 0.0;
+  for (int iRow = first; iRow < last; iRow++) {
+    longDouble *put = info->sparseFactor + info->choleskyStart[iRow];
+    const CoinBigIndex *which = info->choleskyRow + info->indexStart[iRow];
+    int iOriginalRow = permute[iRow];
+    if (iOriginalRow < numberColumns) {
+      CoinBigIndex j;
+      int iColumn = iOriginalRow;
+      CoinWorkDouble value = diagonal[iColumn];
+      if (CoinAbs(value) > 1.0e-100) {
+        value = 1.0 / value;
+        for (j = columnQuadraticStart[iColumn];
+             j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
+          int jColumn = columnQuadratic[j];
+          int jNewColumn = permuteInverse[jColumn];
+          if (jNewColumn > iRow) {
+            work[jNewColumn] = -quadraticElement[j];
+          } else if (iColumn == jColumn) {
+            value += quadraticElement[j];
+          }
+        }
+        largest = CoinMax(largest, CoinAbs(value));
+        diagonalOut[iRow] = -value;
+        CoinBigIndex start = columnStart[iColumn];
+        CoinBigIndex end = columnStart[iColumn] + columnLength[iColumn];
+        for (j = start; j < end; j++) {
+          int kRow = row[j] + numberTotal;
+          kRow = permuteInverse[kRow];
+          if (kRow > iRow) {
+            work[kRow] = element[j];
+            largest = CoinMax(largest, CoinAbs(element[j]));
+          }
+        }
+      } else {
+        diagonalOut[iRow] = -value;
+      }
+    } else if (iOriginalRow < numberTotal) {
+      CoinWorkDouble value = diagonal[iOriginalRow];
+      if (CoinAbs(value) > 1.0e-100) {
+        value = 1.0 / value;
+        largest = CoinMax(largest, CoinAbs(value));
+      } else {
+        value = 1.0e100;
+      }
+      diagonalOut[iRow] = -value;
+      int kRow = permuteInverse[iOriginalRow + numberRowsModel];
+      if (kRow > iRow)
+        work[kRow] = -1.0;
+    } else {
+      diagonalOut[iRow] = delta2;
+      int kRow = iOriginalRow - numberTotal;
+      CoinBigIndex start = rowStart[kRow];
+      CoinBigIndex end = rowStart[kRow] + rowLength[kRow];
+      for (CoinBigIndex j = start; j < end; j++) {
+        int jRow = column[j];
+        int jNewRow = permuteInverse[jRow];
+        if (jNewRow > iRow) {
+          work[jNewRow] = elementByRow[j];
+          largest = CoinMax(largest, CoinAbs(elementByRow[j]));
+        }
+      }
+      // slack - should it be permute
+      kRow = permuteInverse[kRow + numberColumns];
+      if (kRow > iRow)
+        work[kRow] = -1.0;
+    }
+    int number = static_cast< int >(info->choleskyStart[iRow + 1] - info->choleskyStart[iRow]);
+    for (int j = 0; j < number; j++) {
+      int jRow = which[j];
+      put[j] = work[jRow];
+      work[jRow] = 0.0;
+    }
+  }
+  info->reduce[iThread].largest = CoinMax(info->reduce[iThread].largest, largest);
+}
 /* Factorize - filling in rowsDropped and returning number dropped */
 int ClpCholeskyBase::factorize(const CoinWorkDouble *diagonal, int *rowsDropped)
 {
@@ -2871,8 +3296,8 @@ int ClpCholeskyBase::factorize(const CoinWorkDouble *diagonal, int *rowsDropped)
       }
       // Update dense columns (just L)
       // Zero out dropped rows
-      for (i = 0; i < numberDense; i++) {
-        longDouble *a = denseColumn_ + i * numberRows_;
+      for (int iDense = 0; iDense < numberDense; iDense++) {
+        longDouble *a = denseColumn_ + iDense * numberRows_;
         for (int j = 0; j < numberRows_; j++) {
           if (rowsDropped[j])
             a[j] = 0.0;
@@ -2883,6 +3308,8 @@ int ClpCholeskyBase::factorize(const CoinWorkDouble *diagonal, int *rowsDropped)
         }
         for (i = 0; i < numberRows_; i++) {
           CoinWorkDouble value = workDouble_[i];
+          if (!value)
+            continue;
           CoinBigIndex offset = indexStart_[i] - choleskyStart_[i];
           CoinBigIndex j;
           for (j = choleskyStart_[i]; j < choleskyStart_[i + 1]; j++) {
@@ -3065,86 +3492,49 @@ int ClpCholeskyBase::factorize(const CoinWorkDouble *diagonal, int *rowsDropped)
           }
         }
       } else {
-        // quadratic
-        const int *columnQuadratic = quadratic->getIndices();
-        const CoinBigIndex *columnQuadraticStart = quadratic->getVectorStarts();
-        const int *columnQuadraticLength = quadratic->getVectorLengths();
-        const double *quadraticElement = quadratic->getElements();
-        for (iRow = 0; iRow < numberRows_; iRow++) {
-          longDouble *put = sparseFactor_ + choleskyStart_[iRow];
-          CoinBigIndex *which = choleskyRow_ + indexStart_[iRow];
-          int iOriginalRow = permute_[iRow];
-          if (iOriginalRow < numberColumns) {
-            CoinBigIndex j;
-            iColumn = iOriginalRow;
-            CoinWorkDouble value = diagonal[iColumn];
-            if (CoinAbs(value) > 1.0e-100) {
-              value = 1.0 / value;
-              for (j = columnQuadraticStart[iColumn];
-                   j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
-                int jColumn = columnQuadratic[j];
-                int jNewColumn = permuteInverse_[jColumn];
-                if (jNewColumn > iRow) {
-                  work[jNewColumn] = -quadraticElement[j];
-                } else if (iColumn == jColumn) {
-                  value += quadraticElement[j];
-                }
-              }
-              largest = CoinMax(largest, CoinAbs(value));
-              diagonal_[iRow] = -value;
-              CoinBigIndex start = columnStart[iColumn];
-              CoinBigIndex end = columnStart[iColumn] + columnLength[iColumn];
-              for (j = start; j < end; j++) {
-                int kRow = row[j] + numberTotal;
-                kRow = permuteInverse_[kRow];
-                if (kRow > iRow) {
-                  work[kRow] = element[j];
-                  largest = CoinMax(largest, CoinAbs(element[j]));
-                }
-              }
-            } else {
-              diagonal_[iRow] = -value;
-            }
-          } else if (iOriginalRow < numberTotal) {
-            CoinWorkDouble value = diagonal[iOriginalRow];
-            if (CoinAbs(value) > 1.0e-100) {
-              value = 1.0 / value;
-              largest = CoinMax(largest, CoinAbs(value));
-            } else {
-              value = 1.0e100;
-            }
-            diagonal_[iRow] = -value;
-            int kRow = permuteInverse_[iOriginalRow + numberRowsModel];
-            if (kRow > iRow)
-              work[kRow] = -1.0;
-          } else {
-            diagonal_[iRow] = delta2;
-            int kRow = iOriginalRow - numberTotal;
-            CoinBigIndex start = rowStart[kRow];
-            CoinBigIndex end = rowStart[kRow] + rowLength[kRow];
-            for (CoinBigIndex j = start; j < end; j++) {
-              int jRow = column[j];
-              int jNewRow = permuteInverse_[jRow];
-              if (jNewRow > iRow) {
-                work[jNewRow] = elementByRow[j];
-                largest = CoinMax(largest, CoinAbs(elementByRow[j]));
-              }
-            }
-            // slack - should it be permute
-            kRow = permuteInverse_[kRow + numberColumns];
-            if (kRow > iRow)
-              work[kRow] = -1.0;
-          }
-          CoinBigIndex j;
-          int number = choleskyStart_[iRow + 1] - choleskyStart_[iRow];
-          for (j = 0; j < number; j++) {
-            int jRow = which[j];
-            put[j] = work[jRow];
-            work[jRow] = 0.0;
-          }
-          for (j = 0; j < numberRows_; j++)
-            assert(!work[j]);
+        // quadratic - rows independent so may be split over shared pool
+        clpKKTInfo info;
+        info.columnStart = columnStart;
+        info.columnLength = columnLength;
+        info.row = row;
+        info.element = element;
+        info.rowStart = rowStart;
+        info.rowLength = rowLength;
+        info.column = column;
+        info.elementByRow = elementByRow;
+        info.columnQuadratic = quadratic->getIndices();
+        info.columnQuadraticStart = quadratic->getVectorStarts();
+        info.columnQuadraticLength = quadratic->getVectorLengths();
+        info.quadraticElement = quadratic->getElements();
+        info.diagonal = diagonal;
+        info.permute = permute_;
+        info.permuteInverse = permuteInverse_;
+        info.choleskyStart = choleskyStart_;
+        info.choleskyRow = choleskyRow_;
+        info.indexStart = indexStart_;
+        info.sparseFactor = sparseFactor_;
+        info.diagonalOut = diagonal_;
+        info.work = work;
+        info.delta2 = delta2;
+        info.numberRows = numberRows_;
+        info.numberColumns = numberColumns;
+        info.numberRowsModel = numberRowsModel;
+        info.numberTotal = numberTotal;
+        for (int i = 0; i <= CLP_MAX_POOL_THREADS; i++)
+          info.reduce[i].largest = 0.0;
+        ClpTaskPool *pool = ClpTaskPool::sharedIfExists();
+        if (pool && pool->numberThreads() && numberRows_ >= 2 * CLP_KKT_GRAIN) {
+          // work vector for each thread
+          int numberThreads = pool->numberThreads() + 1;
+          info.work = new longDouble[numberThreads * numberRows_];
+          CoinZeroN(info.work, numberThreads * numberRows_);
+          pool->parallelFor(0, numberRows_, CLP_KKT_GRAIN, clpKKTQuadraticRange, &info);
+          delete[] info.work;
+        } else {
+          clpKKTQuadraticRange(&info, 0, numberRows_, 0);
         }
+        for (int i = 0; i <= CLP_MAX_POOL_THREADS; i++)
+          largest = CoinMax(largest, info.reduce[i].largest);
       }
     } else {
       if (!quadratic) {
@@ -128,6 +128,8 @@ public:
   {
     return numberRows_;
   }
+  /// Number of columns taken out as dense (0 if none)
+  int numberDense() const;
   /// Return size
   inline int size() const
   {
@@ -180,11 +182,52 @@ public:
   }
   //@}
 
+  /**@name Saving symbolic factorization
+     After symbolic the ordering and symbolic structure are kept together
+     with a hash of the sparsity pattern.  If order is called again (same
+     ClpInterior solved again or Cholesky restored from file) and the
+     pattern has not changed then only the numeric factorization is done
+     on later solves.  Only for the default ordering and symbolic. */
+  //@{
+  /** Hash of sparsity pattern of matrix (and quadratic objective) as seen
+      by this Cholesky (KKT, dense columns and ordering speed included).
+      Never zero. */
+  CoinUInt64 patternHash(ClpInterior *model) const;
+  /// Hash of pattern of saved symbolic factorization (0 if none)
+  inline CoinUInt64 symbolicHash() const
+  {
+    return patternHash_;
+  }
+  /// Whether saved symbolic factorization may be used (default true)
+  inline bool reuseSymbolic() const
+  {
+    return reuseSymbolic_;
+  }
+  inline void setReuseSymbolic(bool yesNo)
+  {
+    reuseSymbolic_ = yesNo;
+  }
+  /// True if last order used saved symbolic factorization
+  inline bool symbolicReused() const
+  {
+    return symbolicReused_;
+  }
+  /** Writes ordering and symbolic factorization to file.
+      Returns non-zero if none or file could not be written */
+  int saveSymbolic(const char *fileName) const;
+  /** Reads ordering and symbolic factorization from file (written by
+      saveSymbolic).  It is used by next order if pattern hash matches.
+      Returns non-zero if file could not be read */
+  int restoreSymbolic(const char *fileName);
+  //@}
+
 public:
   /**@name Constructors, destructor
       */
   //@{
   /** Constructor which has dense columns activated.
+         Columns at least denseThreshold long are dense,
+         -2 means choose from column lengths.
          Default is off. */
   ClpCholeskyBase(int denseThreshold = -1);
   /** Destructor (has to be public) */
@@ -243,8 +286,27 @@ protected:
   void solve(CoinWorkDouble *region, int type);
   /// Forms ADAT - returns nonzero if not enough memory
   int preOrder(bool lowerTriangular, bool includeDiagonal, bool doKKT);
+  /** Decides which columns are dense (taken out of ADAT and put back
+      by a low rank correction).  Returns number dense */
+  int chooseDense();
   /// Updates dense part (broken out for profiling)
   void updateDense(longDouble *d, /*longDouble * work,*/ int *first);
+  /// Frees ordering and symbolic arrays (and saved pattern hash)
+  void deleteSymbolic();
+  //@}
+
+  /**@name Normal equations times vector (for iterative solves) */
+  //@{
+  /** Gets saveDiagonal_, rowDiagonal_ and normalWork_ (numberRowWork
+      vectors of rows then one of columns) for numberColumns_.
+      Returns -1 if not enough memory */
+  int createNormalVectors(int numberRowWork);
+  /// Frees saveDiagonal_, rowDiagonal_ and normalWork_
+  void deleteNormalVectors();
+  /// y = (A D A' + diagonal) * x using saved diagonal - zero for rows dropped
+  void normalTimes(const CoinWorkDouble *x, CoinWorkDouble *y);
+  /// Message when iterative solve gives up - "before after n solves - using after"
+  void switchMessage(const char *before, int numberSolves, const char *after) const;
   //@}
 
 protected:
@@ -311,8 +373,24 @@ protected:
   longDouble *denseColumn_;
   /// Dense cholesky
   ClpCholeskyDense *dense_;
-  /// Dense threshold (for taking out of Cholesky)
+  /// Dense threshold (for taking out of Cholesky) - -2 automatic
   int denseThreshold_;
+  /// Hash of pattern for which symbolic factorization was done (0 if none)
+  CoinUInt64 patternHash_;
+  /// Whether saved symbolic factorization may be used
+  bool reuseSymbolic_;
+  /// True if last order used saved symbolic factorization
+  bool symbolicReused_;
+  /// Number of columns in model (for normal equations times vector)
+  int numberColumns_;
+  /// Diagonal as given to factorize (columns then rows)
+  CoinWorkDouble *saveDiagonal_;
+  /// Extra on diagonal of each row (slack, delta squared and perturbation)
+  CoinWorkDouble *rowDiagonal_;
+  /// Work vectors for iterative solves (rows then one of columns at end)
+  CoinWorkDouble *normalWork_;
+  /// Size of normalWork_
+  int sizeNormalWork_;
   //@}
 };
 
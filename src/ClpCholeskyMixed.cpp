@@ -0,0 +1,368 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "ClpHelperFunctions.hpp"
+
+#include "ClpInterior.hpp"
+#include "ClpCholeskyMixed.hpp"
+
+//#############################################################################
+// Constructors / Destructor / Assignment
+//#############################################################################
+
+//-------------------------------------------------------------------
+// Default Constructor
+//-------------------------------------------------------------------
+ClpCholeskyMixed::ClpCholeskyMixed(int maximumRefinements, double tolerance)
+  : ClpCholeskyBase()
+  , maximumRefinements_(maximumRefinements)
+  , tolerance_(tolerance)
+  , useDouble_(false)
+  , numberSolves_(0)
+  , numberRefinements_(0)
+  , floatFactor_(NULL)
+  , floatDiagonal_(NULL)
+{
+  type_ = 19;
+  // no dense block at end
+  goDense_ = 2.0;
+}
+
+//-------------------------------------------------------------------
+// Copy constructor
+//-------------------------------------------------------------------
+ClpCholeskyMixed::ClpCholeskyMixed(const ClpCholeskyMixed &rhs)
+  : ClpCholeskyBase(rhs)
+{
+  gutsOfCopy(rhs);
+}
+
+//-------------------------------------------------------------------
+// Destructor
+//-------------------------------------------------------------------
+ClpCholeskyMixed::~ClpCholeskyMixed()
+{
+  gutsOfDelete();
+}
+
+//----------------------------------------------------------------
+// Assignment operator
+//-------------------------------------------------------------------
+ClpCholeskyMixed &
+ClpCholeskyMixed::operator=(const ClpCholeskyMixed &rhs)
+{
+  if (this != &rhs) {
+    ClpCholeskyBase::operator=(rhs);
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+//-------------------------------------------------------------------
+// Clone
+//-------------------------------------------------------------------
+ClpCholeskyBase *ClpCholeskyMixed::clone() const
+{
+  return new ClpCholeskyMixed(*this);
+}
+// Frees single precision factor
+void ClpCholeskyMixed::gutsOfDelete()
+{
+  delete[] floatFactor_;
+  delete[] floatDiagonal_;
+  floatFactor_ = NULL;
+  floatDiagonal_ = NULL;
+}
+// Copies single precision factor and counts
+void ClpCholeskyMixed::gutsOfCopy(const ClpCholeskyMixed &rhs)
+{
+  maximumRefinements_ = rhs.maximumRefinements_;
+  tolerance_ = rhs.tolerance_;
+  useDouble_ = rhs.useDouble_;
+  numberSolves_ = rhs.numberSolves_;
+  numberRefinements_ = rhs.numberRefinements_;
+  floatFactor_ = CoinCopyOfArray(rhs.floatFactor_, sizeFactor_);
+  floatDiagonal_ = CoinCopyOfArray(rhs.floatDiagonal_, numberRows_);
+}
+/* Orders rows and saves pointer to model */
+int ClpCholeskyMixed::order(ClpInterior *model)
+{
+  // new solve so start again in single precision
+  useDouble_ = false;
+  numberColumns_ = model->numberColumns();
+  denseThreshold_ = -1;
+  goDense_ = 2.0;
+  return ClpCholeskyBase::order(model);
+}
+/* Does symbolic factorization and gets single precision space */
+int ClpCholeskyMixed::symbolic()
+{
+  int returnCode = ClpCholeskyBase::symbolic();
+  if (returnCode)
+    return returnCode;
+  gutsOfDelete();
+  // double factor only wanted if we go over to it
+  delete[] sparseFactor_;
+  sparseFactor_ = NULL;
+  try {
+    floatFactor_ = new float[sizeFactor_];
+    floatDiagonal_ = new float[numberRows_];
+  } catch (...) {
+    // no memory
+    gutsOfDelete();
+    return -1;
+  }
+  // x, r, b, y and permuted work for solveFloat
+  if (createNormalVectors(5)) {
+    gutsOfDelete();
+    return -1;
+  }
+  return 0;
+}
+/* Factorizes in single precision using model_ and diagonal */
+int ClpCholeskyMixed::factorize(const CoinWorkDouble *diagonal, int *rowsDropped)
+{
+  if (useDouble_)
+    return ClpCholeskyBase::factorize(diagonal, rowsDropped);
+  const CoinBigIndex *columnStart = model_->clpMatrix()->getVectorStarts();
+  const int *columnLength = model_->clpMatrix()->getVectorLengths();
+  const int *row = model_->clpMatrix()->getIndices();
+  const double *element = model_->clpMatrix()->getElements();
+  const CoinBigIndex *rowStart = rowCopy_->getVectorStarts();
+  const int *rowLength = rowCopy_->getVectorLengths();
+  const int *column = rowCopy_->getIndices();
+  const double *elementByRow = rowCopy_->getElements();
+  CoinMemcpyN(diagonal, numberRows_ + numberColumns_, saveDiagonal_);
+  // perturbation as ClpCholeskyBase
+  CoinWorkDouble perturbation = model_->diagonalPerturbation() * model_->diagonalNorm();
+  if (perturbation > 1.0)
+    perturbation = 1.0;
+  CoinWorkDouble delta2 = model_->delta(); // add delta*delta to diagonal
+  delta2 *= delta2;
+  const CoinWorkDouble *diagonalSlack = diagonal + numberColumns_;
+  // largest on diagonal of A D A' to decide on dropping
+  CoinWorkDouble *work = normalWork_;
+  CoinZeroN(work, numberRows_);
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    CoinWorkDouble value = diagonal[iColumn];
+    for (CoinBigIndex j = columnStart[iColumn]; j < columnStart[iColumn] + columnLength[iColumn]; j++)
+      work[row[j]] += value * element[j] * element[j];
+  }
+  CoinWorkDouble largest = 1.0e-20;
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    largest = CoinMax(largest, CoinAbs(work[iRow] + diagonalSlack[iRow] + delta2));
+    work[iRow] = 0.0;
+  }
+  CoinWorkDouble dropValue = CoinMax(1.0e-20, CoinMin(1.0e-20 * largest, CHOL_SMALL_VALUE));
+  // left looking L D L' - columns still to be used are linked by next row
+  int *head = new int[numberRows_];
+  CoinBigIndex *first = new CoinBigIndex[numberRows_];
+  int *next = link_;
+  for (int iRow = 0; iRow < numberRows_; iRow++)
+    head[iRow] = -1;
+  numberRowsDropped_ = 0;
+  CoinWorkDouble largestPivot = 0.0;
+  CoinWorkDouble smallestPivot = COIN_DBL_MAX;
+  bool overflow = false;
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    int iOriginalRow = permute_[iRow];
+    CoinBigIndex start = choleskyStart_[iRow];
+    int number = static_cast< int >(choleskyStart_[iRow + 1] - start);
+    const CoinBigIndex *which = choleskyRow_ + indexStart_[iRow];
+    bool dropped = !rowLength[iOriginalRow];
+    if (!dropped) {
+      work[iRow] = diagonalSlack[iOriginalRow] + delta2;
+      for (CoinBigIndex k = rowStart[iOriginalRow]; k < rowStart[iOriginalRow] + rowLength[iOriginalRow]; k++) {
+        int iColumn = column[k];
+        CoinWorkDouble multiplier = diagonal[iColumn] * elementByRow[k];
+        for (CoinBigIndex j = columnStart[iColumn]; j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+          int jNewRow = permuteInverse_[row[j]];
+          if (jNewRow >= iRow)
+            work[jNewRow] += element[j] * multiplier;
+        }
+      }
+    }
+    // updates from earlier columns with an element in this row
+    int kRow = head[iRow];
+    while (kRow >= 0) {
+      int nextRow = next[kRow];
+      CoinBigIndex get = first[kRow];
+      CoinBigIndex end = choleskyStart_[kRow + 1];
+      CoinBigIndex offset = indexStart_[kRow] - choleskyStart_[kRow];
+      CoinWorkDouble a_jk = floatFactor_[get];
+      CoinWorkDouble value = a_jk * floatDiagonal_[kRow];
+      work[iRow] -= a_jk * value;
+      for (CoinBigIndex j = get + 1; j < end; j++)
+        work[choleskyRow_[j + offset]] -= floatFactor_[j] * value;
+      get++;
+      if (get < end) {
+        int jRow = choleskyRow_[get + offset];
+        first[kRow] = get;
+        next[kRow] = head[jRow];
+        head[jRow] = kRow;
+      }
+      kRow = nextRow;
+    }
+    CoinWorkDouble pivot = work[iRow] + perturbation;
+    work[iRow] = 0.0;
+    if (dropped || !(pivot > dropValue)) {
+      rowsDropped_[iOriginalRow] = 1;
+      numberRowsDropped_++;
+      rowDiagonal_[iOriginalRow] = 0.0;
+      floatDiagonal_[iRow] = 0.0;
+      for (int j = 0; j < number; j++) {
+        floatFactor_[start + j] = 0.0;
+        work[which[j]] = 0.0;
+      }
+    } else {
+      rowsDropped_[iOriginalRow] = 0;
+      rowDiagonal_[iOriginalRow] = diagonalSlack[iOriginalRow] + delta2 + perturbation;
+      largestPivot = CoinMax(largestPivot, pivot);
+      smallestPivot = CoinMin(smallestPivot, pivot);
+      floatDiagonal_[iRow] = static_cast< float >(pivot);
+      CoinWorkDouble inverse = 1.0 / pivot;
+      for (int j = 0; j < number; j++) {
+        CoinWorkDouble value = work[which[j]] * inverse;
+        if (CoinAbs(value) > 1.0e30)
+          overflow = true;
+        floatFactor_[start + j] = static_cast< float >(value);
+        work[which[j]] = 0.0;
+      }
+      if (number) {
+        first[iRow] = start;
+        next[iRow] = head[which[0]];
+        head[which[0]] = iRow;
+      }
+    }
+  }
+  delete[] head;
+  delete[] first;
+  if (overflow || largestPivot > 1.0e30) {
+    // out of range for single precision
+    return switchToDouble(rowsDropped, false);
+  }
+  for (int iRow = 0; iRow < numberRows_; iRow++)
+    rowsDropped[iRow] = rowsDropped_[iRow];
+  choleskyCondition_ = numberRowsDropped_ < numberRows_ ? largestPivot / smallestPivot : 1.0;
+  status_ = 0;
+  return numberRowsDropped_;
+}
+// Forward and back substitution with single precision factor (in place)
+void ClpCholeskyMixed::solveFloat(CoinWorkDouble *region)
+{
+  CoinWorkDouble *work = normalWork_ + 4 * numberRows_;
+  int iRow;
+  for (iRow = 0; iRow < numberRows_; iRow++)
+    work[iRow] = region[permute_[iRow]];
+  // forward
+  for (iRow = 0; iRow < numberRows_; iRow++) {
+    CoinWorkDouble value = work[iRow];
+    if (value) {
+      CoinBigIndex offset = indexStart_[iRow] - choleskyStart_[iRow];
+      for (CoinBigIndex j = choleskyStart_[iRow]; j < choleskyStart_[iRow + 1]; j++)
+        work[choleskyRow_[j + offset]] -= floatFactor_[j] * value;
+    }
+  }
+  // diagonal - dropped rows give zero
+  for (iRow = 0; iRow < numberRows_; iRow++) {
+    if (floatDiagonal_[iRow])
+      work[iRow] /= floatDiagonal_[iRow];
+    else
+      work[iRow] = 0.0;
+  }
+  // back
+  for (iRow = numberRows_ - 1; iRow >= 0; iRow--) {
+    CoinWorkDouble value = work[iRow];
+    CoinBigIndex offset = indexStart_[iRow] - choleskyStart_[iRow];
+    for (CoinBigIndex j = choleskyStart_[iRow]; j < choleskyStart_[iRow + 1]; j++)
+      value -= floatFactor_[j] * work[choleskyRow_[j + offset]];
+    work[iRow] = value;
+  }
+  for (iRow = 0; iRow < numberRows_; iRow++)
+    region[permute_[iRow]] = work[iRow];
+}
+/* Solves with single precision factor and refines in double */
+void ClpCholeskyMixed::solve(CoinWorkDouble *region)
+{
+  if (useDouble_) {
+    ClpCholeskyBase::solve(region);
+    return;
+  }
+  CoinWorkDouble *x = normalWork_;
+  CoinWorkDouble *r = x + numberRows_;
+  CoinWorkDouble *b = r + numberRows_;
+  CoinWorkDouble *y = b + numberRows_;
+  CoinWorkDouble normB = 0.0;
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    CoinWorkDouble value = rowsDropped_[iRow] ? 0.0 : region[iRow];
+    b[iRow] = value;
+    x[iRow] = value;
+    normB = CoinMax(normB, CoinAbs(value));
+  }
+  if (!normB) {
+    CoinZeroN(region, numberRows_);
+    return;
+  }
+  numberSolves_++;
+  solveFloat(x);
+  CoinWorkDouble lastNorm = COIN_DBL_MAX;
+  bool converged = false;
+  for (int iRefine = 0;; iRefine++) {
+    normalTimes(x, y);
+    CoinWorkDouble normR = 0.0;
+    for (int iRow = 0; iRow < numberRows_; iRow++) {
+      r[iRow] = b[iRow] - y[iRow];
+      normR = CoinMax(normR, CoinAbs(r[iRow]));
+    }
+    if (normR <= tolerance_ * normB) {
+      converged = true;
+      break;
+    }
+    // stalled if not halving
+    if (iRefine >= maximumRefinements_ || normR > 0.5 * lastNorm)
+      break;
+    lastNorm = normR;
+    solveFloat(r);
+    for (int iRow = 0; iRow < numberRows_; iRow++)
+      x[iRow] += r[iRow];
+    numberRefinements_++;
+  }
+  if (!converged) {
+    // region still has right hand side
+    int *dropped = new int[numberRows_];
+    int returnCode = switchToDouble(dropped, true);
+    delete[] dropped;
+    if (returnCode >= 0) {
+      ClpCholeskyBase::solve(region);
+      return;
+    }
+  }
+  CoinMemcpyN(x, numberRows_, region);
+}
+/* Does ClpCholeskyBase factorization in double with saved diagonal */
+int ClpCholeskyMixed::switchToDouble(int *rowsDropped, bool keepDropped)
+{
+  try {
+    sparseFactor_ = new longDouble[sizeFactor_];
+  } catch (...) {
+    // not enough memory - stay in single precision
+    return -1;
+  }
+  useDouble_ = true;
+  delete[] floatFactor_;
+  floatFactor_ = NULL;
+  if (!keepDropped) {
+    memset(rowsDropped_, 0, numberRows_);
+    numberRowsDropped_ = 0;
+  }
+  int returnCode = ClpCholeskyBase::factorize(saveDiagonal_, rowsDropped);
+  switchMessage("Single precision Cholesky not accurate enough", numberSolves_,
+    "double");
+  return returnCode;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,132 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef ClpCholeskyMixed_H
+#define ClpCholeskyMixed_H
+
+#include "ClpCholeskyBase.hpp"
+
+/** Mixed precision class for normal equations in Clp barrier.
+
+    Uses the ClpCholeskyBase ordering and symbolic factorization but
+    A D A' is factorized as L D L' with L and D held in single precision
+    which halves the memory and bandwidth of the factor.  Each solve is
+    followed by iterative refinement in double using the residual
+    b - (A D A' + diagonal) x computed with matrix times vector.
+
+    When refinement stalls (as it will when A D A' gets ill conditioned
+    near optimality) the factor is redone in double by ClpCholeskyBase
+    and that is used for the rest of the solve.
+
+    Only for normal equations - not KKT.  No dense columns or dense
+    block at end.
+*/
+
+class CLPLIB_EXPORT ClpCholeskyMixed : public ClpCholeskyBase {
+
+public:
+  /**@name Virtual methods that the derived classes provides  */
+  //@{
+  /** Orders rows and saves pointer to model.
+      Returns non-zero if not enough memory */
+  virtual int order(ClpInterior *model);
+  /** Does symbolic factorization and gets single precision space.
+      Returns non-zero if not enough memory */
+  virtual int symbolic();
+  /** Factorizes in single precision using model_ and diagonal.
+         This uses work arrays and fills in rowsDropped, returning
+         number dropped.
+         If return code negative then out of memory */
+  virtual int factorize(const CoinWorkDouble *diagonal, int *rowsDropped);
+  /** Solves with single precision factor and refines in double */
+  virtual void solve(CoinWorkDouble *region);
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  /// Maximum refinement steps in one solve
+  inline int maximumRefinements() const
+  {
+    return maximumRefinements_;
+  }
+  inline void setMaximumRefinements(int value)
+  {
+    maximumRefinements_ = value;
+  }
+  /// Relative residual wanted
+  inline double tolerance() const
+  {
+    return tolerance_;
+  }
+  inline void setTolerance(double value)
+  {
+    tolerance_ = value;
+  }
+  /// True if gone over to double precision factorization
+  inline bool usingDouble() const
+  {
+    return useDouble_;
+  }
+  /// Number of solves in single precision
+  inline int numberSolves() const
+  {
+    return numberSolves_;
+  }
+  /// Total refinement steps
+  inline int numberRefinements() const
+  {
+    return numberRefinements_;
+  }
+  //@}
+
+  /**@name Constructors, destructor */
+  //@{
+  /** Constructor */
+  ClpCholeskyMixed(int maximumRefinements = 10, double tolerance = 1.0e-10);
+  /** Destructor  */
+  virtual ~ClpCholeskyMixed();
+  /// Copy
+  ClpCholeskyMixed(const ClpCholeskyMixed &);
+  /// Assignment
+  ClpCholeskyMixed &operator=(const ClpCholeskyMixed &);
+  /// Clone
+  virtual ClpCholeskyBase *clone() const;
+  //@}
+
+private:
+  /// Forward and back substitution with single precision factor (in place)
+  void solveFloat(CoinWorkDouble *region);
+  /** Does ClpCholeskyBase factorization in double with saved diagonal.
+      If keepDropped then rows dropped in single precision stay dropped
+      (switching inside solve, where caller already has drop set).
+      Returns as ClpCholeskyBase::factorize or -1 if not enough
+      memory (then stays in single) */
+  int switchToDouble(int *rowsDropped, bool keepDropped);
+  /// Frees single precision factor
+  void gutsOfDelete();
+  /// Copies single precision factor and counts
+  void gutsOfCopy(const ClpCholeskyMixed &rhs);
+  /**@name Data members */
+  //@{
+  /// Maximum refinement steps in one solve
+  int maximumRefinements_;
+  /// Relative residual wanted
+  double tolerance_;
+  /// Whether using double precision factorization
+  bool useDouble_;
+  /// Number of solves in single precision
+  int numberSolves_;
+  /// Total refinement steps
+  int numberRefinements_;
+  /// Single precision factor (sizeFactor_)
+  float *floatFactor_;
+  /// Single precision D (zero if row dropped)
+  float *floatDiagonal_;
+  //@}
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,271 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "ClpHelperFunctions.hpp"
+
+#include "ClpInterior.hpp"
+#include "ClpCholeskyPCG.hpp"
+
+//#############################################################################
+// Constructors / Destructor / Assignment
+//#############################################################################
+
+//-------------------------------------------------------------------
+// Default Constructor
+//-------------------------------------------------------------------
+ClpCholeskyPCG::ClpCholeskyPCG(int maximumIterations, double tolerance)
+  : ClpCholeskyBase()
+  , maximumIterations_(maximumIterations)
+  , tolerance_(tolerance)
+  , useFactorization_(false)
+  , noFactorization_(false)
+  , numberSolves_(0)
+  , numberIterations_(0)
+  , preconditioner_(NULL)
+{
+  type_ = 18;
+}
+
+//-------------------------------------------------------------------
+// Copy constructor
+//-------------------------------------------------------------------
+ClpCholeskyPCG::ClpCholeskyPCG(const ClpCholeskyPCG &rhs)
+  : ClpCholeskyBase(rhs)
+{
+  gutsOfCopy(rhs);
+}
+
+//-------------------------------------------------------------------
+// Destructor
+//-------------------------------------------------------------------
+ClpCholeskyPCG::~ClpCholeskyPCG()
+{
+  gutsOfDelete();
+}
+
+//----------------------------------------------------------------
+// Assignment operator
+//-------------------------------------------------------------------
+ClpCholeskyPCG &
+ClpCholeskyPCG::operator=(const ClpCholeskyPCG &rhs)
+{
+  if (this != &rhs) {
+    ClpCholeskyBase::operator=(rhs);
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+//-------------------------------------------------------------------
+// Clone
+//-------------------------------------------------------------------
+ClpCholeskyBase *ClpCholeskyPCG::clone() const
+{
+  return new ClpCholeskyPCG(*this);
+}
+// Frees preconditioner
+void ClpCholeskyPCG::gutsOfDelete()
+{
+  delete[] preconditioner_;
+  preconditioner_ = NULL;
+}
+// Copies preconditioner and counts
+void ClpCholeskyPCG::gutsOfCopy(const ClpCholeskyPCG &rhs)
+{
+  maximumIterations_ = rhs.maximumIterations_;
+  tolerance_ = rhs.tolerance_;
+  useFactorization_ = rhs.useFactorization_;
+  noFactorization_ = rhs.noFactorization_;
+  numberSolves_ = rhs.numberSolves_;
+  numberIterations_ = rhs.numberIterations_;
+  preconditioner_ = CoinCopyOfArray(rhs.preconditioner_, numberRows_);
+}
+/* Saves pointer to model and gets space for vectors */
+int ClpCholeskyPCG::order(ClpInterior *model)
+{
+  if (useFactorization_)
+    return ClpCholeskyBase::order(model);
+  model_ = model;
+  numberRows_ = model->numberRows();
+  numberColumns_ = model->numberColumns();
+  gutsOfDelete();
+  delete[] rowsDropped_;
+  rowsDropped_ = new char[numberRows_];
+  memset(rowsDropped_, 0, numberRows_);
+  numberRowsDropped_ = 0;
+  preconditioner_ = new CoinWorkDouble[numberRows_];
+  // x, r, p and q
+  return createNormalVectors(4);
+}
+/* Nothing to do unless factorization being used */
+int ClpCholeskyPCG::symbolic()
+{
+  if (useFactorization_)
+    return ClpCholeskyBase::symbolic();
+  return 0;
+}
+/* Saves diagonal and sets up preconditioner */
+int ClpCholeskyPCG::factorize(const CoinWorkDouble *diagonal, int *rowsDropped)
+{
+  if (useFactorization_)
+    return ClpCholeskyBase::factorize(diagonal, rowsDropped);
+  const CoinBigIndex *columnStart = model_->clpMatrix()->getVectorStarts();
+  const int *columnLength = model_->clpMatrix()->getVectorLengths();
+  const int *row = model_->clpMatrix()->getIndices();
+  const double *element = model_->clpMatrix()->getElements();
+  CoinMemcpyN(diagonal, numberRows_ + numberColumns_, saveDiagonal_);
+  // perturbation as ClpCholeskyBase
+  CoinWorkDouble perturbation = model_->diagonalPerturbation() * model_->diagonalNorm();
+  if (perturbation > 1.0)
+    perturbation = 1.0;
+  CoinWorkDouble delta2 = model_->delta(); // add delta*delta to diagonal
+  delta2 *= delta2;
+  // empty rows are dropped
+  memset(rowsDropped_, 1, numberRows_);
+  CoinZeroN(preconditioner_, numberRows_);
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    CoinWorkDouble value = diagonal[iColumn];
+    CoinBigIndex start = columnStart[iColumn];
+    CoinBigIndex end = start + columnLength[iColumn];
+    for (CoinBigIndex j = start; j < end; j++) {
+      int iRow = row[j];
+      rowsDropped_[iRow] = 0;
+      preconditioner_[iRow] += value * element[j] * element[j];
+    }
+  }
+  const CoinWorkDouble *diagonalSlack = diagonal + numberColumns_;
+  CoinWorkDouble largest = 1.0e-20;
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    preconditioner_[iRow] += diagonalSlack[iRow] + delta2;
+    largest = CoinMax(largest, CoinAbs(preconditioner_[iRow]));
+  }
+  CoinWorkDouble tolerance = 1.0e-20 * largest;
+  CoinWorkDouble smallest = COIN_DBL_MAX;
+  numberRowsDropped_ = 0;
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    CoinWorkDouble value = preconditioner_[iRow];
+    if (rowsDropped_[iRow] || value <= tolerance) {
+      rowsDropped_[iRow] = 1;
+      numberRowsDropped_++;
+      rowDiagonal_[iRow] = 0.0;
+      preconditioner_[iRow] = 0.0;
+    } else {
+      value += perturbation;
+      smallest = CoinMin(smallest, value);
+      rowDiagonal_[iRow] = diagonalSlack[iRow] + delta2 + perturbation;
+      preconditioner_[iRow] = 1.0 / value;
+    }
+    rowsDropped[iRow] = rowsDropped_[iRow];
+  }
+  choleskyCondition_ = largest / smallest;
+  status_ = 0;
+  return numberRowsDropped_;
+}
+/* Solves by conjugate gradients (or factorization) */
+void ClpCholeskyPCG::solve(CoinWorkDouble *region)
+{
+  if (useFactorization_) {
+    ClpCholeskyBase::solve(region);
+    return;
+  }
+  CoinWorkDouble *x = normalWork_;
+  CoinWorkDouble *r = x + numberRows_;
+  CoinWorkDouble *p = r + numberRows_;
+  // q is also used for preconditioned residual
+  CoinWorkDouble *q = p + numberRows_;
+  CoinWorkDouble normB = 0.0;
+  CoinWorkDouble rz = 0.0;
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    CoinWorkDouble value = preconditioner_[iRow] ? region[iRow] : 0.0;
+    x[iRow] = 0.0;
+    r[iRow] = value;
+    p[iRow] = value * preconditioner_[iRow];
+    normB += value * value;
+    rz += value * p[iRow];
+  }
+  if (!normB) {
+    CoinZeroN(region, numberRows_);
+    return;
+  }
+  CoinWorkDouble target = tolerance_ * tolerance_ * normB;
+  int maximumIterations = maximumIterations_;
+  if (!maximumIterations)
+    maximumIterations = CoinMin(2 * numberRows_ + 10, 1000);
+  bool converged = false;
+  int iteration;
+  for (iteration = 0; iteration < maximumIterations; iteration++) {
+    normalTimes(p, q);
+    CoinWorkDouble pq = 0.0;
+    for (int iRow = 0; iRow < numberRows_; iRow++)
+      pq += p[iRow] * q[iRow];
+    if (pq <= 0.0)
+      break; // breakdown
+    CoinWorkDouble alpha = rz / pq;
+    CoinWorkDouble normR = 0.0;
+    for (int iRow = 0; iRow < numberRows_; iRow++) {
+      x[iRow] += alpha * p[iRow];
+      r[iRow] -= alpha * q[iRow];
+      normR += r[iRow] * r[iRow];
+    }
+    if (normR <= target) {
+      converged = true;
+      iteration++;
+      break;
+    }
+    CoinWorkDouble rzNew = 0.0;
+    for (int iRow = 0; iRow < numberRows_; iRow++) {
+      q[iRow] = r[iRow] * preconditioner_[iRow];
+      rzNew += r[iRow] * q[iRow];
+    }
+    CoinWorkDouble beta = rzNew / rz;
+    rz = rzNew;
+    for (int iRow = 0; iRow < numberRows_; iRow++)
+      p[iRow] = q[iRow] + beta * p[iRow];
+  }
+  numberSolves_++;
+  numberIterations_ += iteration;
+  if (!converged && !noFactorization_) {
+    // region still has right hand side
+    if (!switchToFactorization()) {
+      ClpCholeskyBase::solve(region);
+      return;
+    }
+  }
+  CoinMemcpyN(x, numberRows_, region);
+}
+/* Does ClpCholeskyBase ordering and factorization with saved diagonal */
+int ClpCholeskyPCG::switchToFactorization()
+{
+  char *saveDropped = rowsDropped_;
+  int saveNumberDropped = numberRowsDropped_;
+  rowsDropped_ = NULL;
+  int returnCode = ClpCholeskyBase::order(model_);
+  if (!returnCode)
+    returnCode = ClpCholeskyBase::symbolic();
+  if (returnCode) {
+    // not enough memory - stay with conjugate gradients
+    delete[] rowsDropped_;
+    rowsDropped_ = saveDropped;
+    numberRowsDropped_ = saveNumberDropped;
+    noFactorization_ = true;
+    return returnCode;
+  }
+  /* drop same rows as conjugate gradients so this solve is consistent
+     with those already done with this diagonal (caller has that set) */
+  CoinMemcpyN(saveDropped, numberRows_, rowsDropped_);
+  numberRowsDropped_ = saveNumberDropped;
+  delete[] saveDropped;
+  useFactorization_ = true;
+  int *dropped = new int[numberRows_];
+  ClpCholeskyBase::factorize(saveDiagonal_, dropped);
+  delete[] dropped;
+  switchMessage("Conjugate gradients not converged", numberSolves_,
+    "Cholesky factorization");
+  return 0;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
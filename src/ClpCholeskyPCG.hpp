@@ -0,0 +1,124 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef ClpCholeskyPCG_H
+#define ClpCholeskyPCG_H
+
+#include "ClpCholeskyBase.hpp"
+
+/** Matrix free class for normal equations in Clp barrier.
+
+    Instead of forming and factorizing A D A' the system is solved by
+    preconditioned conjugate gradients using only matrix times vector
+    (ClpMatrixBase::times and transposeTimes as in ClpLsqr) so memory is
+    just a few vectors.  The preconditioner is the diagonal of A D A'.
+
+    If conjugate gradients does not get to tolerance within the maximum
+    number of iterations the ClpCholeskyBase ordering and factorization
+    are done and used from then on (unless there is not enough memory).
+
+    Only for normal equations - not KKT.
+*/
+
+class CLPLIB_EXPORT ClpCholeskyPCG : public ClpCholeskyBase {
+
+public:
+  /**@name Virtual methods that the derived classes provides  */
+  //@{
+  /** Saves pointer to model and gets space for vectors.
+      Returns non-zero if not enough memory */
+  virtual int order(ClpInterior *model);
+  /** Nothing to do unless factorization being used */
+  virtual int symbolic();
+  /** Saves diagonal and sets up preconditioner - filling in rowsDropped
+         and returning number dropped.
+         If return code negative then out of memory */
+  virtual int factorize(const CoinWorkDouble *diagonal, int *rowsDropped);
+  /** Solves by conjugate gradients (or factorization) */
+  virtual void solve(CoinWorkDouble *region);
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  /// Maximum conjugate gradient iterations in one solve (0 - 2*rows+10 up to 1000)
+  inline int maximumIterations() const
+  {
+    return maximumIterations_;
+  }
+  inline void setMaximumIterations(int value)
+  {
+    maximumIterations_ = value;
+  }
+  /// Relative residual wanted
+  inline double tolerance() const
+  {
+    return tolerance_;
+  }
+  inline void setTolerance(double value)
+  {
+    tolerance_ = value;
+  }
+  /// True if gone over to factorization
+  inline bool usingFactorization() const
+  {
+    return useFactorization_;
+  }
+  /// Number of solves by conjugate gradients
+  inline int numberSolves() const
+  {
+    return numberSolves_;
+  }
+  /// Total conjugate gradient iterations
+  inline int numberIterations() const
+  {
+    return numberIterations_;
+  }
+  //@}
+
+  /**@name Constructors, destructor */
+  //@{
+  /** Constructor - maximumIterations 0 means 2*rows+10 up to 1000 */
+  ClpCholeskyPCG(int maximumIterations = 0, double tolerance = 1.0e-10);
+  /** Destructor  */
+  virtual ~ClpCholeskyPCG();
+  /// Copy
+  ClpCholeskyPCG(const ClpCholeskyPCG &);
+  /// Assignment
+  ClpCholeskyPCG &operator=(const ClpCholeskyPCG &);
+  /// Clone
+  virtual ClpCholeskyBase *clone() const;
+  //@}
+
+private:
+  /** Does ClpCholeskyBase ordering and factorization with saved diagonal.
+      Returns non-zero if not enough memory (then stays with conjugate
+      gradients) */
+  int switchToFactorization();
+  /// Frees preconditioner
+  void gutsOfDelete();
+  /// Copies preconditioner and counts
+  void gutsOfCopy(const ClpCholeskyPCG &rhs);
+  /**@name Data members */
+  //@{
+  /// Maximum iterations in one solve
+  int maximumIterations_;
+  /// Relative residual wanted
+  double tolerance_;
+  /// Whether using factorization
+  bool useFactorization_;
+  /// True if not enough memory for factorization
+  bool noFactorization_;
+  /// Number of solves by conjugate gradients
+  int numberSolves_;
+  /// Total conjugate gradient iterations
+  int numberIterations_;
+  /// Inverse of preconditioner (zero if row dropped)
+  CoinWorkDouble *preconditioner_;
+  //@}
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
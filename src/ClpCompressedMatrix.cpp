@@ -0,0 +1,887 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
+#include "CoinPragma.hpp"
+#include "CoinIndexedVector.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinSort.hpp"
+
+#include "ClpSimplex.hpp"
+#include "ClpPackedMatrix.hpp"
+// at end to get min/max!
+#include "ClpCompressedMatrix.hpp"
+
+// Delta which says full row follows as two shorts
+#define CLP_COMPRESSED_ESCAPE 0xffff
+// Maximum number of different values for pool
+#define CLP_COMPRESSED_POOL 65536
+
+// Value accessors so kernels can be instantiated for each storage
+struct ClpCompressedDouble {
+  const double *COIN_RESTRICT element_;
+  inline double operator[](CoinBigIndex k) const
+  {
+    return element_[k];
+  }
+};
+struct ClpCompressedFloat {
+  const float *COIN_RESTRICT element_;
+  inline double operator[](CoinBigIndex k) const
+  {
+    return static_cast< double >(element_[k]);
+  }
+};
+struct ClpCompressedPool {
+  const unsigned short *COIN_RESTRICT index_;
+  const double *COIN_RESTRICT element_;
+  inline double operator[](CoinBigIndex k) const
+  {
+    return element_[index_[k]];
+  }
+};
+// Decodes next row (p is position in delta stream)
+static inline int nextRow(const unsigned short *COIN_RESTRICT delta,
+  CoinBigIndex &p, int iRow)
+{
+  unsigned int value = delta[p++];
+  if (value != CLP_COMPRESSED_ESCAPE) {
+    return iRow + static_cast< int >(value);
+  } else {
+    unsigned int low = delta[p];
+    unsigned int high = delta[p + 1];
+    p += 2;
+    return static_cast< int >(low | (high << 16));
+  }
+}
+// Dot product of one column with dense pi
+template < class V >
+static inline double compressedDot(const unsigned short *COIN_RESTRICT delta,
+  CoinBigIndex p, const V &values, const double *COIN_RESTRICT pi,
+  CoinBigIndex start, CoinBigIndex end)
+{
+  double value = 0.0;
+  int iRow = 0;
+  for (CoinBigIndex k = start; k < end; k++) {
+    iRow = nextRow(delta, p, iRow);
+    value += pi[iRow] * values[k];
+  }
+  return value;
+}
+// y += scalar * A * x (scaled if rowScale)
+template < class V >
+static void compressedTimes(int numberColumns,
+  const CoinBigIndex *COIN_RESTRICT deltaStart,
+  const CoinBigIndex *COIN_RESTRICT elementStart,
+  const unsigned short *COIN_RESTRICT delta, const V &values,
+  double scalar, const double *COIN_RESTRICT x, double *COIN_RESTRICT y,
+  const double *COIN_RESTRICT rowScale,
+  const double *COIN_RESTRICT columnScale)
+{
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    double value = x[iColumn];
+    if (value) {
+      CoinBigIndex p = deltaStart[iColumn];
+      CoinBigIndex start = elementStart[iColumn];
+      CoinBigIndex end = elementStart[iColumn + 1];
+      int iRow = 0;
+      value *= scalar;
+      if (!rowScale) {
+        for (CoinBigIndex k = start; k < end; k++) {
+          iRow = nextRow(delta, p, iRow);
+          y[iRow] += value * values[k];
+        }
+      } else {
+        value *= columnScale[iColumn];
+        for (CoinBigIndex k = start; k < end; k++) {
+          iRow = nextRow(delta, p, iRow);
+          y[iRow] += value * values[k] * rowScale[iRow];
+        }
+      }
+    }
+  }
+}
+// y += scalar * pi * A (pi already row scaled)
+template < class V >
+static void compressedTransposeTimes(int numberColumns,
+  const CoinBigIndex *COIN_RESTRICT deltaStart,
+  const CoinBigIndex *COIN_RESTRICT elementStart,
+  const unsigned short *COIN_RESTRICT delta, const V &values,
+  double scalar, const double *COIN_RESTRICT pi, double *COIN_RESTRICT y,
+  const double *COIN_RESTRICT columnScale)
+{
+  CoinBigIndex start = elementStart[0];
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    CoinBigIndex end = elementStart[iColumn + 1];
+    double value = compressedDot(delta, deltaStart[iColumn], values, pi,
+      start, end);
+    start = end;
+    if (columnScale)
+      value *= columnScale[iColumn];
+    y[iColumn] += value * scalar;
+  }
+}
+// pi * A into indexed arrays (pi already scaled), returns number nonzero
+template < class V >
+static int compressedTransposeTimes(int numberColumns,
+  const CoinBigIndex *COIN_RESTRICT deltaStart,
+  const CoinBigIndex *COIN_RESTRICT elementStart,
+  const unsigned short *COIN_RESTRICT delta, const V &values,
+  const double *COIN_RESTRICT pi, double zeroTolerance,
+  const double *COIN_RESTRICT columnScale, bool packed,
+  int *COIN_RESTRICT index, double *COIN_RESTRICT array)
+{
+  int numberNonZero = 0;
+  CoinBigIndex start = elementStart[0];
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    CoinBigIndex end = elementStart[iColumn + 1];
+    double value = compressedDot(delta, deltaStart[iColumn], values, pi,
+      start, end);
+    start = end;
+    if (columnScale)
+      value *= columnScale[iColumn];
+    if (fabs(value) > zeroTolerance) {
+      if (packed)
+        array[numberNonZero] = value;
+      else
+        array[iColumn] = value;
+      index[numberNonZero++] = iColumn;
+    }
+  }
+  return numberNonZero;
+}
+// pi * A just for columns in which (packed output)
+template < class V >
+static void compressedSubsetTransposeTimes(
+  const CoinBigIndex *COIN_RESTRICT deltaStart,
+  const CoinBigIndex *COIN_RESTRICT elementStart,
+  const unsigned short *COIN_RESTRICT delta, const V &values,
+  const double *COIN_RESTRICT pi,
+  const double *COIN_RESTRICT rowScale,
+  const double *COIN_RESTRICT columnScale,
+  int numberToDo, const int *COIN_RESTRICT which,
+  double *COIN_RESTRICT array)
+{
+  if (!rowScale) {
+    for (int jColumn = 0; jColumn < numberToDo; jColumn++) {
+      int iColumn = which[jColumn];
+      array[jColumn] = compressedDot(delta, deltaStart[iColumn], values, pi,
+        elementStart[iColumn], elementStart[iColumn + 1]);
+    }
+  } else {
+    for (int jColumn = 0; jColumn < numberToDo; jColumn++) {
+      int iColumn = which[jColumn];
+      CoinBigIndex p = deltaStart[iColumn];
+      CoinBigIndex end = elementStart[iColumn + 1];
+      int iRow = 0;
+      double value = 0.0;
+      for (CoinBigIndex k = elementStart[iColumn]; k < end; k++) {
+        iRow = nextRow(delta, p, iRow);
+        value += pi[iRow] * values[k] * rowScale[iRow];
+      }
+      array[jColumn] = value * columnScale[iColumn];
+    }
+  }
+}
+//#############################################################################
+// Constructors / Destructor / Assignment
+//#############################################################################
+
+//-------------------------------------------------------------------
+// Default Constructor
+//-------------------------------------------------------------------
+ClpCompressedMatrix::ClpCompressedMatrix()
+  : ClpMatrixBase()
+{
+  setType(10);
+  matrix_ = NULL;
+  lengths_ = NULL;
+  delta_ = NULL;
+  elementDouble_ = NULL;
+  elementFloat_ = NULL;
+  poolIndex_ = NULL;
+  numberRows_ = 0;
+  numberColumns_ = 0;
+  numberDifferent_ = 0;
+  valueType_ = valuesDouble;
+  deltaStart_ = new CoinBigIndex[1];
+  deltaStart_[0] = 0;
+  elementStart_ = new CoinBigIndex[1];
+  elementStart_[0] = 0;
+}
+
+//-------------------------------------------------------------------
+// Copy constructor
+//-------------------------------------------------------------------
+ClpCompressedMatrix::ClpCompressedMatrix(const ClpCompressedMatrix &rhs)
+  : ClpMatrixBase(rhs)
+{
+  setType(10);
+  gutsOfCopy(rhs);
+}
+
+ClpCompressedMatrix::ClpCompressedMatrix(const CoinPackedMatrix &rhs,
+  bool compressValues)
+  : ClpMatrixBase()
+{
+  setType(10);
+  gutsOfCreate(rhs, compressValues);
+}
+
+//-------------------------------------------------------------------
+// Destructor
+//-------------------------------------------------------------------
+ClpCompressedMatrix::~ClpCompressedMatrix()
+{
+  gutsOfDelete();
+}
+
+//----------------------------------------------------------------
+// Assignment operator
+//-------------------------------------------------------------------
+ClpCompressedMatrix &
+ClpCompressedMatrix::operator=(const ClpCompressedMatrix &rhs)
+{
+  if (this != &rhs) {
+    ClpMatrixBase::operator=(rhs);
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+// Free arrays
+void ClpCompressedMatrix::gutsOfDelete()
+{
+  delete matrix_;
+  delete[] lengths_;
+  delete[] deltaStart_;
+  delete[] elementStart_;
+  delete[] delta_;
+  delete[] elementDouble_;
+  delete[] elementFloat_;
+  delete[] poolIndex_;
+  matrix_ = NULL;
+  lengths_ = NULL;
+  deltaStart_ = NULL;
+  elementStart_ = NULL;
+  delta_ = NULL;
+  elementDouble_ = NULL;
+  elementFloat_ = NULL;
+  poolIndex_ = NULL;
+}
+// Copy from another
+void ClpCompressedMatrix::gutsOfCopy(const ClpCompressedMatrix &rhs)
+{
+  matrix_ = NULL;
+  lengths_ = NULL;
+  numberRows_ = rhs.numberRows_;
+  numberColumns_ = rhs.numberColumns_;
+  numberDifferent_ = rhs.numberDifferent_;
+  valueType_ = rhs.valueType_;
+  deltaStart_ = CoinCopyOfArray(rhs.deltaStart_, numberColumns_ + 1);
+  elementStart_ = CoinCopyOfArray(rhs.elementStart_, numberColumns_ + 1);
+  CoinBigIndex numberElements = elementStart_[numberColumns_];
+  delta_ = CoinCopyOfArray(rhs.delta_, deltaStart_[numberColumns_]);
+  elementDouble_ = NULL;
+  elementFloat_ = NULL;
+  poolIndex_ = NULL;
+  if (valueType_ == valuesPool) {
+    elementDouble_ = CoinCopyOfArray(rhs.elementDouble_, numberDifferent_);
+    poolIndex_ = CoinCopyOfArray(rhs.poolIndex_, numberElements);
+  } else if (valueType_ == valuesFloat) {
+    elementFloat_ = CoinCopyOfArray(rhs.elementFloat_, numberElements);
+  } else {
+    elementDouble_ = CoinCopyOfArray(rhs.elementDouble_, numberElements);
+  }
+}
+// Encode from a column ordered CoinPackedMatrix
+void ClpCompressedMatrix::gutsOfCreate(const CoinPackedMatrix &rhs,
+  bool compressValues)
+{
+  matrix_ = NULL;
+  lengths_ = NULL;
+  delta_ = NULL;
+  elementDouble_ = NULL;
+  elementFloat_ = NULL;
+  poolIndex_ = NULL;
+  numberDifferent_ = 0;
+  valueType_ = valuesDouble;
+  assert(rhs.isColOrdered());
+  numberRows_ = rhs.getNumRows();
+  numberColumns_ = rhs.getNumCols();
+  const int *row = rhs.getIndices();
+  const CoinBigIndex *columnStart = rhs.getVectorStarts();
+  const int *columnLength = rhs.getVectorLengths();
+  const double *elementByColumn = rhs.getElements();
+  deltaStart_ = new CoinBigIndex[numberColumns_ + 1];
+  elementStart_ = new CoinBigIndex[numberColumns_ + 1];
+  // get rid of gaps and sort rows in each column
+  CoinBigIndex numberElements = rhs.getNumElements();
+  int *rows = new int[numberElements];
+  double *elements = new double[numberElements];
+  CoinBigIndex numberDeltas = 0;
+  numberElements = 0;
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    CoinBigIndex start = columnStart[iColumn];
+    CoinBigIndex end = start + columnLength[iColumn];
+    deltaStart_[iColumn] = numberDeltas;
+    elementStart_[iColumn] = numberElements;
+    CoinBigIndex first = numberElements;
+    for (CoinBigIndex j = start; j < end; j++) {
+      rows[numberElements] = row[j];
+      elements[numberElements++] = elementByColumn[j];
+    }
+    CoinSort_2(rows + first, rows + numberElements, elements + first);
+    int lastRow = 0;
+    for (CoinBigIndex j = first; j < numberElements; j++) {
+      int iRow = rows[j];
+      if (iRow - lastRow < CLP_COMPRESSED_ESCAPE)
+        numberDeltas++;
+      else
+        numberDeltas += 3;
+      lastRow = iRow;
+    }
+  }
+  deltaStart_[numberColumns_] = numberDeltas;
+  elementStart_[numberColumns_] = numberElements;
+  delta_ = new unsigned short[numberDeltas];
+  numberDeltas = 0;
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    int lastRow = 0;
+    for (CoinBigIndex j = elementStart_[iColumn]; j < elementStart_[iColumn + 1]; j++) {
+      int iRow = rows[j];
+      if (iRow - lastRow < CLP_COMPRESSED_ESCAPE) {
+        delta_[numberDeltas++] = static_cast< unsigned short >(iRow - lastRow);
+      } else {
+        unsigned int value = static_cast< unsigned int >(iRow);
+        delta_[numberDeltas++] = CLP_COMPRESSED_ESCAPE;
+        delta_[numberDeltas++] = static_cast< unsigned short >(value & 0xffff);
+        delta_[numberDeltas++] = static_cast< unsigned short >(value >> 16);
+      }
+      lastRow = iRow;
+    }
+  }
+  delete[] rows;
+  if (compressValues && numberElements) {
+    // see how many different values
+    double *sorted = CoinCopyOfArray(elements, numberElements);
+    std::sort(sorted, sorted + numberElements);
+    int numberDifferent = static_cast< int >(std::unique(sorted, sorted + numberElements) - sorted);
+    // pool only worth it if table small compared to elements
+    if (numberDifferent <= CLP_COMPRESSED_POOL && 4 * numberDifferent < numberElements) {
+      valueType_ = valuesPool;
+      numberDifferent_ = numberDifferent;
+      elementDouble_ = CoinCopyOfArray(sorted, numberDifferent);
+      poolIndex_ = new unsigned short[numberElements];
+      for (CoinBigIndex j = 0; j < numberElements; j++) {
+        const double *position = std::lower_bound(sorted, sorted + numberDifferent,
+          elements[j]);
+        poolIndex_[j] = static_cast< unsigned short >(position - sorted);
+      }
+    } else {
+      bool allFloat = true;
+      for (int i = 0; i < numberDifferent; i++) {
+        double value = sorted[i];
+        if (static_cast< double >(static_cast< float >(value)) != value) {
+          allFloat = false;
+          break;
+        }
+      }
+      if (allFloat) {
+        valueType_ = valuesFloat;
+        elementFloat_ = new float[numberElements];
+        for (CoinBigIndex j = 0; j < numberElements; j++)
+          elementFloat_[j] = static_cast< float >(elements[j]);
+      }
+    }
+    delete[] sorted;
+  }
+  if (valueType_ == valuesDouble)
+    elementDouble_ = elements;
+  else
+    delete[] elements;
+}
+//-------------------------------------------------------------------
+// Clone
+//-------------------------------------------------------------------
+ClpMatrixBase *ClpCompressedMatrix::clone() const
+{
+  return new ClpCompressedMatrix(*this);
+}
+/* Subset clone (without gaps).  Duplicates are allowed
+   and order is as given */
+ClpMatrixBase *
+ClpCompressedMatrix::subsetClone(int numberRows, const int *whichRows,
+  int numberColumns,
+  const int *whichColumns) const
+{
+  bool existed = matrix_ != NULL;
+  CoinPackedMatrix subset(*getPackedMatrix(), numberRows, whichRows,
+    numberColumns, whichColumns);
+  if (!existed)
+    releasePackedMatrix();
+  ClpCompressedMatrix *newMatrix = new ClpCompressedMatrix(subset,
+    valueType_ != valuesDouble);
+  return newMatrix;
+}
+// Create matrix_
+ClpPackedMatrix *
+ClpCompressedMatrix::createMatrix() const
+{
+  if (!matrix_) {
+    CoinBigIndex numberElements = elementStart_[numberColumns_];
+    double *elements = new double[numberElements];
+    int *rows = new int[numberElements];
+    if (!lengths_)
+      lengths_ = new int[numberColumns_];
+    for (int i = 0; i < numberColumns_; i++) {
+      CoinBigIndex p = deltaStart_[i];
+      int iRow = 0;
+      lengths_[i] = static_cast< int >(elementStart_[i + 1] - elementStart_[i]);
+      for (CoinBigIndex j = elementStart_[i]; j < elementStart_[i + 1]; j++) {
+        iRow = nextRow(delta_, p, iRow);
+        elements[j] = elementValue(j);
+        rows[j] = iRow;
+      }
+    }
+    CoinPackedMatrix *matrix = new CoinPackedMatrix(true, numberRows_, numberColumns_,
+      numberElements,
+      elements, rows,
+      elementStart_, lengths_);
+    delete[] elements;
+    delete[] rows;
+    matrix_ = new ClpPackedMatrix(matrix);
+  }
+  return matrix_;
+}
+
+/* Returns a new matrix in reverse order without gaps */
+ClpMatrixBase *
+ClpCompressedMatrix::reverseOrderedCopy() const
+{
+  // no row copy (would defeat object of exercise)
+  return NULL;
+}
+//unscaled versions
+void ClpCompressedMatrix::times(double scalar,
+  const double *COIN_RESTRICT x, double *COIN_RESTRICT y) const
+{
+  times(scalar, x, y, NULL, NULL);
+}
+void ClpCompressedMatrix::transposeTimes(double scalar,
+  const double *COIN_RESTRICT x, double *COIN_RESTRICT y) const
+{
+  transposeTimes(scalar, x, y, NULL, NULL, NULL);
+}
+void ClpCompressedMatrix::times(double scalar,
+  const double *COIN_RESTRICT x, double *COIN_RESTRICT y,
+  const double *rowScale,
+  const double *columnScale) const
+{
+  if (valueType_ == valuesPool) {
+    ClpCompressedPool values = { poolIndex_, elementDouble_ };
+    compressedTimes(numberColumns_, deltaStart_, elementStart_, delta_, values,
+      scalar, x, y, rowScale, columnScale);
+  } else if (valueType_ == valuesFloat) {
+    ClpCompressedFloat values = { elementFloat_ };
+    compressedTimes(numberColumns_, deltaStart_, elementStart_, delta_, values,
+      scalar, x, y, rowScale, columnScale);
+  } else {
+    ClpCompressedDouble values = { elementDouble_ };
+    compressedTimes(numberColumns_, deltaStart_, elementStart_, delta_, values,
+      scalar, x, y, rowScale, columnScale);
+  }
+}
+void ClpCompressedMatrix::transposeTimes(double scalar,
+  const double *COIN_RESTRICT x, double *COIN_RESTRICT y,
+  const double *rowScale,
+  const double *columnScale,
+  double *spare) const
+{
+  const double *COIN_RESTRICT pi = x;
+  double *temp = NULL;
+  if (rowScale) {
+    // scale pi once rather than for every element
+    if (!spare) {
+      temp = new double[numberRows_];
+      spare = temp;
+    }
+    for (int iRow = 0; iRow < numberRows_; iRow++) {
+      double value = x[iRow];
+      if (value)
+        spare[iRow] = value * rowScale[iRow];
+      else
+        spare[iRow] = 0.0;
+    }
+    pi = spare;
+  } else {
+    columnScale = NULL;
+  }
+  if (valueType_ == valuesPool) {
+    ClpCompressedPool values = { poolIndex_, elementDouble_ };
+    compressedTransposeTimes(numberColumns_, deltaStart_, elementStart_, delta_,
+      values, scalar, pi, y, columnScale);
+  } else if (valueType_ == valuesFloat) {
+    ClpCompressedFloat values = { elementFloat_ };
+    compressedTransposeTimes(numberColumns_, deltaStart_, elementStart_, delta_,
+      values, scalar, pi, y, columnScale);
+  } else {
+    ClpCompressedDouble values = { elementDouble_ };
+    compressedTransposeTimes(numberColumns_, deltaStart_, elementStart_, delta_,
+      values, scalar, pi, y, columnScale);
+  }
+  delete[] temp;
+}
+/* Return <code>x * A + y</code> in <code>z</code>.
+   Squashes small elements and knows about ClpSimplex */
+void ClpCompressedMatrix::transposeTimes(const ClpSimplex *model, double scalar,
+  const CoinIndexedVector *rowArray,
+  CoinIndexedVector *y,
+  CoinIndexedVector *columnArray) const
+{
+  columnArray->clear();
+  double *COIN_RESTRICT piOld = rowArray->denseVector();
+  int *COIN_RESTRICT index = columnArray->getIndices();
+  double *COIN_RESTRICT array = columnArray->denseVector();
+  int numberInRowArray = rowArray->getNumElements();
+  double zeroTolerance = model->zeroTolerance();
+  bool packed = rowArray->packedMode();
+  const double *COIN_RESTRICT rowScale = model->rowScale();
+  const double *COIN_RESTRICT columnScale = rowScale ? model->columnScale() : NULL;
+  assert(!y->getNumElements());
+  // need to expand pi into y
+  assert(y->capacity() >= model->numberRows());
+  double *COIN_RESTRICT pi = y->denseVector();
+  const int *COIN_RESTRICT whichRow = rowArray->getIndices();
+  int i;
+  // modify pi so can collapse to one loop
+  for (i = 0; i < numberInRowArray; i++) {
+    int iRow = whichRow[i];
+    double value = packed ? piOld[i] : piOld[iRow];
+    if (rowScale)
+      value *= rowScale[iRow];
+    pi[iRow] = scalar * value;
+  }
+  int numberNonZero;
+  if (valueType_ == valuesPool) {
+    ClpCompressedPool values = { poolIndex_, elementDouble_ };
+    numberNonZero = compressedTransposeTimes(numberColumns_, deltaStart_,
+      elementStart_, delta_, values, pi, zeroTolerance, columnScale,
+      packed, index, array);
+  } else if (valueType_ == valuesFloat) {
+    ClpCompressedFloat values = { elementFloat_ };
+    numberNonZero = compressedTransposeTimes(numberColumns_, deltaStart_,
+      elementStart_, delta_, values, pi, zeroTolerance, columnScale,
+      packed, index, array);
+  } else {
+    ClpCompressedDouble values = { elementDouble_ };
+    numberNonZero = compressedTransposeTimes(numberColumns_, deltaStart_,
+      elementStart_, delta_, values, pi, zeroTolerance, columnScale,
+      packed, index, array);
+  }
+  // zero out
+  int numberRows = model->numberRows();
+  if (numberInRowArray * 4 < numberRows) {
+    for (i = 0; i < numberInRowArray; i++) {
+      int iRow = whichRow[i];
+      pi[iRow] = 0.0;
+    }
+  } else {
+    CoinZeroN(pi, numberRows);
+  }
+  columnArray->setNumElements(numberNonZero);
+  y->setNumElements(0);
+  if (packed)
+    columnArray->setPackedMode(true);
+}
+/* Return <code>x *A in <code>z</code> but
+   just for indices in y. */
+void ClpCompressedMatrix::subsetTransposeTimes(const ClpSimplex *model,
+  const CoinIndexedVector *rowArray,
+  const CoinIndexedVector *y,
+  CoinIndexedVector *columnArray) const
+{
+  columnArray->clear();
+  const double *COIN_RESTRICT pi = rowArray->denseVector();
+  double *COIN_RESTRICT array = columnArray->denseVector();
+  const double *COIN_RESTRICT rowScale = model->rowScale();
+  const double *COIN_RESTRICT columnScale = model->columnScale();
+  int numberToDo = y->getNumElements();
+  const int *COIN_RESTRICT which = y->getIndices();
+  assert(!rowArray->packedMode());
+  columnArray->setPacked();
+  if (valueType_ == valuesPool) {
+    ClpCompressedPool values = { poolIndex_, elementDouble_ };
+    compressedSubsetTransposeTimes(deltaStart_, elementStart_, delta_, values,
+      pi, rowScale, columnScale, numberToDo, which, array);
+  } else if (valueType_ == valuesFloat) {
+    ClpCompressedFloat values = { elementFloat_ };
+    compressedSubsetTransposeTimes(deltaStart_, elementStart_, delta_, values,
+      pi, rowScale, columnScale, numberToDo, which, array);
+  } else {
+    ClpCompressedDouble values = { elementDouble_ };
+    compressedSubsetTransposeTimes(deltaStart_, elementStart_, delta_, values,
+      pi, rowScale, columnScale, numberToDo, which, array);
+  }
+}
+/// returns number of elements in column part of basis,
+int ClpCompressedMatrix::countBasis(const int *whichColumn,
+  int &numberColumnBasic)
+{
+  int i;
+  CoinBigIndex numberElements = 0;
+  for (i = 0; i < numberColumnBasic; i++) {
+    int iColumn = whichColumn[i];
+    numberElements += elementStart_[iColumn + 1] - elementStart_[iColumn];
+  }
+  if (numberElements > COIN_INT_MAX) {
+    printf("Factorization too large\n");
+    abort();
+  }
+  return static_cast< int >(numberElements);
+}
+void ClpCompressedMatrix::fillBasis(ClpSimplex *,
+  const int *whichColumn,
+  int &numberColumnBasic,
+  int *indexRowU, int *start,
+  int *rowCount, int *columnCount,
+  CoinFactorizationDouble *elementU)
+{
+  CoinBigIndex numberElements = start[0];
+  for (int i = 0; i < numberColumnBasic; i++) {
+    int iColumn = whichColumn[i];
+    CoinBigIndex p = deltaStart_[iColumn];
+    int iRow = 0;
+    for (CoinBigIndex j = elementStart_[iColumn]; j < elementStart_[iColumn + 1]; j++) {
+      iRow = nextRow(delta_, p, iRow);
+      indexRowU[numberElements] = iRow;
+      rowCount[iRow]++;
+      elementU[numberElements++] = elementValue(j);
+    }
+    start[i + 1] = static_cast< int >(numberElements);
+    columnCount[i] = static_cast< int >(numberElements - start[i]);
+  }
+  if (numberElements > COIN_INT_MAX) {
+    printf("Factorization too large\n");
+    abort();
+  }
+}
+/* Unpacks a column into an CoinIndexedvector
+ */
+void ClpCompressedMatrix::unpack(const ClpSimplex *,
+  CoinIndexedVector *rowArray,
+  int iColumn) const
+{
+  CoinBigIndex p = deltaStart_[iColumn];
+  int iRow = 0;
+  for (CoinBigIndex j = elementStart_[iColumn]; j < elementStart_[iColumn + 1]; j++) {
+    iRow = nextRow(delta_, p, iRow);
+    rowArray->add(iRow, elementValue(j));
+  }
+}
+/* Unpacks a column into an CoinIndexedvector
+** in packed foramt
+Note that model is NOT const.  Bounds and objective could
+be modified if doing column generation (just for this variable) */
+void ClpCompressedMatrix::unpackPacked(ClpSimplex *,
+  CoinIndexedVector *rowArray,
+  int iColumn) const
+{
+  int *COIN_RESTRICT index = rowArray->getIndices();
+  double *COIN_RESTRICT array = rowArray->denseVector();
+  int number = 0;
+  CoinBigIndex p = deltaStart_[iColumn];
+  int iRow = 0;
+  for (CoinBigIndex j = elementStart_[iColumn]; j < elementStart_[iColumn + 1]; j++) {
+    iRow = nextRow(delta_, p, iRow);
+    array[number] = elementValue(j);
+    index[number++] = iRow;
+  }
+  rowArray->setNumElements(number);
+  rowArray->setPackedMode(true);
+}
+/* Adds multiple of a column into an CoinIndexedvector
+   You can use quickAdd to add to vector */
+void ClpCompressedMatrix::add(const ClpSimplex *, CoinIndexedVector *rowArray,
+  int iColumn, double multiplier) const
+{
+  CoinBigIndex p = deltaStart_[iColumn];
+  int iRow = 0;
+  for (CoinBigIndex j = elementStart_[iColumn]; j < elementStart_[iColumn + 1]; j++) {
+    iRow = nextRow(delta_, p, iRow);
+    rowArray->quickAdd(iRow, multiplier * elementValue(j));
+  }
+}
+/* Adds multiple of a column into an array */
+void ClpCompressedMatrix::add(const ClpSimplex *, double *array,
+  int iColumn, double multiplier) const
+{
+  CoinBigIndex p = deltaStart_[iColumn];
+  int iRow = 0;
+  for (CoinBigIndex j = elementStart_[iColumn]; j < elementStart_[iColumn + 1]; j++) {
+    iRow = nextRow(delta_, p, iRow);
+    array[iRow] += multiplier * elementValue(j);
+  }
+}
+
+// Return a complete CoinPackedMatrix
+CoinPackedMatrix *
+ClpCompressedMatrix::getPackedMatrix() const
+{
+  createMatrix();
+  return matrix_->matrix();
+}
+/* A vector containing the elements in the packed matrix. */
+const double *
+ClpCompressedMatrix::getElements() const
+{
+#ifdef CLP_INVESTIGATE
+  printf("createMatrix at file %s line %d\n", __FILE__, __LINE__);
+#endif
+  return createMatrix()->getElements();
+}
+
+/* A vector containing the minor indices of the elements in the packed
+   matrix. */
+const int *
+ClpCompressedMatrix::getIndices() const
+{
+#ifdef CLP_INVESTIGATE
+  printf("createMatrix at file %s line %d\n", __FILE__, __LINE__);
+#endif
+  return createMatrix()->getIndices();
+}
+const CoinBigIndex *
+ClpCompressedMatrix::getVectorStarts() const
+{
+  // same as elementStart_ as no gaps
+  return elementStart_;
+}
+/* The lengths of the major-dimension vectors. */
+const int *
+ClpCompressedMatrix::getVectorLengths() const
+{
+  if (!lengths_) {
+    lengths_ = new int[numberColumns_];
+    for (int i = 0; i < numberColumns_; i++)
+      lengths_[i] = static_cast< int >(elementStart_[i + 1] - elementStart_[i]);
+  }
+  return lengths_;
+}
+/* The length of a major-dimension vector. */
+int ClpCompressedMatrix::getVectorLength(int index) const
+{
+  return static_cast< int >(elementStart_[index + 1] - elementStart_[index]);
+}
+/* Delete the columns whose indices are listed in <code>indDel</code>. */
+void ClpCompressedMatrix::deleteCols(const int numDel, const int *indDel)
+{
+  // not time critical so do on packed matrix and encode again
+  ClpPackedMatrix *matrix = createMatrix();
+  matrix_ = NULL;
+  matrix->deleteCols(numDel, indDel);
+  bool compressValues = valueType_ != valuesDouble;
+  gutsOfDelete();
+  gutsOfCreate(*matrix->matrix(), compressValues);
+  delete matrix;
+}
+/* Delete the rows whose indices are listed in <code>indDel</code>. */
+void ClpCompressedMatrix::deleteRows(const int numDel, const int *indDel)
+{
+  ClpPackedMatrix *matrix = createMatrix();
+  matrix_ = NULL;
+  matrix->deleteRows(numDel, indDel);
+  bool compressValues = valueType_ != valuesDouble;
+  gutsOfDelete();
+  gutsOfCreate(*matrix->matrix(), compressValues);
+  delete matrix;
+}
+/* Number of entries in the packed matrix. */
+CoinBigIndex
+ClpCompressedMatrix::getNumElements() const
+{
+  return elementStart_[numberColumns_];
+}
+// Bytes used for rows and values
+CoinBigIndex
+ClpCompressedMatrix::compressedBytes() const
+{
+  CoinBigIndex numberElements = elementStart_[numberColumns_];
+  CoinBigIndex bytes = deltaStart_[numberColumns_] * static_cast< CoinBigIndex >(sizeof(unsigned short));
+  if (valueType_ == valuesPool)
+    bytes += numberElements * static_cast< CoinBigIndex >(sizeof(unsigned short))
+      + numberDifferent_ * static_cast< CoinBigIndex >(sizeof(double));
+  else if (valueType_ == valuesFloat)
+    bytes += numberElements * static_cast< CoinBigIndex >(sizeof(float));
+  else
+    bytes += numberElements * static_cast< CoinBigIndex >(sizeof(double));
+  return bytes;
+}
+/* Returns largest and smallest elements of both signs.
+   Largest refers to largest absolute value.
+*/
+void ClpCompressedMatrix::rangeOfElements(double &smallestNegative, double &largestNegative,
+  double &smallestPositive, double &largestPositive)
+{
+  smallestNegative = -COIN_DBL_MAX;
+  largestNegative = 0.0;
+  smallestPositive = COIN_DBL_MAX;
+  largestPositive = 0.0;
+  CoinBigIndex number = (valueType_ == valuesPool) ? numberDifferent_ : elementStart_[numberColumns_];
+  for (CoinBigIndex i = 0; i < number; i++) {
+    double value = (valueType_ == valuesFloat) ? elementFloat_[i] : elementDouble_[i];
+    if (value > 0.0) {
+      smallestPositive = CoinMin(smallestPositive, value);
+      largestPositive = CoinMax(largestPositive, value);
+    } else if (value < 0.0) {
+      smallestNegative = CoinMax(smallestNegative, value);
+      largestNegative = CoinMin(largestNegative, value);
+    }
+  }
+}
+// Allow any parts of a created CoinMatrix to be deleted
+void ClpCompressedMatrix::releasePackedMatrix() const
+{
+  delete matrix_;
+  matrix_ = NULL;
+}
+/* Set the dimensions of the matrix. In effect, append new empty
+   columns/rows to the matrix. A negative number for either dimension
+   means that that dimension doesn't change. Otherwise the new dimensions
+   MUST be at least as large as the current ones otherwise an exception
+   is thrown. */
+void ClpCompressedMatrix::setDimensions(int newnumrows, int newnumcols)
+{
+  if (newnumrows < 0)
+    newnumrows = numberRows_;
+  if (newnumcols < 0)
+    newnumcols = numberColumns_;
+  if (newnumrows < numberRows_ || newnumcols < numberColumns_)
+    throw CoinError("Bad new dimensions", "setDimensions", "ClpCompressedMatrix");
+  releasePackedMatrix();
+  delete[] lengths_;
+  lengths_ = NULL;
+  numberRows_ = newnumrows;
+  if (newnumcols > numberColumns_) {
+    CoinBigIndex *deltaStart = new CoinBigIndex[newnumcols + 1];
+    CoinBigIndex *elementStart = new CoinBigIndex[newnumcols + 1];
+    CoinMemcpyN(deltaStart_, numberColumns_ + 1, deltaStart);
+    CoinMemcpyN(elementStart_, numberColumns_ + 1, elementStart);
+    for (int i = numberColumns_ + 1; i <= newnumcols; i++) {
+      deltaStart[i] = deltaStart_[numberColumns_];
+      elementStart[i] = elementStart_[numberColumns_];
+    }
+    delete[] deltaStart_;
+    deltaStart_ = deltaStart;
+    delete[] elementStart_;
+    elementStart_ = elementStart;
+    numberColumns_ = newnumcols;
+  }
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
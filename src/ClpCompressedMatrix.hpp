@@ -0,0 +1,250 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef ClpCompressedMatrix_H
+#define ClpCompressedMatrix_H
+
+#include "CoinPragma.hpp"
+
+#include "ClpMatrixBase.hpp"
+class ClpPackedMatrix;
+
+/** This implements a compressed column matrix as derived from ClpMatrixBase.
+
+    Meant for very large models where pricing is limited by memory
+    bandwidth.  Rows in each column are sorted and stored as 16 bit
+    deltas (a delta which does not fit is an escape followed by full
+    row as two shorts).  Values are stored as a pool of different
+    values with 16 bit index if there are few enough, otherwise as
+    floats if all values are exactly floats, otherwise as doubles.
+    So typically 4 or 6 bytes per element rather than 12.
+
+    Like ClpPoolMatrix there is no row copy and matrix is not scaled.
+    Anything unusual is done on a ClpPackedMatrix created on demand.
+*/
+
+class CLPLIB_EXPORT ClpCompressedMatrix : public ClpMatrixBase {
+
+public:
+  /// How values are stored
+  enum ValueType {
+    valuesDouble = 0,
+    valuesFloat,
+    valuesPool
+  };
+  /**@name Useful methods */
+  //@{
+  /// Return a complete CoinPackedMatrix
+  virtual CoinPackedMatrix *getPackedMatrix() const;
+  /** Whether the packed matrix is column major ordered or not. */
+  virtual bool isColOrdered() const
+  {
+    return true;
+  }
+  /** Number of entries in the packed matrix. */
+  virtual CoinBigIndex getNumElements() const;
+  /** Number of columns. */
+  virtual int getNumCols() const
+  {
+    return numberColumns_;
+  }
+  /** Number of rows. */
+  virtual int getNumRows() const
+  {
+    return numberRows_;
+  }
+
+  /** A vector containing the elements in the packed matrix.
+      These (and indices and starts) come from a created ClpPackedMatrix */
+  virtual const double *getElements() const;
+  /** A vector containing the minor indices of the elements in the packed
+      matrix. */
+  virtual const int *getIndices() const;
+  virtual const CoinBigIndex *getVectorStarts() const;
+  /** The lengths of the major-dimension vectors. */
+  virtual const int *getVectorLengths() const;
+  /** The length of a major-dimension vector. */
+  virtual int getVectorLength(int index) const;
+  /** Delete the columns whose indices are listed in <code>indDel</code>. */
+  virtual void deleteCols(const int numDel, const int *indDel);
+  /** Delete the rows whose indices are listed in <code>indDel</code>. */
+  virtual void deleteRows(const int numDel, const int *indDel);
+  /** Returns a new matrix in reverse order without gaps
+      (NULL as no row copy wanted) */
+  virtual ClpMatrixBase *reverseOrderedCopy() const;
+  /// Returns number of elements in column part of basis
+  virtual int countBasis(
+    const int *whichColumn,
+    int &numberColumnBasic);
+  /// Fills in column part of basis
+  virtual void fillBasis(ClpSimplex *model,
+    const int *whichColumn,
+    int &numberColumnBasic,
+    int *row, int *start,
+    int *rowCount, int *columnCount,
+    CoinFactorizationDouble *element);
+  /** Returns largest and smallest elements of both signs.
+         Largest refers to largest absolute value.
+     */
+  virtual void rangeOfElements(double &smallestNegative, double &largestNegative,
+    double &smallestPositive, double &largestPositive);
+  /** Unpacks a column into an CoinIndexedvector
+      */
+  virtual void unpack(const ClpSimplex *model, CoinIndexedVector *rowArray,
+    int column) const;
+  /** Unpacks a column into an CoinIndexedvector
+      ** in packed format */
+  virtual void unpackPacked(ClpSimplex *model,
+    CoinIndexedVector *rowArray,
+    int column) const;
+  /** Adds multiple of a column into an CoinIndexedvector
+         You can use quickAdd to add to vector */
+  virtual void add(const ClpSimplex *model, CoinIndexedVector *rowArray,
+    int column, double multiplier) const;
+  /** Adds multiple of a column into an array */
+  virtual void add(const ClpSimplex *model, double *array,
+    int column, double multiplier) const;
+  /// Allow any parts of a created CoinMatrix to be deleted
+  virtual void releasePackedMatrix() const;
+  /** Set the dimensions of the matrix. In effect, append new empty
+         columns/rows to the matrix. A negative number for either dimension
+         means that that dimension doesn't change. Otherwise the new dimensions
+         MUST be at least as large as the current ones otherwise an exception
+         is thrown. */
+  virtual void setDimensions(int numrows, int numcols);
+  //@}
+
+  /**@name Matrix times vector methods */
+  //@{
+  /** Return <code>y + A * scalar *x</code> in <code>y</code>.
+         @pre <code>x</code> must be of size <code>numColumns()</code>
+         @pre <code>y</code> must be of size <code>numRows()</code> */
+  virtual void times(double scalar,
+    const double *x, double *y) const;
+  /// And for scaling
+  virtual void times(double scalar,
+    const double *x, double *y,
+    const double *rowScale,
+    const double *columnScale) const;
+  /** Return <code>y + x * scalar * A</code> in <code>y</code>.
+         @pre <code>x</code> must be of size <code>numRows()</code>
+         @pre <code>y</code> must be of size <code>numColumns()</code> */
+  virtual void transposeTimes(double scalar,
+    const double *x, double *y) const;
+  /// And for scaling
+  virtual void transposeTimes(double scalar,
+    const double *x, double *y,
+    const double *rowScale,
+    const double *columnScale, double *spare = NULL) const;
+  /** Return <code>x * scalar * A + y</code> in <code>z</code>.
+     Can use y as temporary array (will be empty at end)
+     Note - If x packed mode - then z packed mode
+     Squashes small elements and knows about ClpSimplex */
+  virtual void transposeTimes(const ClpSimplex *model, double scalar,
+    const CoinIndexedVector *x,
+    CoinIndexedVector *y,
+    CoinIndexedVector *z) const;
+  /** Return <code>x *A</code> in <code>z</code> but
+     just for indices in y.
+     Note - z always packed mode */
+  virtual void subsetTransposeTimes(const ClpSimplex *model,
+    const CoinIndexedVector *x,
+    const CoinIndexedVector *y,
+    CoinIndexedVector *z) const;
+  //@}
+
+  /**@name Other */
+  //@{
+  /// How values are stored
+  inline ValueType valueType() const
+  {
+    return valueType_;
+  }
+  /// Number of different values (if pooled)
+  inline int numberDifferent() const
+  {
+    return numberDifferent_;
+  }
+  /// Bytes used for rows and values (for comparison with 12 per element)
+  CoinBigIndex compressedBytes() const;
+  //@}
+
+  /**@name Constructors, destructor */
+  //@{
+  /** Default constructor. */
+  ClpCompressedMatrix();
+  /** Destructor */
+  virtual ~ClpCompressedMatrix();
+  //@}
+
+  /**@name Copy method */
+  //@{
+  /** The copy constructor. */
+  ClpCompressedMatrix(const ClpCompressedMatrix &);
+  /** The copy constructor from a CoinPackedMatrix.
+      If compressValues false then values are kept as doubles */
+  ClpCompressedMatrix(const CoinPackedMatrix &, bool compressValues = true);
+
+  ClpCompressedMatrix &operator=(const ClpCompressedMatrix &);
+  /// Clone
+  virtual ClpMatrixBase *clone() const;
+  /** Subset clone (without gaps).  Duplicates are allowed
+         and order is as given */
+  virtual ClpMatrixBase *subsetClone(
+    int numberRows, const int *whichRows,
+    int numberColumns, const int *whichColumns) const;
+  //@}
+
+protected:
+  /// Create matrix_
+  ClpPackedMatrix *createMatrix() const;
+  /// Encode from a column ordered CoinPackedMatrix (arrays must be free)
+  void gutsOfCreate(const CoinPackedMatrix &matrix, bool compressValues);
+  /// Copy from another
+  void gutsOfCopy(const ClpCompressedMatrix &rhs);
+  /// Free arrays
+  void gutsOfDelete();
+  /// Value of element k (not for use in time critical loops)
+  inline double elementValue(CoinBigIndex k) const
+  {
+    if (valueType_ == valuesPool)
+      return elementDouble_[poolIndex_[k]];
+    else if (valueType_ == valuesFloat)
+      return elementFloat_[k];
+    else
+      return elementDouble_[k];
+  }
+  /**@name Data members
+        The data members are protected to allow access for derived classes. */
+  //@{
+  /// For fake ClpPackedMatrix
+  mutable ClpPackedMatrix *matrix_;
+  /// Lengths (created if asked for)
+  mutable int *lengths_;
+  /// Start of each column in delta_
+  CoinBigIndex *deltaStart_;
+  /// Start of each column in values
+  CoinBigIndex *elementStart_;
+  /// Row deltas (0xffff escape then row as low,high shorts)
+  unsigned short *delta_;
+  /// Values if doubles (or pool of different values)
+  double *elementDouble_;
+  /// Values if floats
+  float *elementFloat_;
+  /// Index into pool if pooled
+  unsigned short *poolIndex_;
+  /// Number of rows
+  int numberRows_;
+  /// Number of columns
+  int numberColumns_;
+  /// Number of different values (if pooled)
+  int numberDifferent_;
+  /// How values are stored
+  ValueType valueType_;
+  //@}
+};
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -72,7 +72,9 @@ public:
     beforeCreateNonLinear,
     afterCreateNonLinear,
     startOfCrossover, // in Idiot
-    noTheta // At end (because no pivot)
+    noTheta, // At end (because no pivot)
+    parametricsBreakpoint, // eventWithInfo - info is ClpParametricsBreakpoint
+    parametricsStart // eventWithInfo - start of a parametrics run (info NULL)
   };
   /**@name Virtual method that the derived classes should provide.
       The base class instance does nothing and as event() is only useful method
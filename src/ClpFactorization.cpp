@@ -18,6 +18,7 @@
 #include "ClpMatrixBase.hpp"
 #ifndef SLIM_CLP
 #include "ClpNetworkBasis.hpp"
+#include "ClpBlockBasis.hpp"
 #include "ClpNetworkMatrix.hpp"
 //#define CHECK_NETWORK
 #ifdef CHECK_NETWORK
@@ -1161,6 +1162,11 @@ ClpFactorization::ClpFactorization()
 {
 #ifndef SLIM_CLP
   networkBasis_ = NULL;
+  blockBasis_ = NULL;
+  sideRow_ = NULL;
+  sideRowLength_ = -1;
+  sideRowColumns_ = -1;
+  sideRowElements_ = -1;
 #endif
   //coinFactorizationA_ = NULL;
   coinFactorizationA_ = new CoinFactorization();
@@ -1172,6 +1178,11 @@ ClpFactorization::ClpFactorization()
   goSmallThreshold_ = -1;
   doStatistics_ = true;
   memset(&shortestAverage_, 0, 3 * (sizeof(double) + sizeof(int)));
+  sparseStatisticsLevel_ = 0;
+  blockTriangular_ = 0;
+  embeddedNetwork_ = 0;
+  adaptiveSparse_ = false;
+  resetSparseStatistics();
 }
 
 //-------------------------------------------------------------------
@@ -1188,6 +1199,11 @@ ClpFactorization::ClpFactorization(const ClpFactorization &rhs,
     networkBasis_ = new ClpNetworkBasis(*(rhs.networkBasis_));
   else
     networkBasis_ = NULL;
+  blockBasis_ = NULL;
+  sideRowLength_ = rhs.sideRowLength_;
+  sideRowColumns_ = rhs.sideRowColumns_;
+  sideRowElements_ = rhs.sideRowElements_;
+  sideRow_ = CoinCopyOfArray(rhs.sideRow_, CoinMax(sideRowLength_, 0));
 #endif
   forceB_ = rhs.forceB_;
   goOslThreshold_ = rhs.goOslThreshold_;
@@ -1224,6 +1240,10 @@ ClpFactorization::ClpFactorization(const ClpFactorization &rhs,
     coinFactorizationA_ = new CoinFactorization(*(rhs.coinFactorizationA_));
   else
     coinFactorizationA_ = NULL;
+#ifndef SLIM_CLP
+  if (rhs.blockBasis_ && coinFactorizationA_)
+    blockBasis_ = new ClpBlockBasis(*(rhs.blockBasis_));
+#endif
   if (rhs.coinFactorizationB_ && (denseIfSmaller >= 0 || !goDense))
     coinFactorizationB_ = rhs.coinFactorizationB_->clone();
   else
@@ -1254,6 +1274,11 @@ ClpFactorization::ClpFactorization(const ClpFactorization &rhs,
   factorization_instrument(1);
 #endif
   memcpy(&shortestAverage_, &rhs.shortestAverage_, 3 * (sizeof(double) + sizeof(int)));
+  sparseStatistics_ = rhs.sparseStatistics_;
+  sparseStatisticsLevel_ = rhs.sparseStatisticsLevel_;
+  blockTriangular_ = rhs.blockTriangular_;
+  embeddedNetwork_ = rhs.embeddedNetwork_;
+  adaptiveSparse_ = rhs.adaptiveSparse_;
 }
 
 ClpFactorization::ClpFactorization(const CoinFactorization &rhs)
@@ -1263,6 +1288,11 @@ ClpFactorization::ClpFactorization(const CoinFactorization &rhs)
 #endif
 #ifndef SLIM_CLP
   networkBasis_ = NULL;
+  blockBasis_ = NULL;
+  sideRow_ = NULL;
+  sideRowLength_ = -1;
+  sideRowColumns_ = -1;
+  sideRowElements_ = -1;
 #endif
   coinFactorizationA_ = new CoinFactorization(rhs);
   coinFactorizationB_ = NULL;
@@ -1276,6 +1306,11 @@ ClpFactorization::ClpFactorization(const CoinFactorization &rhs)
   doStatistics_ = true;
   assert(!coinFactorizationA_ || !coinFactorizationB_);
   memset(&shortestAverage_, 0, 3 * (sizeof(double) + sizeof(int)));
+  sparseStatisticsLevel_ = 0;
+  blockTriangular_ = 0;
+  embeddedNetwork_ = 0;
+  adaptiveSparse_ = false;
+  resetSparseStatistics();
 }
 
 ClpFactorization::ClpFactorization(const CoinOtherFactorization &rhs)
@@ -1285,6 +1320,11 @@ ClpFactorization::ClpFactorization(const CoinOtherFactorization &rhs)
 #endif
 #ifndef SLIM_CLP
   networkBasis_ = NULL;
+  blockBasis_ = NULL;
+  sideRow_ = NULL;
+  sideRowLength_ = -1;
+  sideRowColumns_ = -1;
+  sideRowElements_ = -1;
 #endif
   coinFactorizationA_ = NULL;
   coinFactorizationB_ = rhs.clone();
@@ -1299,6 +1339,11 @@ ClpFactorization::ClpFactorization(const CoinOtherFactorization &rhs)
 #endif
   assert(!coinFactorizationA_ || !coinFactorizationB_);
   memset(&shortestAverage_, 0, 3 * (sizeof(double) + sizeof(int)));
+  sparseStatisticsLevel_ = 0;
+  blockTriangular_ = 0;
+  embeddedNetwork_ = 0;
+  adaptiveSparse_ = false;
+  resetSparseStatistics();
 }
 
 //-------------------------------------------------------------------
@@ -1308,6 +1353,8 @@ ClpFactorization::~ClpFactorization()
 {
 #ifndef SLIM_CLP
   delete networkBasis_;
+  delete blockBasis_;
+  delete[] sideRow_;
 #endif
   delete coinFactorizationA_;
   delete coinFactorizationB_;
@@ -1329,6 +1376,16 @@ ClpFactorization::operator=(const ClpFactorization &rhs)
       networkBasis_ = new ClpNetworkBasis(*(rhs.networkBasis_));
     else
       networkBasis_ = NULL;
+    delete blockBasis_;
+    if (rhs.blockBasis_)
+      blockBasis_ = new ClpBlockBasis(*(rhs.blockBasis_));
+    else
+      blockBasis_ = NULL;
+    delete[] sideRow_;
+    sideRowLength_ = rhs.sideRowLength_;
+    sideRowColumns_ = rhs.sideRowColumns_;
+    sideRowElements_ = rhs.sideRowElements_;
+    sideRow_ = CoinCopyOfArray(rhs.sideRow_, CoinMax(sideRowLength_, 0));
 #endif
     forceB_ = rhs.forceB_;
 #ifdef CLP_REUSE_ETAS
@@ -1339,6 +1396,11 @@ ClpFactorization::operator=(const ClpFactorization &rhs)
     goSmallThreshold_ = rhs.goSmallThreshold_;
     doStatistics_ = rhs.doStatistics_;
     memcpy(&shortestAverage_, &rhs.shortestAverage_, 3 * (sizeof(double) + sizeof(int)));
+    sparseStatistics_ = rhs.sparseStatistics_;
+    sparseStatisticsLevel_ = rhs.sparseStatisticsLevel_;
+    blockTriangular_ = rhs.blockTriangular_;
+    embeddedNetwork_ = rhs.embeddedNetwork_;
+    adaptiveSparse_ = rhs.adaptiveSparse_;
     if (rhs.coinFactorizationA_) {
       if (coinFactorizationA_)
         *coinFactorizationA_ = *(rhs.coinFactorizationA_);
@@ -1523,6 +1585,12 @@ static double weightNrowsIterate = 3.0;
 #endif
 bool ClpFactorization::timeToRefactorize() const
 {
+#ifndef SLIM_CLP
+  if (blockBasis_) {
+    // product form updates - refactorize when they get as big as factors
+    return blockBasis_->numberEtaElements() > blockBasis_->numberElements() + 10 * blockBasis_->numberEtas();
+  }
+#endif
   if (coinFactorizationA_) {
     bool reFactor = (coinFactorizationA_->pivots() * 3 > coinFactorizationA_->maximumPivots() * 2 && coinFactorizationA_->numberElementsR() * 3 > (coinFactorizationA_->numberElementsL() + coinFactorizationA_->numberElementsU()) * 2 + 1000 && !coinFactorizationA_->numberDense());
     reFactor = false;
@@ -1640,6 +1708,12 @@ void ClpFactorization::statsRefactor(char when) const
 #else
 bool ClpFactorization::timeToRefactorize() const
 {
+#ifndef SLIM_CLP
+  if (blockBasis_) {
+    // product form updates - refactorize when they get as big as factors
+    return blockBasis_->numberEtaElements() > blockBasis_->numberElements() + 10 * blockBasis_->numberEtas();
+  }
+#endif
   if (coinFactorizationA_) {
     return (coinFactorizationA_->pivots() * 3 > coinFactorizationA_->maximumPivots() * 2 && coinFactorizationA_->numberElementsR() * 3 > (coinFactorizationA_->numberElementsL() + coinFactorizationA_->numberElementsU()) * 2 + 1000 && !coinFactorizationA_->numberDense());
   } else {
@@ -2195,6 +2269,50 @@ scaledDense,scaledDense_2,scaledL,scaledR,scaledU\n");
       networkBasis_ = NULL;
       if (networkMatrix && !doCheck)
         maximumPivots(1);
+      delete blockBasis_;
+      blockBasis_ = NULL;
+      if ((blockTriangular_ || embeddedNetwork_) && !networkMatrix
+        && numberBasic == numberRows && matrix->type() == 1
+        && model->algorithm() != 2) {
+        if (embeddedNetwork_ && (sideRowLength_ != numberRows
+              || sideRowColumns_ != model->numberColumns()
+              || sideRowElements_ != matrix->getNumElements())) {
+          // find network rows (once per matrix) - rest are side rows
+          delete[] sideRow_;
+          sideRow_ = new char[numberRows];
+          if (model->findNetwork(sideRow_)) {
+            for (i = 0; i < numberRows; i++)
+              sideRow_[i] = static_cast< char >(sideRow_[i] < 0 ? 1 : 0);
+          } else {
+            delete[] sideRow_;
+            sideRow_ = NULL;
+          }
+          sideRowLength_ = numberRows;
+          sideRowColumns_ = model->numberColumns();
+          sideRowElements_ = matrix->getNumElements();
+        }
+        // try block triangular form with small diagonal blocks (or tree)
+        blockBasis_ = new ClpBlockBasis();
+        int returnCode = 1;
+        if (!embeddedNetwork_)
+          returnCode = blockBasis_->factorize(model, pivotTemp, numberRowBasic,
+            blockTriangular_, coinFactorizationA_->zeroTolerance());
+        else if (sideRow_)
+          returnCode = blockBasis_->factorize(model, pivotTemp, numberRowBasic,
+            CoinMax(blockTriangular_, 1), coinFactorizationA_->zeroTolerance(),
+            sideRow_, embeddedNetwork_);
+        if (!returnCode) {
+          // pivotVariable set - kill off arrays in ordinary factorization
+          coinFactorizationA_->gutsOfDestructor();
+          coinFactorizationA_->setNumberRows(numberRows);
+          coinFactorizationA_->setStatus(0);
+          coinFactorizationA_->setPivots(0);
+          continue;
+        }
+        // too big or singular - do as normal
+        delete blockBasis_;
+        blockBasis_ = NULL;
+      }
 #endif
       //printf("L, U, R %d %d %d\n",numberElementsL(),numberElementsU(),numberElementsR());
       while (coinFactorizationA_->status() == -99) {
@@ -2569,6 +2687,8 @@ scaledDense,scaledDense_2,scaledL,scaledR,scaledU\n");
     }
   }
 #endif
+  if (adaptiveSparse_ && !coinFactorizationA_->status())
+    adaptSparse();
 #ifdef CLP_FACTORIZATION_INSTRUMENT
   factorization_instrument(2);
 #endif
@@ -2590,6 +2710,11 @@ int ClpFactorization::replaceColumn(const ClpSimplex *model,
   double acceptablePivot)
 {
 #ifndef SLIM_CLP
+  if (blockBasis_) {
+    // increase number of pivots
+    coinFactorizationA_->setPivots(coinFactorizationA_->pivots() + 1);
+    return blockBasis_->replaceColumn(tableauColumn, pivotRow, pivotCheck);
+  }
   if (!networkBasis_) {
 #endif
 #ifdef CLP_FACTORIZATION_NEW_TIMING
@@ -2729,6 +2854,10 @@ int ClpFactorization::updateColumnFT(CoinIndexedVector *regionSparse,
   if (!numberRows())
     return 0;
 #ifndef SLIM_CLP
+  if (blockBasis_) {
+    blockBasis_->updateColumn(regionSparse, regionSparse2);
+    return 1;
+  }
   if (!networkBasis_) {
 #endif
 #ifdef CLP_FACTORIZATION_INSTRUMENT
@@ -2736,10 +2865,14 @@ int ClpFactorization::updateColumnFT(CoinIndexedVector *regionSparse,
 #endif
     int returnCode;
     if (coinFactorizationA_) {
+      double startTime = (sparseStatisticsLevel_ > 1) ? CoinGetTimeOfDay() : 0.0;
       coinFactorizationA_->setCollectStatistics(true);
       returnCode = coinFactorizationA_->updateColumnFT(regionSparse,
         regionSparse2);
       coinFactorizationA_->setCollectStatistics(false);
+      if (sparseStatisticsLevel_ || adaptiveSparse_)
+        addSparseStatistics(1, regionSparse2->getNumElements(),
+          startTime ? CoinGetTimeOfDay() - startTime : 0.0);
     } else {
 #ifdef CLP_REUSE_ETAS
       int tempInfo[2];
@@ -2811,6 +2944,8 @@ int ClpFactorization::updateColumn(CoinIndexedVector *regionSparse,
   if (!numberRows())
     return 0;
 #ifndef SLIM_CLP
+  if (blockBasis_)
+    return blockBasis_->updateColumn(regionSparse, regionSparse2);
   if (!networkBasis_) {
 #endif
 #ifdef CLP_FACTORIZATION_INSTRUMENT
@@ -2818,11 +2953,15 @@ int ClpFactorization::updateColumn(CoinIndexedVector *regionSparse,
 #endif
     int returnCode;
     if (coinFactorizationA_) {
+      double startTime = (sparseStatisticsLevel_ > 1) ? CoinGetTimeOfDay() : 0.0;
       coinFactorizationA_->setCollectStatistics(doStatistics_);
       returnCode = coinFactorizationA_->updateColumn(regionSparse,
         regionSparse2,
         noPermute);
       coinFactorizationA_->setCollectStatistics(false);
+      if (sparseStatisticsLevel_ || adaptiveSparse_)
+        addSparseStatistics(0, regionSparse2->getNumElements(),
+          startTime ? CoinGetTimeOfDay() - startTime : 0.0);
     } else {
       returnCode = coinFactorizationB_->updateColumn(regionSparse,
         regionSparse2,
@@ -2898,12 +3037,13 @@ int ClpFactorization::updateTwoColumnsFT(CoinIndexedVector *regionSparse1,
     return 0;
   int returnCode = 0;
 #ifndef SLIM_CLP
-  if (!networkBasis_) {
+  if (!networkBasis_ && !blockBasis_) {
 #endif
 #ifdef CLP_FACTORIZATION_INSTRUMENT
     factorization_instrument(-1);
 #endif
     if (coinFactorizationA_) {
+      double startTime = (sparseStatisticsLevel_ > 1) ? CoinGetTimeOfDay() : 0.0;
       coinFactorizationA_->setCollectStatistics(true);
       if (coinFactorizationA_->spaceForForrestTomlin()) {
         assert(regionSparse2->packedMode());
@@ -2920,6 +3060,11 @@ int ClpFactorization::updateTwoColumnsFT(CoinIndexedVector *regionSparse1,
           noPermuteRegion3);
       }
       coinFactorizationA_->setCollectStatistics(false);
+      if (sparseStatisticsLevel_ || adaptiveSparse_) {
+        double time = startTime ? 0.5 * (CoinGetTimeOfDay() - startTime) : 0.0;
+        addSparseStatistics(1, regionSparse2->getNumElements(), time);
+        addSparseStatistics(0, regionSparse3->getNumElements(), time);
+      }
     } else {
 #if 0
                CoinSimpFactorization * fact =
@@ -2996,6 +3141,8 @@ int ClpFactorization::updateColumnTranspose(CoinIndexedVector *regionSparse,
   if (!numberRows())
     return 0;
 #ifndef SLIM_CLP
+  if (blockBasis_)
+    return blockBasis_->updateColumnTranspose(regionSparse, regionSparse2);
   if (!networkBasis_) {
 #endif
 #ifdef CLP_FACTORIZATION_INSTRUMENT
@@ -3004,10 +3151,14 @@ int ClpFactorization::updateColumnTranspose(CoinIndexedVector *regionSparse,
     int returnCode;
 
     if (coinFactorizationA_) {
+      double startTime = (sparseStatisticsLevel_ > 1) ? CoinGetTimeOfDay() : 0.0;
       coinFactorizationA_->setCollectStatistics(doStatistics_);
       returnCode = coinFactorizationA_->updateColumnTranspose(regionSparse,
         regionSparse2);
       coinFactorizationA_->setCollectStatistics(false);
+      if (sparseStatisticsLevel_ || adaptiveSparse_)
+        addSparseStatistics(2, regionSparse2->getNumElements(),
+          startTime ? CoinGetTimeOfDay() - startTime : 0.0);
     } else {
       returnCode = coinFactorizationB_->updateColumnTranspose(regionSparse,
         regionSparse2);
@@ -3073,12 +3224,13 @@ void ClpFactorization::updateTwoColumnsTranspose(CoinIndexedVector *regionSparse
   if (!numberRows())
     return;
 #ifndef SLIM_CLP
-  if (!networkBasis_) {
+  if (!networkBasis_ && !blockBasis_) {
 #endif
 #ifdef CLP_FACTORIZATION_INSTRUMENT
     factorization_instrument(-1);
 #endif
     if (coinFactorizationA_) {
+      double startTime = (sparseStatisticsLevel_ > 1) ? CoinGetTimeOfDay() : 0.0;
       coinFactorizationA_->setCollectStatistics(doStatistics_);
 #if ABOCA_LITE_FACTORIZATION
       coinFactorizationA_->updateTwoColumnsTranspose(regionSparse,
@@ -3088,6 +3240,12 @@ void ClpFactorization::updateTwoColumnsTranspose(CoinIndexedVector *regionSparse
         regionSparse2, regionSparse3, 0);
 #endif
       coinFactorizationA_->setCollectStatistics(false);
+      if (sparseStatisticsLevel_ || adaptiveSparse_) {
+        // split time between the two
+        double time = startTime ? 0.5 * (CoinGetTimeOfDay() - startTime) : 0.0;
+        addSparseStatistics(2, regionSparse2->getNumElements(), time);
+        addSparseStatistics(2, regionSparse3->getNumElements(), time);
+      }
     } else {
       coinFactorizationB_->updateColumnTranspose(regionSparse,
         regionSparse2);
@@ -3108,7 +3266,7 @@ void ClpFactorization::updateTwoColumnsTranspose(CoinIndexedVector *regionSparse
 void ClpFactorization::goSparse()
 {
 #ifndef SLIM_CLP
-  if (!networkBasis_) {
+  if (!networkBasis_ && !blockBasis_) {
 #endif
     if (coinFactorizationA_) {
 #ifdef CLP_FACTORIZATION_INSTRUMENT
@@ -3121,12 +3279,64 @@ void ClpFactorization::goSparse()
     }
   }
 }
+// Zero statistics
+void ClpFactorization::resetSparseStatistics()
+{
+  memset(&sparseStatistics_, 0, sizeof(ClpSparseStatistics));
+}
+// Upper limits of density buckets
+static const double clpSparseBucket[CLP_SPARSE_BUCKETS - 1] = {
+  0.001, 0.01, 0.05, 0.1, 0.25, 0.5
+};
+// Adds to sparse statistics
+void ClpFactorization::addSparseStatistics(int which, int numberNonZero,
+  double time) const
+{
+  ClpSparseStatistics &stats = sparseStatistics_;
+  double density = numberNonZero / static_cast< double >(coinFactorizationA_->numberRows());
+  int iBucket = 0;
+  while (iBucket < CLP_SPARSE_BUCKETS - 1 && density > clpSparseBucket[iBucket])
+    iBucket++;
+  stats.numberCalls[which]++;
+  stats.histogram[which][iBucket]++;
+  stats.sumDensity[which] += density;
+  stats.time[which][coinFactorizationA_->sparseThreshold() ? 1 : 0] += time;
+  stats.windowCalls++;
+  stats.windowDensity += density;
+}
+/* Switches hypersparse on or off from densities since last time.
+   Hypersparse methods only pay if results are mostly very sparse,
+   otherwise keeping the row copy of L is wasted effort */
+void ClpFactorization::adaptSparse()
+{
+  ClpSparseStatistics &stats = sparseStatistics_;
+  if (stats.windowCalls < 50)
+    return; // not enough evidence
+  double averageDensity = stats.windowDensity / stats.windowCalls;
+  stats.windowCalls = 0;
+  stats.windowDensity = 0.0;
+#ifndef SLIM_CLP
+  if (networkBasis_ || blockBasis_)
+    return;
+#endif
+  bool sparse = coinFactorizationA_->sparseThreshold() != 0;
+  if (!sparse && averageDensity < 0.02) {
+    coinFactorizationA_->goSparse();
+    if (coinFactorizationA_->sparseThreshold())
+      stats.numberSwitches++;
+  } else if (sparse && averageDensity > 0.2) {
+    coinFactorizationA_->sparseThreshold(0);
+    stats.numberSwitches++;
+  }
+}
 // Cleans up i.e. gets rid of network basis
 void ClpFactorization::cleanUp()
 {
 #ifndef SLIM_CLP
   delete networkBasis_;
   networkBasis_ = NULL;
+  delete blockBasis_;
+  blockBasis_ = NULL;
 #endif
   if (coinFactorizationA_)
     coinFactorizationA_->resetStatistics();
@@ -3153,8 +3363,8 @@ void ClpFactorization::getWeights(int *COIN_RESTRICT weights) const
   factorization_instrument(-1);
 #endif
 #ifndef SLIM_CLP
-  if (networkBasis_) {
-    // Network - just unit
+  if (networkBasis_ || blockBasis_) {
+    // Network or block triangular - just unit
     int numberRows = coinFactorizationA_->numberRows();
     for (int i = 0; i < numberRows; i++)
       weights[i] = 1;
@@ -3217,6 +3427,10 @@ void ClpFactorization::getWeights(int *COIN_RESTRICT weights) const
 void ClpFactorization::replaceColumn1(CoinIndexedVector *regionSparse,
   int pivotRow)
 {
+#ifndef SLIM_CLP
+  if (blockBasis_)
+    return;
+#endif
   if (coinFactorizationA_)
     coinFactorizationA_->replaceColumn1(regionSparse, pivotRow);
 }
@@ -3225,6 +3439,10 @@ int ClpFactorization::replaceColumn2(CoinIndexedVector *regionSparse,
   int pivotRow,
   double pivotCheck)
 {
+#ifndef SLIM_CLP
+  if (blockBasis_)
+    return 123456789; // so will do replaceColumn
+#endif
   if (coinFactorizationA_)
     return coinFactorizationA_->replaceColumn2(regionSparse, pivotRow, pivotCheck);
   else
@@ -12,6 +12,7 @@
 class ClpMatrixBase;
 class ClpSimplex;
 class ClpNetworkBasis;
+class ClpBlockBasis;
 class CoinOtherFactorization;
 #ifndef CLP_MULTIPLE_FACTORIZATIONS
 #define CLP_MULTIPLE_FACTORIZATIONS 4
@@ -27,6 +28,31 @@ class CoinOtherFactorization;
 #define CLP_FACTORIZATION_NEW_TIMING 1
 #endif
 
+/// Number of density buckets in ClpSparseStatistics
+#define CLP_SPARSE_BUCKETS 7
+/** Statistics on density of results of FTRAN and BTRAN.
+    First index is 0 FTRAN, 1 FTRAN for Forrest-Tomlin update, 2 BTRAN.
+    Density (nonzeros/rows) buckets are up to 0.1%, 1%, 5%, 10%, 25%,
+    50% and above.  Times are only collected at level 2 and are split by
+    whether hypersparse methods were on (1) or not (0).
+*/
+typedef struct {
+  /// Number of calls
+  int numberCalls[3];
+  /// Number of calls by density of result
+  int histogram[3][CLP_SPARSE_BUCKETS];
+  /// Sum of densities (so average can be got)
+  double sumDensity[3];
+  /// Wall clock time by mode
+  double time[3][2];
+  /// Number of times adaptive code switched hypersparse on or off
+  int numberSwitches;
+  /// Calls since adaptive code last looked
+  int windowCalls;
+  /// Sum of densities since adaptive code last looked
+  double windowDensity;
+} ClpSparseStatistics;
+
 /** This just implements CoinFactorization when an ClpMatrixBase object
     is passed.  If a network then has a dummy CoinFactorization and
     a genuine ClpNetworkBasis object
@@ -156,6 +182,10 @@ public:
   /// Returns address of permute region
   inline int *permute() const
   {
+#ifndef SLIM_CLP
+    if (blockBasis_)
+      return NULL; // no permutation
+#endif
     if (coinFactorizationA_)
       return coinFactorizationA_->permute();
     else
@@ -164,6 +194,10 @@ public:
   /// Returns address of pivotColumn region (also used for permuting)
   inline int *pivotColumn() const
   {
+#ifndef SLIM_CLP
+    if (blockBasis_)
+      return NULL; // no permutation
+#endif
     if (coinFactorizationA_)
       return coinFactorizationA_->pivotColumn();
     else
@@ -493,23 +527,115 @@ public:
   {
     doStatistics_ = trueFalse;
   }
+  /** Level of statistics on density of FTRAN/BTRAN results.
+      0 off, 1 counts and densities, 2 also wall clock times */
+  inline int sparseStatisticsLevel() const
+  {
+    return sparseStatisticsLevel_;
+  }
+  inline void setSparseStatisticsLevel(int value)
+  {
+    sparseStatisticsLevel_ = value;
+  }
+  /// Statistics since last reset
+  inline const ClpSparseStatistics &sparseStatistics() const
+  {
+    return sparseStatistics_;
+  }
+  /// Zero statistics
+  void resetSparseStatistics();
+  /** Whether hypersparse methods are switched on or off at
+      refactorization from densities of results since last time.
+      Counts are collected even if level is 0 */
+  inline bool adaptiveSparse() const
+  {
+    return adaptiveSparse_;
+  }
+  inline void setAdaptiveSparse(bool yesNo)
+  {
+    adaptiveSparse_ = yesNo;
+  }
 #ifndef SLIM_CLP
   /// Says if a network basis
   inline bool networkBasis() const
   {
     return (networkBasis_ != NULL);
   }
+  /// Says if a block triangular basis (see blockTriangular)
+  inline bool blockBasis() const
+  {
+    return (blockBasis_ != NULL);
+  }
+  /// Block triangular basis (or NULL)
+  inline ClpBlockBasis *blockTriangularBasis() const
+  {
+    return blockBasis_;
+  }
+  /** Number of side rows found for embedded network
+      (-1 if not looked for or no network found) */
+  inline int numberSideRows() const
+  {
+    if (!sideRow_)
+      return -1;
+    int n = 0;
+    for (int i = 0; i < sideRowLength_; i++)
+      n += sideRow_[i];
+    return n;
+  }
 #else
   /// Says if a network basis
   inline bool networkBasis() const
   {
     return false;
   }
+  /// Says if a block triangular basis
+  inline bool blockBasis() const
+  {
+    return false;
+  }
+  inline int numberSideRows() const
+  {
+    return -1;
+  }
 #endif
+  /** Largest diagonal block for block triangular factorization.
+      If nonzero then at each factorization the basis is permuted to
+      block triangular form and if no diagonal block is bigger than this
+      the blocks are factorized separately (see ClpBlockBasis).
+      Otherwise CoinFactorization is used as normal.  0 (default) off */
+  inline int blockTriangular() const
+  {
+    return blockTriangular_;
+  }
+  inline void setBlockTriangular(int value)
+  {
+    blockTriangular_ = value;
+  }
+  /** Most side rows for embedded network factorization.
+      If nonzero then ClpModel::findNetwork is used (once) to find
+      network rows and at each factorization basic columns forming a
+      spanning forest on those rows are factorized as a tree (see
+      ClpBlockBasis) and the rest through a dense Schur complement for
+      the side rows - if there are no more side rows than this.
+      Otherwise CoinFactorization is used as normal.  0 (default) off */
+  inline int embeddedNetwork() const
+  {
+    return embeddedNetwork_;
+  }
+  inline void setEmbeddedNetwork(int value)
+  {
+    embeddedNetwork_ = value;
+  }
   /// Fills weighted row list
   void getWeights(int *weights) const;
   //@}
 
+private:
+  /// Adds to sparse statistics (which as in ClpSparseStatistics)
+  void addSparseStatistics(int which, int numberNonZero, double time) const;
+  /// Switches hypersparse on or off from statistics
+  void adaptSparse();
+
   ////////////////// data //////////////////
 private:
   /**@name data */
@@ -517,6 +643,16 @@ private:
   /// Pointer to network basis
 #ifndef SLIM_CLP
   ClpNetworkBasis *networkBasis_;
+  /// Pointer to block triangular basis
+  ClpBlockBasis *blockBasis_;
+  /// Side rows (not in network) for embedded network or NULL if none
+  char *sideRow_;
+  /// Number of rows when sideRow_ found (-1 not tried)
+  int sideRowLength_;
+  /// Number of columns when sideRow_ found
+  int sideRowColumns_;
+  /// Number of elements when sideRow_ found (so matrix changes noticed)
+  CoinBigIndex sideRowElements_;
 #endif
 #ifdef CLP_MULTIPLE_FACTORIZATIONS
   /// Pointer to CoinFactorization
@@ -547,6 +683,16 @@ private:
 #endif
   /// To switch statistics on or off
   mutable bool doStatistics_;
+  /// Statistics on density of results
+  mutable ClpSparseStatistics sparseStatistics_;
+  /// Level of sparse statistics
+  int sparseStatisticsLevel_;
+  /// Largest diagonal block for block triangular factorization (0 off)
+  int blockTriangular_;
+  /// Most side rows for embedded network factorization (0 off)
+  int embeddedNetwork_;
+  /// Whether to switch hypersparse on or off from statistics
+  bool adaptiveSparse_;
   //@}
 };
 
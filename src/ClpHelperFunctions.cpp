@@ -14,6 +14,7 @@
 #include <cmath>
 #include "CoinHelperFunctions.hpp"
 #include "CoinTypes.h"
+#include "ClpTaskPool.hpp"
 
 double
 maximumAbsElement(const double *region, int size)
@@ -110,6 +111,102 @@ void getNorms(const double *region, int size, double &norm1, double &norm2)
     norm1 = CoinMax(norm1, fabs(region[i]));
   }
 }
+// Minimum number of elements per chunk if shared ClpTaskPool used
+#ifndef CLP_DENSE_GRAIN
+#define CLP_DENSE_GRAIN 16384
+#endif
+typedef struct {
+  double value;
+  double spare[7]; // keep slots on own cache line
+} clpDenseReduce;
+typedef struct {
+  double *region;
+  const double *base;
+  const double *region1;
+  const double *region2;
+  double multiplier1;
+  double multiplier2;
+  clpDenseReduce reduce[CLP_MAX_POOL_THREADS + 1];
+} clpDenseInfo;
+static void clpPdcoResidualRange(void *stuff, int first, int last, int iThread)
+{
+  clpDenseInfo *info = reinterpret_cast< clpDenseInfo * >(stuff);
+  double *COIN_RESTRICT region = info->region;
+  const double *COIN_RESTRICT base = info->base;
+  const double *COIN_RESTRICT region1 = info->region1;
+  const double *COIN_RESTRICT region2 = info->region2;
+  double multiplier1 = info->multiplier1;
+  double multiplier2 = info->multiplier2;
+  double largest = info->reduce[iThread].value;
+  if (region2) {
+    for (int i = first; i < last; i++) {
+      double value = base[i] - region[i] + multiplier1 * region1[i] + multiplier2 * region2[i];
+      region[i] = value;
+      largest = CoinMax(largest, fabs(value));
+    }
+  } else {
+    for (int i = first; i < last; i++) {
+      double value = base[i] - region[i] + multiplier1 * region1[i];
+      region[i] = value;
+      largest = CoinMax(largest, fabs(value));
+    }
+  }
+  info->reduce[iThread].value = largest;
+}
+static void clpSumSquaresRange(void *stuff, int first, int last, int iThread)
+{
+  clpDenseInfo *info = reinterpret_cast< clpDenseInfo * >(stuff);
+  const double *COIN_RESTRICT region = info->region1;
+  double value = 0.0;
+  for (int i = first; i < last; i++)
+    value += region[i] * region[i];
+  info->reduce[iThread].value += value;
+}
+static double clpDenseFor(int size, ClpRangeFunction function, clpDenseInfo &info,
+  bool isMaximum)
+{
+  for (int i = 0; i <= CLP_MAX_POOL_THREADS; i++)
+    info.reduce[i].value = 0.0;
+  ClpTaskPool *pool = ClpTaskPool::sharedIfExists();
+  if (pool && pool->numberThreads() && size >= 2 * CLP_DENSE_GRAIN)
+    pool->parallelFor(0, size, CLP_DENSE_GRAIN, function, &info);
+  else
+    function(&info, 0, size, 0);
+  double value = 0.0;
+  for (int i = 0; i <= CLP_MAX_POOL_THREADS; i++) {
+    if (isMaximum)
+      value = CoinMax(value, info.reduce[i].value);
+    else
+      value += info.reduce[i].value;
+  }
+  return value;
+}
+/* region = base - region + multiplier1 * region1 (+ multiplier2 * region2)
+   and returns largest absolute value */
+double pdcoResidual(double *region, int size, const double *base,
+  double multiplier1, const double *region1,
+  double multiplier2, const double *region2)
+{
+  clpDenseInfo info;
+  info.region = region;
+  info.base = base;
+  info.region1 = region1;
+  info.region2 = region2;
+  info.multiplier1 = multiplier1;
+  info.multiplier2 = multiplier2;
+  return clpDenseFor(size, clpPdcoResidualRange, info, true);
+}
+double sumSquares(const double *region, int size)
+{
+  clpDenseInfo info;
+  info.region = NULL;
+  info.base = NULL;
+  info.region1 = region;
+  info.region2 = NULL;
+  info.multiplier1 = 0.0;
+  info.multiplier2 = 0.0;
+  return clpDenseFor(size, clpSumSquaresRange, info, false);
+}
 #ifndef NDEBUG
 #include "ClpModel.hpp"
 #include "ClpMessage.hpp"
@@ -30,6 +30,16 @@ void multiplyAdd(const double *region1, int size, double multiplier1,
   double *region2, double multiplier2);
 double innerProduct(const double *region1, int size, const double *region2);
 void getNorms(const double *region, int size, double &norm1, double &norm2);
+/** Sum of squares of region.
+    Split over shared ClpTaskPool if big enough */
+double sumSquares(const double *region, int size);
+/** For pdco residuals - region = base - region + multiplier1 * region1
+    (+ multiplier2 * region2 if region2 not NULL) in one pass.
+    Returns largest absolute value in region.
+    Split over shared ClpTaskPool if big enough */
+double pdcoResidual(double *region, int size, const double *base,
+  double multiplier1, const double *region1,
+  double multiplier2, const double *region2);
 #if COIN_LONG_WORK
 // For long double versions
 CoinWorkDouble maximumAbsElement(const CoinWorkDouble *region, int size);
@@ -105,26 +115,23 @@ inline double pdxxxmerit(int nlow, int nupp, int *low, int *upp, CoinDenseVector
 
   // Evaluate the merit function for Newton's method.
   // It is the 2-norm of the three sets of residuals.
-  double sum1, sum2;
-  CoinDenseVector< double > f(6);
-  f[0] = r1.twoNorm();
-  f[1] = r2.twoNorm();
-  sum1 = sum2 = 0.0;
+  // Squares are summed directly rather than forming six norms.
+  double sum = sumSquares(r1.getElements(), r1.size())
+    + sumSquares(r2.getElements(), r2.size());
+  const double *rL_elts = rL.getElements();
+  const double *cL_elts = cL.getElements();
   for (int k = 0; k < nlow; k++) {
-    sum1 += rL[low[k]] * rL[low[k]];
-    sum2 += cL[low[k]] * cL[low[k]];
+    int j = low[k];
+    sum += rL_elts[j] * rL_elts[j] + cL_elts[j] * cL_elts[j];
   }
-  f[2] = sqrt(sum1);
-  f[4] = sqrt(sum2);
-  sum1 = sum2 = 0.0;
+  const double *rU_elts = rU.getElements();
+  const double *cU_elts = cU.getElements();
   for (int k = 0; k < nupp; k++) {
-    sum1 += rL[upp[k]] * rL[upp[k]];
-    sum2 += cL[upp[k]] * cL[upp[k]];
+    int j = upp[k];
+    sum += rU_elts[j] * rU_elts[j] + cU_elts[j] * cU_elts[j];
   }
-  f[3] = sqrt(sum1);
-  f[5] = sqrt(sum2);
 
-  return f.twoNorm();
+  return sqrt(sum);
 }
 
 //-----------------------------------------------------------------------
@@ -164,28 +171,36 @@ inline void pdxxxresid1(ClpPdco *model, const int nlow, const int nupp, const in
   for (int k = 0; k < nfix; k++)
     r2_elts[fix[k]] = 0;
 
-  r1 = b - r1 - d2 * d2 * y;
-  r2 = grad - r2 - z1; // grad includes d1*d1*x
-  if (nupp > 0)
-    r2 = r2 + z2;
-
-  for (int k = 0; k < nlow; k++)
-    rL[low[k]] = bl[low[k]] - x[low[k]] + x1[low[k]];
-  for (int k = 0; k < nupp; k++)
-    rU[upp[k]] = -bu[upp[k]] + x[upp[k]] + x2[upp[k]];
+  // r1 = b - r1 - d2*d2*y and r2 = grad - r2 - z1 (+ z2) each in one pass
+  double r1Norm = pdcoResidual(r1.getElements(), r1.size(), b.getElements(),
+    -d2 * d2, y.getElements(), 0.0, NULL);
+  double r2Norm = pdcoResidual(r2_elts, r2.size(), grad.getElements(), // grad includes d1*d1*x
+    -1.0, z1.getElements(), 1.0, nupp > 0 ? z2.getElements() : NULL);
 
+  double *rL_elts = rL.getElements();
+  double *rU_elts = rU.getElements();
+  const double *x1_elts = x1.getElements();
+  const double *x2_elts = x2.getElements();
   double normL = 0.0;
   double normU = 0.0;
-  for (int k = 0; k < nlow; k++)
-    if (rL[low[k]] > normL)
-      normL = rL[low[k]];
-  for (int k = 0; k < nupp; k++)
-    if (rU[upp[k]] > normU)
-      normU = rU[upp[k]];
+  for (int k = 0; k < nlow; k++) {
+    int j = low[k];
+    double value = bl[j] - x_elts[j] + x1_elts[j];
+    rL_elts[j] = value;
+    if (value > normL)
+      normL = value;
+  }
+  for (int k = 0; k < nupp; k++) {
+    int j = upp[k];
+    double value = -bu[j] + x_elts[j] + x2_elts[j];
+    rU_elts[j] = value;
+    if (value > normU)
+      normU = value;
+  }
 
   *Pinf = CoinMax(normL, normU);
-  *Pinf = CoinMax(r1.infNorm(), *Pinf);
-  *Dinf = r2.infNorm();
+  *Pinf = CoinMax(r1Norm, *Pinf);
+  *Dinf = r2Norm;
   *Pinf = CoinMax(*Pinf, 1e-99);
   *Dinf = CoinMax(*Dinf, 1e-99);
 }
@@ -101,6 +101,10 @@ ClpInterior::ClpInterior()
   , numberComplementarityPairs_(0)
   , numberComplementarityItems_(0)
   , maximumBarrierIterations_(200)
+  , maximumCorrectors_(-1)
+  , warmStart_(0)
+  , coldStartIterations_(0)
+  , numberCorrectors_(0)
   , gonePrimalFeasible_(false)
   , goneDualFeasible_(false)
   , algorithm_(-1)
@@ -190,6 +194,10 @@ ClpInterior::ClpInterior(const ClpModel *rhs,
   , numberComplementarityPairs_(0)
   , numberComplementarityItems_(0)
   , maximumBarrierIterations_(200)
+  , maximumCorrectors_(-1)
+  , warmStart_(0)
+  , coldStartIterations_(0)
+  , numberCorrectors_(0)
   , gonePrimalFeasible_(false)
   , goneDualFeasible_(false)
   , algorithm_(-1)
@@ -342,6 +350,10 @@ ClpInterior::ClpInterior(const ClpModel &rhs)
   , numberComplementarityPairs_(0)
   , numberComplementarityItems_(0)
   , maximumBarrierIterations_(200)
+  , maximumCorrectors_(-1)
+  , warmStart_(0)
+  , coldStartIterations_(0)
+  , numberCorrectors_(0)
   , gonePrimalFeasible_(false)
   , goneDualFeasible_(false)
   , algorithm_(-1)
@@ -438,6 +450,10 @@ void ClpInterior::gutsOfCopy(const ClpInterior &rhs)
   numberComplementarityPairs_ = rhs.numberComplementarityPairs_;
   numberComplementarityItems_ = rhs.numberComplementarityItems_;
   maximumBarrierIterations_ = rhs.maximumBarrierIterations_;
+  maximumCorrectors_ = rhs.maximumCorrectors_;
+  warmStart_ = rhs.warmStart_;
+  coldStartIterations_ = rhs.coldStartIterations_;
+  numberCorrectors_ = rhs.numberCorrectors_;
   gonePrimalFeasible_ = rhs.gonePrimalFeasible_;
   goneDualFeasible_ = rhs.goneDualFeasible_;
   algorithm_ = rhs.algorithm_;
@@ -1207,6 +1223,10 @@ ClpInterior::quadraticDjs(CoinWorkDouble *djRegion, const CoinWorkDouble *soluti
     quadraticObj = (static_cast< ClpQuadraticObjective * >(objective_));
 #endif
   if (quadraticObj) {
+#if COIN_LONG_WORK == 0
+    // split over threads if big enough
+    quadraticOffset = 2.0 * quadraticObj->hessianTimes(solution, djRegion, scaleFactor);
+#else
     CoinPackedMatrix *quadratic = quadraticObj->quadraticObjective();
     const int *columnQuadratic = quadratic->getIndices();
     const CoinBigIndex *columnQuadraticStart = quadratic->getVectorStarts();
@@ -1226,6 +1246,7 @@ ClpInterior::quadraticDjs(CoinWorkDouble *djRegion, const CoinWorkDouble *soluti
       }
       djRegion[iColumn] += scaleFactor * value;
     }
+#endif
   }
   return quadraticOffset;
 }
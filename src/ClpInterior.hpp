@@ -277,6 +277,44 @@ public:
   {
     maximumBarrierIterations_ = value;
   }
+  /** Maximum centrality correctors in an iteration.
+      -1 (default) chooses from ratio of factorization to solve time
+      so more are tried when factorization is expensive, 0 none */
+  inline int maximumCorrectors() const
+  {
+    return maximumCorrectors_;
+  }
+  inline void setMaximumCorrectors(int value)
+  {
+    maximumCorrectors_ = value;
+  }
+  /** Warm start.  If 1 then primal and dual solution in model
+      (e.g. from a previous barrier or simplex solve of a similar
+      problem) are shifted into interior and used as starting point
+      instead of computing one from scratch */
+  inline int warmStart() const
+  {
+    return warmStart_;
+  }
+  inline void setWarmStart(int value)
+  {
+    warmStart_ = value;
+  }
+  /** Iterations of last cold started solve (set by a cold start
+      and used to report iterations saved by warm start) */
+  inline int coldStartIterations() const
+  {
+    return coldStartIterations_;
+  }
+  inline void setColdStartIterations(int value)
+  {
+    coldStartIterations_ = value;
+  }
+  /// Number of centrality corrector solves in last solve
+  inline int numberCorrectors() const
+  {
+    return numberCorrectors_;
+  }
   /// Set cholesky (and delete present one)
   void setCholesky(ClpCholeskyBase *cholesky);
   /// Return number fixed to see if worth presolving
@@ -595,6 +633,14 @@ protected:
   int numberComplementarityItems_;
   /// Maximum iterations
   int maximumBarrierIterations_;
+  /// Maximum centrality correctors (-1 adaptive)
+  int maximumCorrectors_;
+  /// Warm start from solution in model
+  int warmStart_;
+  /// Iterations of last cold started solve
+  int coldStartIterations_;
+  /// Number of centrality corrector solves in last solve
+  int numberCorrectors_;
   /// gonePrimalFeasible.
   bool gonePrimalFeasible_;
   /// goneDualFeasible.
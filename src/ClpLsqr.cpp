@@ -2,6 +2,7 @@
 // Corporation and others.  All Rights Reserved.
 // This code is licensed under the terms of the Eclipse Public License (EPL).
 
+#include "CoinHelperFunctions.hpp"
 #include "ClpLsqr.hpp"
 #include "ClpPdco.hpp"
 
@@ -306,13 +307,16 @@ void ClpLsqr::matVecMult(int mode, CoinDenseVector< double > *x, CoinDenseVector
 {
   int n = model_->numberColumns();
   int m = model_->numberRows();
-  CoinDenseVector< double > *temp = new CoinDenseVector< double >(n, 0.0);
-  double *t_elts = temp->getElements();
+  // keep work vector between calls as called twice per iteration
+  if (!work_)
+    work_ = new double[n];
+  double *t_elts = work_;
   double *x_elts = x->getElements();
   double *y_elts = y->getElements();
   ClpPdco *pdcoModel = (ClpPdco *)model_;
   if (mode == 1) {
-    pdcoModel->matVecMult(2, temp, y);
+    CoinZeroN(t_elts, n);
+    pdcoModel->matVecMult(2, t_elts, y_elts);
     for (int k = 0; k < n; k++)
       x_elts[k] += (diag1_[k] * t_elts[k]);
     for (int k = 0; k < m; k++)
@@ -320,11 +324,10 @@ void ClpLsqr::matVecMult(int mode, CoinDenseVector< double > *x, CoinDenseVector
   } else {
     for (int k = 0; k < n; k++)
       t_elts[k] = diag1_[k] * y_elts[k];
-    pdcoModel->matVecMult(1, x, temp);
+    pdcoModel->matVecMult(1, x_elts, t_elts);
     for (int k = 0; k < m; k++)
       x_elts[k] += diag2_ * y_elts[n + k];
   }
-  delete temp;
   return;
 }
 
@@ -335,7 +338,8 @@ void ClpLsqr::matVecMult(int mode, CoinDenseVector< double > &x, CoinDenseVector
 }
 /* Default constructor */
 ClpLsqr::ClpLsqr()
-  : nrows_(0)
+  : work_(NULL)
+  , nrows_(0)
   , ncols_(0)
   , model_(NULL)
   , diag1_(NULL)
@@ -345,7 +349,8 @@ ClpLsqr::ClpLsqr()
 
 /* Constructor for use with Pdco model (note modified for pdco!!!!) */
 ClpLsqr::ClpLsqr(ClpInterior *model)
-  : diag1_(NULL)
+  : work_(NULL)
+  , diag1_(NULL)
   , diag2_(0.0)
 {
   model_ = model;
@@ -356,6 +361,7 @@ ClpLsqr::ClpLsqr(ClpInterior *model)
 ClpLsqr::~ClpLsqr()
 {
   // delete [] diag1_; no as we just borrowed it
+  delete[] work_;
 }
 bool ClpLsqr::setParam(char *parmName, int parmValue)
 {
@@ -372,7 +378,8 @@ bool ClpLsqr::setParam(char *parmName, int parmValue)
   return 0;
 }
 ClpLsqr::ClpLsqr(const ClpLsqr &rhs)
-  : nrows_(rhs.nrows_)
+  : work_(NULL)
+  , nrows_(rhs.nrows_)
   , ncols_(rhs.ncols_)
   , model_(rhs.model_)
   , diag2_(rhs.diag2_)
@@ -386,6 +393,8 @@ ClpLsqr::operator=(const ClpLsqr &rhs)
   if (this != &rhs) {
     delete[] diag1_;
     diag1_ = ClpCopyOfArray(rhs.diag1_, nrows_);
+    delete[] work_;
+    work_ = NULL;
     nrows_ = rhs.nrows_;
     ncols_ = rhs.ncols_;
     model_ = rhs.model_;
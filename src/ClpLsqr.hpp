@@ -75,6 +75,8 @@ class ClpLsqr {
 private:
   /**@name Private member data */
   //@{
+  /// Work vector (number of columns in model) for matVecMult
+  double *work_;
   //@}
 
 public:
@@ -377,6 +377,7 @@ public:
   /** Returns type.
          The types which code may need to know about are:
          1  - ClpPackedMatrix
+         10 - ClpCompressedMatrix
          11 - ClpNetworkMatrix
          12 - ClpPlusMinusOneMatrix
      */
@@ -380,6 +380,28 @@ void ClpModel::loadProblem(
   matrix_ = new ClpPackedMatrix(matrix);
   matrix_->setDimensions(numberRows_, numberColumns_);
 }
+/* As above but if borrowMatrix true then matrix arrays are not copied
+   (bounds and objective still are as cleaned here) */
+void ClpModel::loadProblem(
+  const int numcols, const int numrows,
+  const CoinBigIndex *start, const int *index,
+  const double *value,
+  const double *collb, const double *colub,
+  const double *obj,
+  const double *rowlb, const double *rowub,
+  const double *rowObjective, bool borrowMatrix)
+{
+  if (!borrowMatrix || !start || !numrows || !numcols) {
+    // nothing worth borrowing
+    loadProblem(numcols, numrows, start, index, value,
+      collb, colub, obj, rowlb, rowub, rowObjective);
+    return;
+  }
+  gutsOfLoadModel(numrows, numcols,
+    collb, colub, obj, rowlb, rowub, rowObjective);
+  matrix_ = new ClpPackedMatrix(numrows, numcols, start, index, value);
+  matrix_->setDimensions(numberRows_, numberColumns_);
+}
 void ClpModel::loadProblem(
   const int numcols, const int numrows,
   const CoinBigIndex *start, const int *index,
@@ -1221,6 +1243,7 @@ ClpModel::cleanMatrix(double threshold)
 {
   ClpPackedMatrix *matrix = (dynamic_cast< ClpPackedMatrix * >(matrix_));
   if (matrix) {
+    matrix->ownArrays();
     return matrix->getPackedMatrix()->cleanMatrix(threshold);
   } else {
     return -1;
@@ -2990,6 +3013,10 @@ ClpModel::modifyByIndicators(double startBigM,
     bigM = -bigM;
     nTry = 2;
   }
+  // elements changed in place
+  ClpPackedMatrix *clpMatrix = dynamic_cast< ClpPackedMatrix * >(matrix_);
+  if (clpMatrix)
+    clpMatrix->ownArrays();
   const int * row1 = matrix_->getIndices();
   const int * columnLength1 = matrix_->getVectorLengths();
   const CoinBigIndex * columnStart1 = matrix_->getVectorStarts();
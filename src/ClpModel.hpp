@@ -104,6 +104,19 @@ public:
     const double *obj,
     const double *rowlb, const double *rowub,
     const double *rowObjective = NULL);
+  /** As above but if borrowMatrix true then start, index and value are
+       used in place (not copied) so must stay valid and unchanged until
+       the problem is replaced or the model deleted.  Clp copies them
+       if it needs to change the matrix (a scaled matrix is a separate
+       copy anyway).  Bounds and objective are always copied as they are
+       cleaned and changed during a solve. */
+  void loadProblem(const int numcols, const int numrows,
+    const CoinBigIndex *start, const int *index,
+    const double *value,
+    const double *collb, const double *colub,
+    const double *obj,
+    const double *rowlb, const double *rowub,
+    const double *rowObjective, bool borrowMatrix);
   /** This loads a model from a coinModel object - returns number of errors.
 
          modelObject not const as may be changed as part of process
@@ -783,13 +796,21 @@ public:
   {
     return columnUpper_;
   }
-  /// Matrix (if not ClpPackedmatrix be careful about memory leak
+  /** Matrix (if not ClpPackedmatrix be careful about memory leak.
+      If arrays were borrowed from caller an own copy is made first
+      as returned matrix may be changed) */
   inline CoinPackedMatrix *matrix() const
   {
-    if (matrix_ == NULL)
+    if (matrix_ == NULL) {
       return NULL;
-    else
+    } else {
+      if (matrix_->type() == 1) {
+        ClpPackedMatrix *clpMatrix = static_cast< ClpPackedMatrix * >(matrix_);
+        if (clpMatrix->borrowed())
+          clpMatrix->ownArrays();
+      }
       return matrix_->getPackedMatrix();
+    }
   }
   /// Number of elements in matrix
   inline CoinBigIndex getNumElements() const
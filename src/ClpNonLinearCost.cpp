@@ -221,6 +221,43 @@ ClpNonLinearCost::ClpNonLinearCost(ClpSimplex * model, int method)
     }
   }
 }
+// Sets up for model as constructor would but keeping arrays
+bool ClpNonLinearCost::reuse(ClpSimplex *model)
+{
+  int iSequence;
+  if (method_ != 2 || model->numberExtraRows() || model->numberRows() != numberRows_ || model->numberColumns() != numberColumns_)
+    return false;
+  if (model->clpMatrix()->generalExpanded(model, 10, iSequence))
+    return false; // would need method 1
+  model_ = model;
+  int numberTotal = numberRows_ + numberColumns_;
+  convex_ = true;
+  bothWays_ = false;
+  numberInfeasibilities_ = 0;
+  changeCost_ = 0.0;
+  feasibleCost_ = 0.0;
+  infeasibilityWeight_ = -1.0;
+  sumInfeasibilities_ = 0.0;
+  averageTheta_ = 0.0;
+  largestInfeasibility_ = 0.0;
+  double *cost = model_->costRegion();
+  // check if all 0
+  bool allZero = true;
+  for (iSequence = 0; iSequence < numberTotal; iSequence++) {
+    if (cost[iSequence]) {
+      allZero = false;
+      break;
+    }
+  }
+  if (allZero && model_->clpMatrix()->type() < 15 && model_->objectiveAsObject()->type() == 1)
+    model_->setInfeasibilityCost(1.0);
+  for (iSequence = 0; iSequence < numberTotal; iSequence++) {
+    bound_[iSequence] = 0.0;
+    cost2_[iSequence] = cost[iSequence];
+    setInitialStatus(status_[iSequence]);
+  }
+  return true;
+}
 #if 0
 // Refresh - assuming regions OK
 void 
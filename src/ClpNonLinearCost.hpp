@@ -99,6 +99,9 @@ public:
   ClpNonLinearCost(const ClpNonLinearCost &);
   // Assignment
   ClpNonLinearCost &operator=(const ClpNonLinearCost &);
+  /** Sets up for model as constructor would but keeping arrays.
+         Only if same size and simple (method 2) - returns false if not */
+  bool reuse(ClpSimplex *model);
   //@}
 
   /**@name Actual work in primal */
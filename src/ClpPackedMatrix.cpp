@@ -22,6 +22,7 @@
 // at end to get min/max!
 #include "ClpPackedMatrix.hpp"
 #include "ClpMessage.hpp"
+#include "ClpTaskPool.hpp"
 #ifdef INTEL_MKL
 #include "mkl_spblas.h"
 #endif
@@ -95,11 +96,11 @@ ClpPackedMatrix::ClpPackedMatrix(const ClpPackedMatrix &rhs)
 #ifndef COIN_SPARSE_MATRIX
   // Guaranteed no gaps or small elements
   matrix_ = new CoinPackedMatrix(*(rhs.matrix_), -1, 0);
-  flags_ = rhs.flags_ & (~0x02);
+  flags_ = rhs.flags_ & (~(0x02 | 64 | 128));
 #else
   // Gaps & small elements preserved
   matrix_ = new CoinPackedMatrix(*(rhs.matrix_), 0, 0);
-  flags_ = rhs.flags_;
+  flags_ = rhs.flags_ & (~(64 | 128));
   if (matrix_->hasGaps())
     flags_ |= 0x02;
 #endif
@@ -161,12 +162,40 @@ ClpPackedMatrix::ClpPackedMatrix(const CoinPackedMatrix &rhs)
   checkFlags(0);
 #endif
 }
+// Borrows caller's arrays
+ClpPackedMatrix::ClpPackedMatrix(int numberRows, int numberColumns,
+  const CoinBigIndex *start, const int *index, const double *element)
+  : ClpMatrixBase()
+{
+  assert(start);
+  // CoinPackedMatrix wants non const (but will not change them)
+  double *elementByColumn = const_cast< double * >(element);
+  int *row = const_cast< int * >(index);
+  CoinBigIndex *columnStart = const_cast< CoinBigIndex * >(start);
+  // only lengths are ours
+  int *columnLength = new int[numberColumns];
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+    columnLength[iColumn] = static_cast< int >(start[iColumn + 1] - start[iColumn]);
+  matrix_ = new CoinPackedMatrix();
+  matrix_->assignMatrix(true, numberRows, numberColumns, start[numberColumns],
+    elementByColumn, row, columnStart, columnLength);
+  flags_ = 64;
+  numberActiveColumns_ = numberColumns;
+  rowCopy_ = NULL;
+  columnCopy_ = NULL;
+  setType(1);
+#ifdef DO_CHECK_FLAGS
+  checkFlags(0);
+#endif
+}
 
 //-------------------------------------------------------------------
 // Destructor
 //-------------------------------------------------------------------
 ClpPackedMatrix::~ClpPackedMatrix()
 {
+  if (flags_ & 64)
+    releaseBorrowed();
   delete matrix_;
   delete rowCopy_;
   delete columnCopy_;
@@ -180,13 +209,15 @@ ClpPackedMatrix::operator=(const ClpPackedMatrix &rhs)
 {
   if (this != &rhs) {
     ClpMatrixBase::operator=(rhs);
+    if (flags_ & 64)
+      releaseBorrowed();
     delete matrix_;
 #ifndef COIN_SPARSE_MATRIX
     matrix_ = new CoinPackedMatrix(*(rhs.matrix_), -1, 0);
-    flags_ = rhs.flags_ & (~0x02);
+    flags_ = rhs.flags_ & (~(0x02 | 64 | 128));
 #else
     matrix_ = new CoinPackedMatrix(*(rhs.matrix_), 0, 0);
-    flags_ = rhs.flags_;
+    flags_ = rhs.flags_ & (~(64 | 128));
     if (matrix_->hasGaps())
       flags_ |= 0x02;
 #endif
@@ -224,6 +255,7 @@ void ClpPackedMatrix::copy(const ClpPackedMatrix *rhs)
   //*this = *rhs;
   assert(numberActiveColumns_ == rhs->numberActiveColumns_);
   assert(matrix_->isColOrdered() == rhs->matrix_->isColOrdered());
+  ownArrays();
   matrix_->copyReuseArrays(*rhs->matrix_);
 #ifdef DO_CHECK_FLAGS
   checkFlags(0);
@@ -251,7 +283,7 @@ ClpPackedMatrix::ClpPackedMatrix(
     numberColumns, whichColumns);
   numberActiveColumns_ = matrix_->getNumCols();
   rowCopy_ = NULL;
-  flags_ = rhs.flags_ & (~0x02); // no gaps
+  flags_ = rhs.flags_ & (~(0x02 | 64 | 128)); // no gaps
   columnCopy_ = NULL;
 #ifdef DO_CHECK_FLAGS
   checkFlags(0);
@@ -286,7 +318,7 @@ ClpPackedMatrix::reverseOrderedCopy() const
   copy->matrix_->reverseOrderedCopyOf(*matrix_);
   //copy->matrix_->removeGaps();
   copy->numberActiveColumns_ = copy->matrix_->getNumCols();
-  copy->flags_ = flags_ & (~0x02); // no gaps
+  copy->flags_ = flags_ & (~(0x02 | 64 | 128)); // no gaps
 #ifdef DO_CHECK_FLAGS
   checkFlags(0);
 #endif
@@ -359,6 +391,39 @@ transposeTimesBit(clpTempInfo &info)
   }
 }
 #endif
+// Minimum number of columns per chunk if shared ClpTaskPool used
+#ifndef CLP_POOL_GRAIN
+#define CLP_POOL_GRAIN 4096
+#endif
+typedef struct {
+  const double *element;
+  const CoinBigIndex *start;
+  const int *row;
+  const double *x;
+  double *y;
+  double scalar;
+} clpTransposeRange;
+static void clpTransposeTimesRange(void *stuff, int first, int last, int)
+{
+  clpTransposeRange *info = reinterpret_cast< clpTransposeRange * >(stuff);
+  const int *COIN_RESTRICT row = info->row;
+  const CoinBigIndex *COIN_RESTRICT columnStart = info->start;
+  const double *COIN_RESTRICT elementByColumn = info->element;
+  const double *COIN_RESTRICT x = info->x;
+  double *COIN_RESTRICT y = info->y;
+  double scalar = info->scalar;
+  CoinBigIndex start = columnStart[first];
+  for (int iColumn = first; iColumn < last; iColumn++) {
+    CoinBigIndex next = columnStart[iColumn + 1];
+    double value = 0.0;
+    for (CoinBigIndex j = start; j < next; j++) {
+      int jRow = row[j];
+      value += x[jRow] * elementByColumn[j];
+    }
+    start = next;
+    y[iColumn] += value * scalar;
+  }
+}
 void ClpPackedMatrix::transposeTimes(double scalar,
   const double *COIN_RESTRICT x, double *COIN_RESTRICT y) const
 {
@@ -367,7 +432,20 @@ void ClpPackedMatrix::transposeTimes(double scalar,
   const int *COIN_RESTRICT row = matrix_->getIndices();
   const CoinBigIndex *COIN_RESTRICT columnStart = matrix_->getVectorStarts();
   const double *COIN_RESTRICT elementByColumn = matrix_->getElements();
-  if (!(flags_ & 2)) {
+  ClpTaskPool *pool = ClpTaskPool::sharedIfExists();
+  if (!(flags_ & 2) && pool && pool->numberThreads()
+    && numberActiveColumns_ >= 2 * CLP_POOL_GRAIN) {
+    // columns independent so split over shared pool
+    clpTransposeRange info;
+    info.element = elementByColumn;
+    info.start = columnStart;
+    info.row = row;
+    info.x = x;
+    info.y = y;
+    info.scalar = scalar;
+    pool->parallelFor(0, numberActiveColumns_, CLP_POOL_GRAIN,
+      clpTransposeTimesRange, &info);
+  } else if (!(flags_ & 2)) {
     if (scalar == -1.0) {
 #if ABOCA_LITE
       int numberThreads = abcState();
@@ -4127,6 +4205,317 @@ static void doSqrts(double *array, int n)
     array[i] = 1.0 / sqrt(array[i]);
 }
 #endif
+/* Scaling sweeps are independent by row (or column) so can be split
+   over the shared ClpTaskPool.  Reductions go into one slot per thread. */
+typedef struct {
+  double largest;
+  double smallest;
+  double spare[6]; // keep slots on own cache line
+} clpScaleReduce;
+typedef struct {
+  // column copy
+  const int *row;
+  const CoinBigIndex *columnStart;
+  const int *columnLength;
+  const double *elementByColumn;
+  // row copy
+  const int *column;
+  const CoinBigIndex *rowStart;
+  double *element;
+  // scaled column copy
+  int *newRow;
+  const CoinBigIndex *newStart;
+  double *newElement;
+  const char *usefulColumn;
+  const double *columnLower;
+  const double *columnUpper;
+  char *usedRow;
+  double *rowScale;
+  double *columnScale;
+  double overallLargest;
+#ifdef RANDOMIZE
+  // factor for each column (random so drawn in column order first)
+  const double *randomFactor;
+#endif
+  bool extraDetails;
+  clpScaleReduce reduce[CLP_MAX_POOL_THREADS + 1];
+} clpScaleInfo;
+static void clpScaleFor(int n, ClpRangeFunction function, clpScaleInfo &info)
+{
+  for (int i = 0; i <= CLP_MAX_POOL_THREADS; i++) {
+    info.reduce[i].largest = 0.0;
+    info.reduce[i].smallest = 1.0e50;
+  }
+  ClpTaskPool *pool = ClpTaskPool::sharedIfExists();
+  if (pool && pool->numberThreads())
+    pool->parallelFor(0, n, CLP_POOL_GRAIN, function, &info);
+  else
+    function(&info, 0, n, 0);
+}
+static void clpScaleReduced(const clpScaleInfo &info,
+  double &largest, double &smallest)
+{
+  for (int i = 0; i <= CLP_MAX_POOL_THREADS; i++) {
+    largest = CoinMax(largest, info.reduce[i].largest);
+    smallest = CoinMin(smallest, info.reduce[i].smallest);
+  }
+}
+// Maximum in each row (equilibrium)
+static void clpScaleRowMaximum(void *stuff, int first, int last, int iThread)
+{
+  clpScaleInfo *info = reinterpret_cast< clpScaleInfo * >(stuff);
+  const int *COIN_RESTRICT column = info->column;
+  const CoinBigIndex *COIN_RESTRICT rowStart = info->rowStart;
+  const double *COIN_RESTRICT element = info->element;
+  const char *COIN_RESTRICT usefulColumn = info->usefulColumn;
+  double *COIN_RESTRICT rowScale = info->rowScale;
+  clpScaleReduce &reduce = info->reduce[iThread];
+  for (int iRow = first; iRow < last; iRow++) {
+    double largest = 1.0e-10;
+    for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow + 1]; j++) {
+      int iColumn = column[j];
+      if (usefulColumn[iColumn]) {
+        double value = fabs(element[j]);
+        largest = CoinMax(largest, value);
+        assert(largest < 1.0e40);
+      }
+    }
+    rowScale[iRow] = 1.0 / largest;
+    if (info->extraDetails) {
+      reduce.largest = CoinMax(reduce.largest, largest);
+      reduce.smallest = CoinMin(reduce.smallest, largest);
+    }
+  }
+}
+// Geometric mean on row scales
+static void clpScaleRowGeometric(void *stuff, int first, int last, int iThread)
+{
+  clpScaleInfo *info = reinterpret_cast< clpScaleInfo * >(stuff);
+  const int *COIN_RESTRICT column = info->column;
+  const CoinBigIndex *COIN_RESTRICT rowStart = info->rowStart;
+  const double *COIN_RESTRICT element = info->element;
+  const char *COIN_RESTRICT usefulColumn = info->usefulColumn;
+  const double *COIN_RESTRICT columnScale = info->columnScale;
+  double *COIN_RESTRICT rowScale = info->rowScale;
+  clpScaleReduce &reduce = info->reduce[iThread];
+  for (int iRow = first; iRow < last; iRow++) {
+    double largest = 1.0e-50;
+    double smallest = 1.0e50;
+    for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow + 1]; j++) {
+      int iColumn = column[j];
+      if (usefulColumn[iColumn]) {
+        double value = fabs(element[j]);
+        value *= columnScale[iColumn];
+        largest = CoinMax(largest, value);
+        smallest = CoinMin(smallest, value);
+      }
+    }
+#ifdef SQRT_ARRAY
+    rowScale[iRow] = smallest * largest;
+#else
+    rowScale[iRow] = 1.0 / sqrt(smallest * largest);
+#endif
+    if (info->extraDetails) {
+      reduce.largest = CoinMax(largest * rowScale[iRow], reduce.largest);
+      reduce.smallest = CoinMin(smallest * rowScale[iRow], reduce.smallest);
+    }
+  }
+}
+// Geometric mean on column scales
+static void clpScaleColumnGeometric(void *stuff, int first, int last, int)
+{
+  clpScaleInfo *info = reinterpret_cast< clpScaleInfo * >(stuff);
+  const int *COIN_RESTRICT row = info->row;
+  const CoinBigIndex *COIN_RESTRICT columnStart = info->columnStart;
+  const int *COIN_RESTRICT columnLength = info->columnLength;
+  const double *COIN_RESTRICT elementByColumn = info->elementByColumn;
+  const char *COIN_RESTRICT usefulColumn = info->usefulColumn;
+  const double *COIN_RESTRICT rowScale = info->rowScale;
+  double *COIN_RESTRICT columnScale = info->columnScale;
+  for (int iColumn = first; iColumn < last; iColumn++) {
+    if (usefulColumn[iColumn]) {
+      double largest = 1.0e-50;
+      double smallest = 1.0e50;
+      for (CoinBigIndex j = columnStart[iColumn];
+           j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+        int iRow = row[j];
+        double value = fabs(elementByColumn[j]);
+        value *= rowScale[iRow];
+        largest = CoinMax(largest, value);
+        smallest = CoinMin(smallest, value);
+      }
+#ifdef SQRT_ARRAY
+      columnScale[iColumn] = smallest * largest;
+#else
+      columnScale[iColumn] = 1.0 / sqrt(smallest * largest);
+#endif
+    }
+  }
+}
+// See what smallest will be if largest is 1.0
+static void clpScaleColumnRatio(void *stuff, int first, int last, int iThread)
+{
+  clpScaleInfo *info = reinterpret_cast< clpScaleInfo * >(stuff);
+  const int *COIN_RESTRICT row = info->row;
+  const CoinBigIndex *COIN_RESTRICT columnStart = info->columnStart;
+  const int *COIN_RESTRICT columnLength = info->columnLength;
+  const double *COIN_RESTRICT elementByColumn = info->elementByColumn;
+  const char *COIN_RESTRICT usefulColumn = info->usefulColumn;
+  const double *COIN_RESTRICT rowScale = info->rowScale;
+  double overallSmallest = info->reduce[iThread].smallest;
+  for (int iColumn = first; iColumn < last; iColumn++) {
+    if (usefulColumn[iColumn]) {
+      double largest = 1.0e-20;
+      double smallest = 1.0e50;
+      for (CoinBigIndex j = columnStart[iColumn];
+           j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+        int iRow = row[j];
+        double value = fabs(elementByColumn[j] * rowScale[iRow]);
+        largest = CoinMax(largest, value);
+        smallest = CoinMin(smallest, value);
+      }
+      if (overallSmallest * largest > smallest)
+        overallSmallest = smallest / largest;
+    }
+  }
+  info->reduce[iThread].smallest = overallSmallest;
+}
+// Mark rows with a column which is not fixed
+static void clpScaleUsedRows(void *stuff, int first, int last, int)
+{
+  clpScaleInfo *info = reinterpret_cast< clpScaleInfo * >(stuff);
+  const int *COIN_RESTRICT column = info->column;
+  const CoinBigIndex *COIN_RESTRICT rowStart = info->rowStart;
+  const double *COIN_RESTRICT columnLower = info->columnLower;
+  const double *COIN_RESTRICT columnUpper = info->columnUpper;
+  char *COIN_RESTRICT usedRow = info->usedRow;
+  for (int iRow = first; iRow < last; iRow++) {
+    char used = 0;
+    for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow + 1]; j++) {
+      int iColumn = column[j];
+      if (columnUpper[iColumn] > columnLower[iColumn] + 1.0e-12) {
+        used = 1;
+        break;
+      }
+    }
+    usedRow[iRow] = used;
+  }
+}
+// Final column scales so largest is reasonable
+static void clpScaleColumnFinal(void *stuff, int first, int last, int iThread)
+{
+  clpScaleInfo *info = reinterpret_cast< clpScaleInfo * >(stuff);
+  const int *COIN_RESTRICT row = info->row;
+  const CoinBigIndex *COIN_RESTRICT columnStart = info->columnStart;
+  const int *COIN_RESTRICT columnLength = info->columnLength;
+  const double *COIN_RESTRICT elementByColumn = info->elementByColumn;
+  const double *COIN_RESTRICT columnLower = info->columnLower;
+  const double *COIN_RESTRICT columnUpper = info->columnUpper;
+  const double *COIN_RESTRICT rowScale = info->rowScale;
+  double *COIN_RESTRICT columnScale = info->columnScale;
+  double overallLargest = info->overallLargest;
+  double overallSmallest = info->reduce[iThread].smallest;
+  for (int iColumn = first; iColumn < last; iColumn++) {
+    if (columnUpper[iColumn] > columnLower[iColumn] + 1.0e-12) {
+      double largest = 1.0e-20;
+      double smallest = 1.0e50;
+      for (CoinBigIndex j = columnStart[iColumn];
+           j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+        int iRow = row[j];
+        double value = fabs(elementByColumn[j] * rowScale[iRow]);
+        largest = CoinMax(largest, value);
+        smallest = CoinMin(smallest, value);
+      }
+      columnScale[iColumn] = overallLargest / largest;
+#ifdef RANDOMIZE
+      columnScale[iColumn] *= info->randomFactor[iColumn];
+#endif
+      double difference = columnUpper[iColumn] - columnLower[iColumn];
+      if (difference < 1.0e-5 * columnScale[iColumn]) {
+        // make gap larger
+        columnScale[iColumn] = difference / 1.0e-5;
+      }
+      double value = smallest * columnScale[iColumn];
+      if (overallSmallest > value)
+        overallSmallest = value;
+    } else {
+      columnScale[iColumn] = 1.0;
+    }
+  }
+  info->reduce[iThread].smallest = overallSmallest;
+}
+// Scale row copy in place
+static void clpScaleRowCopy(void *stuff, int first, int last, int)
+{
+  clpScaleInfo *info = reinterpret_cast< clpScaleInfo * >(stuff);
+  const int *COIN_RESTRICT column = info->column;
+  const CoinBigIndex *COIN_RESTRICT rowStart = info->rowStart;
+  double *COIN_RESTRICT element = info->element;
+  const double *COIN_RESTRICT rowScale = info->rowScale;
+  const double *COIN_RESTRICT columnScale = info->columnScale;
+  for (int iRow = first; iRow < last; iRow++) {
+    double scale = rowScale[iRow];
+    for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow + 1]; j++) {
+      int iColumn = column[j];
+      element[j] *= scale * columnScale[iColumn];
+    }
+  }
+}
+// Copy column copy (without gaps) scaling as we go
+static void clpScaleColumnCopy(void *stuff, int first, int last, int)
+{
+  clpScaleInfo *info = reinterpret_cast< clpScaleInfo * >(stuff);
+  const int *COIN_RESTRICT row = info->row;
+  const CoinBigIndex *COIN_RESTRICT columnStart = info->columnStart;
+  const int *COIN_RESTRICT columnLength = info->columnLength;
+  const double *COIN_RESTRICT elementByColumn = info->elementByColumn;
+  const CoinBigIndex *COIN_RESTRICT newStart = info->newStart;
+  int *COIN_RESTRICT newRow = info->newRow;
+  double *COIN_RESTRICT newElement = info->newElement;
+  const double *COIN_RESTRICT rowScale = info->rowScale;
+  const double *COIN_RESTRICT columnScale = info->columnScale;
+  for (int iColumn = first; iColumn < last; iColumn++) {
+    double scale = columnScale[iColumn];
+    CoinBigIndex put = newStart[iColumn];
+    CoinBigIndex start = columnStart[iColumn];
+    CoinBigIndex end = start + columnLength[iColumn];
+    for (CoinBigIndex j = start; j < end; j++) {
+      int iRow = row[j];
+      newRow[put] = iRow;
+      newElement[put++] = elementByColumn[j] * scale * rowScale[iRow];
+    }
+  }
+}
+/* Scaled column copy without gaps - made in one pass rather than
+   copying and then scaling */
+static CoinPackedMatrix *clpScaledColumnCopy(const CoinPackedMatrix *matrix,
+  const double *rowScale, const double *columnScale)
+{
+  int numberColumns = matrix->getNumCols();
+  const int *columnLength = matrix->getVectorLengths();
+  CoinBigIndex *newStart = new CoinBigIndex[numberColumns + 1];
+  int *newLength = CoinCopyOfArray(columnLength, numberColumns);
+  newStart[0] = 0;
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+    newStart[iColumn + 1] = newStart[iColumn] + columnLength[iColumn];
+  CoinBigIndex numberElements = newStart[numberColumns];
+  clpScaleInfo info;
+  info.row = matrix->getIndices();
+  info.columnStart = matrix->getVectorStarts();
+  info.columnLength = columnLength;
+  info.elementByColumn = matrix->getElements();
+  info.newRow = new int[numberElements];
+  info.newStart = newStart;
+  info.newElement = new double[numberElements];
+  info.rowScale = const_cast< double * >(rowScale);
+  info.columnScale = const_cast< double * >(columnScale);
+  clpScaleFor(numberColumns, clpScaleColumnCopy, info);
+  CoinPackedMatrix *scaledMatrix = new CoinPackedMatrix();
+  // matrix takes ownership
+  scaledMatrix->assignMatrix(true, matrix->getNumRows(), numberColumns,
+    numberElements, info.newElement, info.newRow, newStart, newLength);
+  return scaledMatrix;
+}
 //static int scale_stats[5]={0,0,0,0,0};
 // Creates scales for column copy (rowCopy in model may be modified)
 int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
@@ -4240,6 +4629,19 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
 #endif
     usefulColumn[iColumn] = useful;
     if (deleteSome) {
+      if (flags_ & 64) {
+        // can't change caller's arrays - copy (which may itself
+        // drop small elements and pack) and scan again from start
+        const_cast< ClpPackedMatrix * >(this)->ownArrays();
+        row = matrix_->getMutableIndices();
+        columnStart = matrix_->getVectorStarts();
+        columnLength = matrix_->getMutableVectorLengths();
+        elementByColumn = matrix_->getMutableElements();
+        largest = 0.0;
+        smallest = 1.0e50;
+        iColumn = -1;
+        continue;
+      }
       CoinBigIndex put = start;
       for (j = start; j < end; j++) {
         double value = elementByColumn[j];
@@ -4308,6 +4710,19 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
     const int *COIN_RESTRICT column = rowCopy->getIndices();
     const CoinBigIndex *COIN_RESTRICT rowStart = rowCopy->getVectorStarts();
     const double *COIN_RESTRICT element = rowCopy->getElements();
+    clpScaleInfo info;
+    info.row = row;
+    info.columnStart = columnStart;
+    info.columnLength = columnLength;
+    info.elementByColumn = elementByColumn;
+    info.column = column;
+    info.rowStart = rowStart;
+    info.element = const_cast< double * >(element);
+    info.usefulColumn = usefulColumn;
+    info.columnLower = columnLower;
+    info.columnUpper = columnUpper;
+    info.rowScale = rowScale;
+    info.columnScale = columnScale;
     // need to scale
     if (largest > 1.0e13 * smallest) {
       // safer to have smaller zero tolerance
@@ -4349,25 +4764,16 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
       ClpFillN(columnScale, numberColumns, 1.0);
       if (scalingMethod == 1 || scalingMethod == 3) {
         // Maximum in each row
-        for (iRow = 0; iRow < numberRows; iRow++) {
-          CoinBigIndex j;
-          largest = 1.0e-10;
-          for (j = rowStart[iRow]; j < rowStart[iRow + 1]; j++) {
-            int iColumn = column[j];
-            if (usefulColumn[iColumn]) {
-              double value = fabs(element[j]);
-              largest = CoinMax(largest, value);
-              assert(largest < 1.0e40);
-            }
-          }
-          rowScale[iRow] = 1.0 / largest;
 #ifdef COIN_DEVELOP
-          if (extraDetails) {
-            overallLargest = CoinMax(overallLargest, largest);
-            overallSmallest = CoinMin(overallSmallest, largest);
-          }
+        info.extraDetails = extraDetails;
+#else
+        info.extraDetails = false;
+#endif
+        clpScaleFor(numberRows, clpScaleRowMaximum, info);
+#ifdef COIN_DEVELOP
+        if (extraDetails)
+          clpScaleReduced(info, overallLargest, overallSmallest);
 #endif
-        }
       } else {
 #ifdef USE_OBJECTIVE
         // This will be used to help get scale factors
@@ -4380,31 +4786,10 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
           overallSmallest = 1.0e50;
           numberPass--;
           // Geometric mean on row scales
-          for (iRow = 0; iRow < numberRows; iRow++) {
-            CoinBigIndex j;
-            largest = 1.0e-50;
-            smallest = 1.0e50;
-            for (j = rowStart[iRow]; j < rowStart[iRow + 1]; j++) {
-              int iColumn = column[j];
-              if (usefulColumn[iColumn]) {
-                double value = fabs(element[j]);
-                value *= columnScale[iColumn];
-                largest = CoinMax(largest, value);
-                smallest = CoinMin(smallest, value);
-              }
-            }
-
-#ifdef SQRT_ARRAY
-            rowScale[iRow] = smallest * largest;
-#else
-            rowScale[iRow] = 1.0 / sqrt(smallest * largest);
-#endif
-            //rowScale[iRow]=CoinMax(1.0e-10,CoinMin(1.0e10,rowScale[iRow]));
-            if (extraDetails) {
-              overallLargest = CoinMax(largest * rowScale[iRow], overallLargest);
-              overallSmallest = CoinMin(smallest * rowScale[iRow], overallSmallest);
-            }
-          }
+          info.extraDetails = extraDetails;
+          clpScaleFor(numberRows, clpScaleRowGeometric, info);
+          if (extraDetails)
+            clpScaleReduced(info, overallLargest, overallSmallest);
           if (model->scalingFlag() == 5)
             break; // just scale rows
 #ifdef SQRT_ARRAY
@@ -4431,6 +4816,9 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
           if (numberPass == 1)
             break;
           // Geometric mean on column scales
+#ifndef USE_OBJECTIVE
+          clpScaleFor(numberColumns, clpScaleColumnGeometric, info);
+#else
           for (iColumn = 0; iColumn < numberColumns; iColumn++) {
             if (usefulColumn[iColumn]) {
               CoinBigIndex j;
@@ -4444,21 +4832,19 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
                 largest = CoinMax(largest, value);
                 smallest = CoinMin(smallest, value);
               }
-#ifdef USE_OBJECTIVE
               if (fabs(objective[iColumn]) > 1.0e-20) {
                 double value = fabs(objective[iColumn]) * objScale;
                 largest = CoinMax(largest, value);
                 smallest = CoinMin(smallest, value);
               }
-#endif
 #ifdef SQRT_ARRAY
               columnScale[iColumn] = smallest * largest;
 #else
               columnScale[iColumn] = 1.0 / sqrt(smallest * largest);
 #endif
-              //columnScale[iColumn]=CoinMax(1.0e-10,CoinMin(1.0e10,columnScale[iColumn]));
             }
           }
+#endif
 #ifdef SQRT_ARRAY
           doSqrts(columnScale, numberColumns);
 #endif
@@ -4484,22 +4870,9 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
       // See what smallest will be if largest is 1.0
       if (model->scalingFlag() != 5) {
         overallSmallest = 1.0e50;
-        for (iColumn = 0; iColumn < numberColumns; iColumn++) {
-          if (usefulColumn[iColumn]) {
-            CoinBigIndex j;
-            largest = 1.0e-20;
-            smallest = 1.0e50;
-            for (j = columnStart[iColumn];
-                 j < columnStart[iColumn] + columnLength[iColumn]; j++) {
-              iRow = row[j];
-              double value = fabs(elementByColumn[j] * rowScale[iRow]);
-              largest = CoinMax(largest, value);
-              smallest = CoinMin(smallest, value);
-            }
-            if (overallSmallest * largest > smallest)
-              overallSmallest = smallest / largest;
-          }
-        }
+        clpScaleFor(numberColumns, clpScaleColumnRatio, info);
+        double dummy = 0.0;
+        clpScaleReduced(info, dummy, overallSmallest);
       }
       if (scalingMethod == 1 || scalingMethod == 2) {
         finished = true;
@@ -4551,45 +4924,28 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
     overallLargest = CoinMin(100.0, overallLargest);
     overallSmallest = 1.0e50;
     char *usedRow = reinterpret_cast< char * >(inverseRowScale);
-    memset(usedRow, 0, numberRows);
     //printf("scaling %d\n",model->scalingFlag());
     if (model->scalingFlag() != 5) {
+      info.usedRow = usedRow;
+      clpScaleFor(numberRows, clpScaleUsedRows, info);
+      info.overallLargest = overallLargest;
+#ifdef RANDOMIZE
+      // randomize by up to 10% - same sequence as when done in column loop
+      double *randomFactor = new double[numberColumns];
       for (iColumn = 0; iColumn < numberColumns; iColumn++) {
         if (columnUpper[iColumn] > columnLower[iColumn] + 1.0e-12) {
-          //if (usefulColumn[iColumn]) {
-          CoinBigIndex j;
-          largest = 1.0e-20;
-          smallest = 1.0e50;
-          for (j = columnStart[iColumn];
-               j < columnStart[iColumn] + columnLength[iColumn]; j++) {
-            iRow = row[j];
-            usedRow[iRow] = 1;
-            double value = fabs(elementByColumn[j] * rowScale[iRow]);
-            largest = CoinMax(largest, value);
-            smallest = CoinMin(smallest, value);
-          }
-          columnScale[iColumn] = overallLargest / largest;
-          //columnScale[iColumn]=CoinMax(1.0e-10,CoinMin(1.0e10,columnScale[iColumn]));
-#ifdef RANDOMIZE
           double value = 0.5 - randomNumberGenerator_.randomDouble(); //between -0.5 to + 0.5
-          columnScale[iColumn] *= (1.0 + 0.1 * value);
-#endif
-          double difference = columnUpper[iColumn] - columnLower[iColumn];
-          if (difference < 1.0e-5 * columnScale[iColumn]) {
-            // make gap larger
-            columnScale[iColumn] = difference / 1.0e-5;
-            //printf("Column %d difference %g scaled diff %g => %g\n",iColumn,difference,
-            // scaledDifference,difference*columnScale[iColumn]);
-          }
-          double value = smallest * columnScale[iColumn];
-          if (overallSmallest > value)
-            overallSmallest = value;
-          //overallSmallest = CoinMin(overallSmallest,smallest*columnScale[iColumn]);
-        } else {
-          //assert(columnScale[iColumn] == 1.0);
-          columnScale[iColumn] = 1.0;
+          randomFactor[iColumn] = 1.0 + 0.1 * value;
         }
       }
+      info.randomFactor = randomFactor;
+#endif
+      clpScaleFor(numberColumns, clpScaleColumnFinal, info);
+#ifdef RANDOMIZE
+      delete[] randomFactor;
+#endif
+      double dummy = 0.0;
+      clpScaleReduced(info, dummy, overallSmallest);
       for (iRow = 0; iRow < numberRows; iRow++) {
         if (!usedRow[iRow]) {
           rowScale[iRow] = 1.0;
@@ -4718,46 +5074,18 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
     if (model->rowCopy()) {
       // need to replace row by row
       ClpPackedMatrix *rowCopy = static_cast< ClpPackedMatrix * >(model->rowCopy());
-      double *COIN_RESTRICT element = rowCopy->getMutableElements();
-      const int *COIN_RESTRICT column = rowCopy->getIndices();
-      const CoinBigIndex *COIN_RESTRICT rowStart = rowCopy->getVectorStarts();
       // scale row copy
-      for (iRow = 0; iRow < numberRows; iRow++) {
-        CoinBigIndex j;
-        double scale = rowScale[iRow];
-        double *COIN_RESTRICT elementsInThisRow = element + rowStart[iRow];
-        const int *COIN_RESTRICT columnsInThisRow = column + rowStart[iRow];
-        int number = static_cast< int >(rowStart[iRow + 1] - rowStart[iRow]);
-        assert(number <= numberColumns);
-        for (j = 0; j < number; j++) {
-          int iColumn = columnsInThisRow[j];
-          elementsInThisRow[j] *= scale * columnScale[iColumn];
-        }
-      }
+      info.column = rowCopy->getIndices();
+      info.rowStart = rowCopy->getVectorStarts();
+      info.element = rowCopy->getMutableElements();
+      clpScaleFor(numberRows, clpScaleRowCopy, info);
       if ((model->specialOptions() & 262144) != 0) {
         //if ((model->specialOptions()&(COIN_CBC_USING_CLP|16384))!=0) {
         //if (model->inCbcBranchAndBound()&&false) {
-        // copy without gaps
-        CoinPackedMatrix *scaledMatrix = new CoinPackedMatrix(*matrix_, 0, 0);
+        // copy without gaps (scaled as copied)
+        CoinPackedMatrix *scaledMatrix = clpScaledColumnCopy(matrix_, rowScale, columnScale);
         ClpPackedMatrix *scaled = new ClpPackedMatrix(scaledMatrix);
         model->setClpScaledMatrix(scaled);
-        // get matrix data pointers
-        const int *COIN_RESTRICT row = scaledMatrix->getIndices();
-        const CoinBigIndex *COIN_RESTRICT columnStart = scaledMatrix->getVectorStarts();
-#ifndef NDEBUG
-        const int *COIN_RESTRICT columnLength = scaledMatrix->getVectorLengths();
-#endif
-        double *COIN_RESTRICT elementByColumn = scaledMatrix->getMutableElements();
-        for (iColumn = 0; iColumn < numberColumns; iColumn++) {
-          CoinBigIndex j;
-          double scale = columnScale[iColumn];
-          assert(columnStart[iColumn + 1] == columnStart[iColumn] + columnLength[iColumn]);
-          for (j = columnStart[iColumn];
-               j < columnStart[iColumn + 1]; j++) {
-            int iRow = row[j];
-            elementByColumn[j] *= scale * rowScale[iRow];
-          }
-        }
       } else {
         //printf("not in b&b\n");
       }
@@ -4782,29 +5110,12 @@ void ClpPackedMatrix::createScaledMatrix(ClpSimplex *model) const
   }
   if (!model->rowScale())
     return;
-  double *COIN_RESTRICT rowScale = model->mutableRowScale();
-  double *COIN_RESTRICT columnScale = model->mutableColumnScale();
-  // copy without gaps
-  CoinPackedMatrix *scaledMatrix = new CoinPackedMatrix(*matrix_, 0, 0);
+  const double *COIN_RESTRICT rowScale = model->rowScale();
+  const double *COIN_RESTRICT columnScale = model->columnScale();
+  // copy without gaps (scaled as copied)
+  CoinPackedMatrix *scaledMatrix = clpScaledColumnCopy(matrix_, rowScale, columnScale);
   ClpPackedMatrix *scaled = new ClpPackedMatrix(scaledMatrix);
   model->setClpScaledMatrix(scaled);
-  // get matrix data pointers
-  const int *COIN_RESTRICT row = scaledMatrix->getIndices();
-  const CoinBigIndex *COIN_RESTRICT columnStart = scaledMatrix->getVectorStarts();
-#ifndef NDEBUG
-  const int *COIN_RESTRICT columnLength = scaledMatrix->getVectorLengths();
-#endif
-  double *COIN_RESTRICT elementByColumn = scaledMatrix->getMutableElements();
-  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
-    CoinBigIndex j;
-    double scale = columnScale[iColumn];
-    assert(columnStart[iColumn + 1] == columnStart[iColumn] + columnLength[iColumn]);
-    for (j = columnStart[iColumn];
-         j < columnStart[iColumn + 1]; j++) {
-      int iRow = row[j];
-      elementByColumn[j] *= scale * rowScale[iRow];
-    }
-  }
 #ifdef DO_CHECK_FLAGS
   checkFlags(0);
 #endif
@@ -5087,6 +5398,8 @@ bool ClpPackedMatrix::allElementsInRange(ClpModel *model,
     model->messageHandler()->message(CLP_DUPLICATEELEMENTS, model->messages())
       << numberDuplicate
       << CoinMessageEol;
+  if (numberDuplicate || numberSmall)
+    ownArrays();
   if (numberDuplicate)
     matrix_->eliminateDuplicates(smallest);
   else if (numberSmall)
@@ -5553,7 +5866,8 @@ void ClpPackedMatrix::clearCopies()
   delete columnCopy_;
   rowCopy_ = NULL;
   columnCopy_ = NULL;
-  flags_ &= ~(4 + 8);
+  // matrix may have been reallocated
+  flags_ &= ~(4 + 8 + 128);
   checkGaps();
 #ifdef DO_CHECK_FLAGS
   checkFlags(0);
@@ -5595,9 +5909,6 @@ void ClpPackedMatrix::scaleRowCopy(ClpModel *model) const
   if (model->rowCopy()) {
     // need to replace row by row
     int numberRows = model->numberRows();
-#ifndef NDEBUG
-    int numberColumns = matrix_->getNumCols();
-#endif
     ClpMatrixBase *rowCopyBase = model->rowCopy();
 #ifndef NDEBUG
     ClpPackedMatrix *rowCopy = dynamic_cast< ClpPackedMatrix * >(rowCopyBase);
@@ -5607,24 +5918,14 @@ void ClpPackedMatrix::scaleRowCopy(ClpModel *model) const
     ClpPackedMatrix *rowCopy = static_cast< ClpPackedMatrix * >(rowCopyBase);
 #endif
 
-    const int *COIN_RESTRICT column = rowCopy->getIndices();
-    const CoinBigIndex *COIN_RESTRICT rowStart = rowCopy->getVectorStarts();
-    double *COIN_RESTRICT element = rowCopy->getMutableElements();
-    const double *COIN_RESTRICT rowScale = model->rowScale();
-    const double *COIN_RESTRICT columnScale = model->columnScale();
     // scale row copy
-    for (int iRow = 0; iRow < numberRows; iRow++) {
-      CoinBigIndex j;
-      double scale = rowScale[iRow];
-      double *COIN_RESTRICT elementsInThisRow = element + rowStart[iRow];
-      const int *COIN_RESTRICT columnsInThisRow = column + rowStart[iRow];
-      int number = static_cast< int >(rowStart[iRow + 1] - rowStart[iRow]);
-      assert(number <= numberColumns);
-      for (j = 0; j < number; j++) {
-        int iColumn = columnsInThisRow[j];
-        elementsInThisRow[j] *= scale * columnScale[iColumn];
-      }
-    }
+    clpScaleInfo info;
+    info.column = rowCopy->getIndices();
+    info.rowStart = rowCopy->getVectorStarts();
+    info.element = rowCopy->getMutableElements();
+    info.rowScale = const_cast< double * >(model->rowScale());
+    info.columnScale = const_cast< double * >(model->columnScale());
+    clpScaleFor(numberRows, clpScaleRowCopy, info);
   }
 }
 /* Realy really scales column copy
@@ -5664,6 +5965,7 @@ ClpPackedMatrix::scaledColumnCopy(ClpModel *model) const
 void ClpPackedMatrix::reallyScale(const double *rowScale, const double *columnScale)
 {
   clearCopies();
+  ownArrays();
   int numberColumns = matrix_->getNumCols();
   const int *row = matrix_->getIndices();
   const CoinBigIndex *columnStart = matrix_->getVectorStarts();
@@ -5682,6 +5984,7 @@ void ClpPackedMatrix::reallyScale(const double *rowScale, const double *columnSc
 /* Delete the columns whose indices are listed in <code>indDel</code>. */
 void ClpPackedMatrix::deleteCols(const int numDel, const int *indDel)
 {
+  ownArrays();
   if (matrix_->getNumCols())
     matrix_->deleteCols(numDel, indDel);
   clearCopies();
@@ -5696,6 +5999,7 @@ void ClpPackedMatrix::deleteCols(const int numDel, const int *indDel)
 /* Delete the rows whose indices are listed in <code>indDel</code>. */
 void ClpPackedMatrix::deleteRows(const int numDel, const int *indDel)
 {
+  ownArrays();
   if (matrix_->getNumRows())
     matrix_->deleteRows(numDel, indDel);
   clearCopies();
@@ -5711,6 +6015,7 @@ void ClpPackedMatrix::deleteRows(const int numDel, const int *indDel)
 // Append Columns
 void ClpPackedMatrix::appendCols(int number, const CoinPackedVectorBase *const *columns)
 {
+  ownArrays();
   matrix_->appendCols(number, columns);
   numberActiveColumns_ = matrix_->getNumCols();
   clearCopies();
@@ -5718,6 +6023,7 @@ void ClpPackedMatrix::appendCols(int number, const CoinPackedVectorBase *const *
 // Append Rows
 void ClpPackedMatrix::appendRows(int number, const CoinPackedVectorBase *const *rows)
 {
+  ownArrays();
   matrix_->appendRows(number, rows);
   numberActiveColumns_ = matrix_->getNumCols();
   // may now have gaps
@@ -5735,6 +6041,9 @@ void ClpPackedMatrix::appendRows(int number, const CoinPackedVectorBase *const *
    is thrown. */
 void ClpPackedMatrix::setDimensions(int numrows, int numcols)
 {
+  // more columns means new starts
+  if (numcols > matrix_->getNumCols())
+    ownArrays();
   matrix_->setDimensions(numrows, numcols);
 #ifdef DO_CHECK_FLAGS
   checkFlags(0);
@@ -5749,6 +6058,7 @@ int ClpPackedMatrix::appendMatrix(int number, int type,
   const double *element, int numberOther)
 {
   int numberErrors = 0;
+  ownArrays();
   // make sure other dimension is big enough
   if (type == 0) {
     // rows
@@ -5808,6 +6118,96 @@ void ClpPackedMatrix::specialColumnCopy(ClpSimplex *model)
     columnCopy_ = NULL;
   }
 }
+#if ABOCA_LITE
+#ifndef CLP_NUMA_ELEMENTS
+#define CLP_NUMA_ELEMENTS 1000000
+#endif
+// Copies a chunk of vectors so pages are first touched by this thread
+static void placeBit(clpTempInfo &info)
+{
+  const CoinBigIndex *COIN_RESTRICT start = info.start;
+  int first = info.startColumn;
+  int last = first + info.numberToDo;
+  if (first < last) {
+    CoinBigIndex startElement = start[first];
+    CoinBigIndex endElement = start[last];
+    CoinMemcpyN(info.row + startElement, endElement - startElement,
+      info.which + startElement);
+    CoinMemcpyN(info.element + startElement, endElement - startElement,
+      info.spare + startElement);
+  }
+}
+#endif
+/* Reallocate elements and indices so pages are first touched by
+   the threads which will use them in pricing */
+void ClpPackedMatrix::placeForThreads()
+{
+#if ABOCA_LITE
+  if (flags_ & 128)
+    return; // already done
+  int numberThreads = abcState();
+  CoinBigIndex numberElements = matrix_->getNumElements();
+  if (numberThreads < 2 || numberElements < CLP_NUMA_ELEMENTS || matrix_->hasGaps())
+    return;
+  int numberMajor = matrix_->getMajorDim();
+  const CoinBigIndex *start = matrix_->getVectorStarts();
+  // new [] does not touch pages so first touch will be in placeBit
+  int *newIndex = new int[numberElements];
+  double *newElement = new double[numberElements];
+  // same partition as pricing (which is over active columns)
+  int numberActive = matrix_->isColOrdered() ? numberActiveColumns_ : numberMajor;
+  int chunk = (numberActive + numberThreads - 1) / numberThreads;
+  clpTempInfo info[ABOCA_LITE];
+  int n = 0;
+  for (int i = 0; i < numberThreads; i++) {
+    info[i].start = start;
+    info[i].row = matrix_->getIndices();
+    info[i].element = matrix_->getElements();
+    info[i].which = newIndex;
+    info[i].spare = newElement;
+    info[i].startColumn = CoinMin(n, numberMajor);
+    if (i < numberThreads - 1)
+      info[i].numberToDo = CoinMax(CoinMin(chunk, numberMajor - n), 0);
+    else
+      info[i].numberToDo = CoinMax(numberMajor - n, 0);
+    n += chunk;
+  }
+  for (int i = 0; i < numberThreads; i++) {
+    cilk_spawn placeBit(info[i]);
+  }
+  cilk_sync;
+  CoinBigIndex *newStart = CoinCopyOfArray(start, numberMajor + 1);
+  int *newLength = CoinCopyOfArray(matrix_->getVectorLengths(), numberMajor);
+  // new arrays are ours so caller can have theirs back
+  if (flags_ & 64)
+    releaseBorrowed();
+  // matrix takes ownership
+  matrix_->assignMatrix(matrix_->isColOrdered(), matrix_->getMinorDim(),
+    numberMajor, numberElements, newElement, newIndex, newStart, newLength);
+  flags_ |= 128;
+#endif
+}
+// Makes own copy of arrays if borrowed
+void ClpPackedMatrix::ownArrays()
+{
+  if (flags_ & 64) {
+    CoinPackedMatrix *copy = new CoinPackedMatrix(*matrix_, -1, 0);
+    releaseBorrowed();
+    delete matrix_;
+    matrix_ = copy;
+    flags_ &= ~128;
+  }
+}
+// Gives borrowed arrays back to caller
+void ClpPackedMatrix::releaseBorrowed()
+{
+  assert((flags_ & 64) != 0);
+  // lengths were created in constructor
+  int *columnLength = matrix_->getMutableVectorLengths();
+  matrix_->releasePackedMatrix();
+  delete[] columnLength;
+  flags_ &= ~64;
+}
 // Say we don't want special column copy
 void ClpPackedMatrix::releaseSpecialColumnCopy()
 {
@@ -112,6 +112,7 @@ public:
   virtual void replaceVector(const int index,
     const int numReplace, const double *newElements)
   {
+    ownArrays();
     matrix_->replaceVector(index, numReplace, newElements);
   }
   /** Modify one element of packed matrix.  An element may be added.
@@ -120,7 +121,9 @@ public:
   virtual void modifyCoefficient(int row, int column, double newElement,
     bool keepZero = false)
   {
+    ownArrays();
     matrix_->modifyCoefficient(row, column, newElement, keepZero);
+    flags_ &= ~128; // may have been reallocated
   }
   /** Returns a new matrix in reverse order without gaps */
   virtual ClpMatrixBase *reverseOrderedCopy() const;
@@ -343,6 +346,14 @@ public:
   {
     return ((flags_ & 16) != 0);
   }
+  /// Are arrays borrowed from caller
+  inline bool borrowed() const
+  {
+    return ((flags_ & 64) != 0);
+  }
+  /** Makes own copy of arrays if borrowed.
+         Must be called before changing matrix_ in place */
+  void ownArrays();
   /// Flags
   inline int flags() const
   {
@@ -390,6 +401,11 @@ public:
 
   /** This takes over ownership (for space reasons) */
   ClpPackedMatrix(CoinPackedMatrix *matrix);
+  /** This borrows caller's column ordered arrays (without gaps) so
+         there is no copy.  They must stay valid and unchanged while used.
+         If Clp has to change matrix in place it first makes its own copy */
+  ClpPackedMatrix(int numberRows, int numberColumns,
+    const CoinBigIndex *start, const int *index, const double *element);
 
   ClpPackedMatrix &operator=(const ClpPackedMatrix &);
   /// Clone
@@ -405,6 +421,11 @@ public:
   void specialRowCopy(ClpSimplex *model, const ClpMatrixBase *rowCopy);
   /// make special column copy
   void specialColumnCopy(ClpSimplex *model);
+  /** Reallocate elements and indices so pages are first touched by
+      the threads which will use them in pricing (for NUMA machines).
+      Does nothing unless threaded (ABOCA_LITE) and matrix large
+      or if already done since matrix last changed. */
+  void placeForThreads();
   /// Correct sequence in and out to give true value
   virtual void correctSequence(const ClpSimplex *model, int &sequenceIn, int &sequenceOut);
   //@}
@@ -481,6 +502,8 @@ private:
 protected:
   /// Check validity
   void checkFlags(int type) const;
+  /// Gives borrowed arrays back to caller (matrix_ left empty)
+  void releaseBorrowed();
   /**@name Data members
         The data members are protected to allow access for derived classes. */
   //@{
@@ -494,6 +517,9 @@ protected:
          4 - has special row copy
          8 - has special column copy
          16 - wants special column copy
+         32 - special column copy is all +1
+         64 - arrays borrowed from caller
+         128 - arrays placed for threads (placeForThreads)
      */
   mutable int flags_;
   /// Special row copy
@@ -148,6 +148,7 @@ public:
       // Keyword Parameters
       FIRSTKWDPARAM,
       ABCWANTED,
+      ABCMEMORY,
       BARRIERSCALE,
       BIASLU,
       CHOLESKY,
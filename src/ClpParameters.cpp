@@ -139,6 +139,7 @@ void ClpParameters::setDefaults(int strategy) {
     case ClpParameters::DefaultStrategy:
 #if CLP_HAS_ABC
       parameters_[ClpParam::ABCWANTED]->setDefault("off");
+      parameters_[ClpParam::ABCMEMORY]->setDefault("off");
 #endif
       parameters_[ClpParam::COMMANDPRINTLEVEL]->setDefault("more");
       parameters_[ClpParam::BARRIERSCALE]->setDefault("off");
@@ -910,6 +911,16 @@ void ClpParameters::addClpKwdParams() {
   parameters_[ClpParam::ABCWANTED]->appendKwd("eight");
   parameters_[ClpParam::ABCWANTED]->appendKwd("on");
   parameters_[ClpParam::ABCWANTED]->appendKwd("decide");
+
+  parameters_[ClpParam::ABCMEMORY]->setup(
+      "abcMem!ory", "How Aboca factorization gets memory",
+      "If 'size' then factorization areas are sized from what the last "
+      "factorization used, so fewer reallocations.  If 'huge' then large "
+      "areas are advised to use huge pages (Linux).  'both' does both.");
+  parameters_[ClpParam::ABCMEMORY]->appendKwd("off");
+  parameters_[ClpParam::ABCMEMORY]->appendKwd("size");
+  parameters_[ClpParam::ABCMEMORY]->appendKwd("huge");
+  parameters_[ClpParam::ABCMEMORY]->appendKwd("both");
   paramAboca.setFakeKeyWord(10);
 #endif
 
@@ -944,7 +955,11 @@ void ClpParameters::addClpKwdParams() {
       "For a barrier code to be effective it needs a good Cholesky ordering "
       "and factorization. The native ordering and factorization is not state "
       "of the art, although acceptable. You may want to link in one from "
-      "another source.  See Makefile.locations for some possibilities.");
+      "another source.  See Makefile.locations for some possibilities.  "
+      "pcg does not factorize but uses conjugate gradients on the normal "
+      "equations (going over to native factorization if that struggles).  "
+      "mixed uses the native ordering but a single precision factorization "
+      "with iterative refinement (going over to double if that struggles).");
   parameters_[ClpParam::CHOLESKY]->appendKwd("native");
   parameters_[ClpParam::CHOLESKY]->appendKwd("dense");
 #ifdef CLP_HAS_WSMP
@@ -974,6 +989,8 @@ void ClpParameters::addClpKwdParams() {
 #else
   parameters_[ClpParam::CHOLESKY]->appendKwd("Pardiso_dummy");
 #endif
+  parameters_[ClpParam::CHOLESKY]->appendKwd("pcg");
+  parameters_[ClpParam::CHOLESKY]->appendKwd("mixed");
 
   parameters_[ClpParam::CRASH]->setup(
       "crash", "Whether to create basis for problem", 
@@ -5,9 +5,13 @@
 #include "CoinPragma.hpp"
 
 #include <iostream>
+#include <math.h>
 
+#include "CoinHelperFunctions.hpp"
 #include "ClpPdcoBase.hpp"
 #include "ClpPdco.hpp"
+#include "ClpMatrixBase.hpp"
+#include "ClpTaskPool.hpp"
 
 //#############################################################################
 // Constructors / Destructor / Assignment
@@ -53,6 +57,145 @@ ClpPdcoBase::operator=(const ClpPdcoBase &rhs)
   }
   return *this;
 }
+// Minimum number of columns per chunk if shared ClpTaskPool used
+#ifndef CLP_PDCO_GRAIN
+#define CLP_PDCO_GRAIN 4096
+#endif
+typedef struct {
+  const int *row;
+  const CoinBigIndex *start;
+  const int *length;
+  const double *element;
+  const double *y;
+  double *x;
+  // one vector of rows per thread (or NULL)
+  double *scatter;
+  int numberRows;
+  int numberThreads;
+  bool square;
+} clpPdcoInfo;
+// Does x += A y (or A^2 y^2 if square) for columns [first,last)
+static void clpPdcoTimesRange(void *stuff, int first, int last, int iThread)
+{
+  clpPdcoInfo *info = reinterpret_cast< clpPdcoInfo * >(stuff);
+  const int *COIN_RESTRICT row = info->row;
+  const CoinBigIndex *COIN_RESTRICT columnStart = info->start;
+  const int *COIN_RESTRICT columnLength = info->length;
+  const double *COIN_RESTRICT element = info->element;
+  const double *COIN_RESTRICT y = info->y;
+  double *COIN_RESTRICT x = info->scatter ? info->scatter + iThread * info->numberRows : info->x;
+  if (!info->square) {
+    for (int iColumn = first; iColumn < last; iColumn++) {
+      double value = y[iColumn];
+      if (value) {
+        CoinBigIndex start = columnStart[iColumn];
+        CoinBigIndex end = start + columnLength[iColumn];
+        for (CoinBigIndex j = start; j < end; j++)
+          x[row[j]] += element[j] * value;
+      }
+    }
+  } else {
+    for (int iColumn = first; iColumn < last; iColumn++) {
+      double value = y[iColumn] * y[iColumn];
+      if (value) {
+        CoinBigIndex start = columnStart[iColumn];
+        CoinBigIndex end = start + columnLength[iColumn];
+        for (CoinBigIndex j = start; j < end; j++)
+          x[row[j]] += element[j] * element[j] * value;
+      }
+    }
+  }
+}
+// Adds thread vectors into x for rows [first,last)
+static void clpPdcoAddRange(void *stuff, int first, int last, int)
+{
+  clpPdcoInfo *info = reinterpret_cast< clpPdcoInfo * >(stuff);
+  double *COIN_RESTRICT x = info->x;
+  int numberRows = info->numberRows;
+  for (int iThread = 0; iThread < info->numberThreads; iThread++) {
+    const double *COIN_RESTRICT scatter = info->scatter + iThread * numberRows;
+    for (int iRow = first; iRow < last; iRow++)
+      x[iRow] += scatter[iRow];
+  }
+}
+/* x += A y (or A^2 y^2 if square).  Rows are scattered so threads
+   need a vector each - only worth it if enough elements. */
+static void clpPdcoTimes(const CoinPackedMatrix *matrix, const double *y,
+  double *x, bool square)
+{
+  clpPdcoInfo info;
+  info.row = matrix->getIndices();
+  info.start = matrix->getVectorStarts();
+  info.length = matrix->getVectorLengths();
+  info.element = matrix->getElements();
+  info.y = y;
+  info.x = x;
+  info.scatter = NULL;
+  info.numberRows = matrix->getNumRows();
+  info.numberThreads = 0;
+  info.square = square;
+  int numberColumns = matrix->getNumCols();
+  ClpTaskPool *pool = ClpTaskPool::sharedIfExists();
+  if (pool && pool->numberThreads() && numberColumns >= 2 * CLP_PDCO_GRAIN) {
+    int numberThreads = pool->numberThreads() + 1;
+    if (matrix->getNumElements() >= static_cast< double >(numberThreads) * info.numberRows) {
+      info.numberThreads = numberThreads;
+      info.scatter = new double[numberThreads * info.numberRows];
+      CoinZeroN(info.scatter, numberThreads * info.numberRows);
+    }
+  }
+  if (info.scatter) {
+    pool->parallelFor(0, numberColumns, CLP_PDCO_GRAIN, clpPdcoTimesRange, &info);
+    pool->parallelFor(0, info.numberRows, CLP_PDCO_GRAIN, clpPdcoAddRange, &info);
+    delete[] info.scatter;
+  } else {
+    clpPdcoTimesRange(&info, 0, numberColumns, 0);
+  }
+}
+// mode 1 x += A y, mode 2 x += A' y
+void ClpPdcoBase::matrixVecMult(ClpInterior *model, int mode, double *x, double *y) const
+{
+  ClpMatrixBase *matrix = model->clpMatrix();
+  if (mode == 1) {
+    if (matrix->type() == 1)
+      clpPdcoTimes(matrix->getPackedMatrix(), y, x, false);
+    else
+      matrix->times(1.0, y, x);
+  } else {
+    // columns independent - ClpPackedMatrix splits over pool
+    matrix->transposeTimes(1.0, y, x);
+  }
+}
+// x = 1/sqrt(diag(A Y^2 A') + delta^2)
+void ClpPdcoBase::matrixPrecon(ClpInterior *model, double delta, double *x, double *y) const
+{
+  int numberRows = model->numberRows();
+  CoinZeroN(x, numberRows);
+  ClpMatrixBase *matrix = model->clpMatrix();
+  if (matrix->type() == 1) {
+    clpPdcoTimes(matrix->getPackedMatrix(), y, x, true);
+  } else {
+    // packed copy of other types may be row ordered
+    const CoinPackedMatrix *packed = matrix->getPackedMatrix();
+    const int *index = packed->getIndices();
+    const CoinBigIndex *start = packed->getVectorStarts();
+    const int *length = packed->getVectorLengths();
+    const double *element = packed->getElements();
+    bool columnOrdered = packed->isColOrdered();
+    for (int i = 0; i < packed->getMajorDim(); i++) {
+      for (CoinBigIndex j = start[i]; j < start[i] + length[i]; j++) {
+        double value = element[j] * element[j];
+        if (columnOrdered)
+          x[index[j]] += value * y[i] * y[i];
+        else
+          x[i] += value * y[index[j]] * y[index[j]];
+      }
+    }
+  }
+  double delta2 = delta * delta;
+  for (int iRow = 0; iRow < numberRows; iRow++)
+    x[iRow] = 1.0 / sqrt(x[iRow] + delta2);
+}
 
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
 */
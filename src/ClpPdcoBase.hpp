@@ -73,6 +73,17 @@ public:
     return d2_;
   };
   //@}
+  /**@name Products with matrix in model
+     For derived classes whose matVecMult and matPrecon are just
+     the constraint matrix loaded into model.  Columns are split over
+     the shared ClpTaskPool if big enough.
+  */
+  //@{
+  /// mode 1 x += A y, mode 2 x += A' y
+  void matrixVecMult(ClpInterior *model, int mode, double *x, double *y) const;
+  /// x = 1/sqrt(diag(A Y^2 A') + delta^2)
+  void matrixPrecon(ClpInterior *model, double delta, double *x, double *y) const;
+  //@}
 
 protected:
   /**@name Constructors, destructor<br>
@@ -2201,6 +2201,70 @@ int ClpPlusMinusOneMatrix::appendMatrix(int number, int type,
 }
 #endif
 #if CLP_POOL_MATRIX
+/* Row and pool index share one 32 bit word (row in low CLP_POOL_MATRIX bits)
+   so with AVX2 four entries can be decoded and gathered at a time.
+   Bit field layout is only relied on for gcc/clang */
+#if defined(__AVX2__) && (CLP_POOL_MATRIX == 16 || defined(__GNUC__))
+#define CLP_POOL_GATHER
+#include <immintrin.h>
+#endif
+// Dot product of pi with column held in stuff[start:end]
+static inline double poolDot(const poolInfo *COIN_RESTRICT stuff,
+  const double *COIN_RESTRICT elements,
+  const double *COIN_RESTRICT pi,
+  CoinBigIndex start, CoinBigIndex end)
+{
+  double value = 0.0;
+  double value2 = 0.0;
+  CoinBigIndex j = start;
+#ifdef CLP_POOL_GATHER
+  if (end - start >= 8) {
+    const __m128i rowMask = _mm_set1_epi32((1 << CLP_POOL_MATRIX) - 1);
+    __m256d sum = _mm256_setzero_pd();
+    for (; j + 4 <= end; j += 4) {
+      __m128i packed = _mm_loadu_si128(reinterpret_cast< const __m128i * >(stuff + j));
+      __m128i rows = _mm_and_si128(packed, rowMask);
+      __m128i pools = _mm_srli_epi32(packed, CLP_POOL_MATRIX);
+      __m256d piValue = _mm256_i32gather_pd(pi, rows, 8);
+      __m256d elementValue = _mm256_i32gather_pd(elements, pools, 8);
+      sum = _mm256_add_pd(sum, _mm256_mul_pd(piValue, elementValue));
+    }
+    __m128d sum2 = _mm_add_pd(_mm256_castpd256_pd128(sum),
+      _mm256_extractf128_pd(sum, 1));
+    value = _mm_cvtsd_f64(_mm_add_sd(sum2, _mm_unpackhi_pd(sum2, sum2)));
+  }
+#endif
+  for (; j + 1 < end; j += 2) {
+    value += pi[stuff[j].row_] * elements[stuff[j].pool_];
+    value2 += pi[stuff[j + 1].row_] * elements[stuff[j + 1].pool_];
+  }
+  if (j < end)
+    value += pi[stuff[j].row_] * elements[stuff[j].pool_];
+  return value + value2;
+}
+// Updates steepest/devex weight (as in ClpPackedMatrix::transposeTimes2)
+static inline void poolWeight(int iColumn, double pivot, double modification,
+  double referenceIn, double devex,
+  const unsigned int *COIN_RESTRICT reference,
+  double *COIN_RESTRICT weights)
+{
+  double thisWeight = weights[iColumn];
+  double pivotSquared = pivot * pivot;
+  thisWeight += pivotSquared * devex + pivot * modification;
+  if (thisWeight < DEVEX_TRY_NORM) {
+    if (referenceIn < 0.0) {
+      // steepest
+      thisWeight = CoinMax(DEVEX_TRY_NORM, DEVEX_ADD_ONE + pivotSquared);
+    } else {
+      // exact
+      thisWeight = referenceIn * pivotSquared;
+      if (((reference[iColumn >> 5] >> (iColumn & 31)) & 1) != 0)
+        thisWeight += 1.0;
+      thisWeight = CoinMax(thisWeight, DEVEX_TRY_NORM);
+    }
+  }
+  weights[iColumn] = thisWeight;
+}
 //#############################################################################
 // Constructors / Destructor / Assignment
 //#############################################################################
@@ -2401,8 +2465,12 @@ ClpPoolMatrix::operator=(const ClpPoolMatrix &rhs)
     delete[] stuff_;
     matrix_ = NULL;
     lengths_ = NULL;
+    elements_ = NULL;
+    columnStart_ = NULL;
+    stuff_ = NULL;
     numberRows_ = rhs.numberRows_;
     numberColumns_ = rhs.numberColumns_;
+    numberDifferent_ = rhs.numberDifferent_;
     if (numberColumns_) {
       columnStart_ = CoinCopyOfArray(rhs.columnStart_, numberColumns_ + 1);
       CoinBigIndex numberElements = columnStart_[numberColumns_];
@@ -2634,27 +2702,15 @@ void ClpPoolMatrix::transposeTimes(double scalar,
   CoinBigIndex start = columnStart_[0];
   if (scalar == -1.0) {
     for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-      CoinBigIndex j;
       CoinBigIndex next = columnStart_[iColumn + 1];
-      double value = 0.0;
-      // scaled
-      for (j = start; j < next; j++) {
-        int jRow = stuff_[j].row_;
-        value += x[jRow] * elements_[stuff_[j].pool_];
-      }
+      double value = poolDot(stuff_, elements_, x, start, next);
       start = next;
       y[iColumn] -= value;
     }
   } else {
     for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-      CoinBigIndex j;
       CoinBigIndex next = columnStart_[iColumn + 1];
-      double value = 0.0;
-      // scaled
-      for (j = start; j < next; j++) {
-        int jRow = stuff_[j].row_;
-        value += x[jRow] * elements_[stuff_[j].pool_];
-      }
+      double value = poolDot(stuff_, elements_, x, start, next);
       start = next;
       y[iColumn] += value * scalar;
     }
@@ -2666,8 +2722,22 @@ void ClpPoolMatrix::times(double scalar,
   const double *rowScale,
   const double *columnScale) const
 {
-  printf("createMatrix at file %s line %d\n", __FILE__, __LINE__);
-  createMatrix()->times(scalar, x, y);
+  if (rowScale) {
+    for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+      double value = x[iColumn];
+      if (value) {
+        CoinBigIndex start = columnStart_[iColumn];
+        CoinBigIndex end = columnStart_[iColumn + 1];
+        value *= scalar * columnScale[iColumn];
+        for (CoinBigIndex j = start; j < end; j++) {
+          int iRow = stuff_[j].row_;
+          y[iRow] += value * elements_[stuff_[j].pool_] * rowScale[iRow];
+        }
+      }
+    }
+  } else {
+    times(scalar, x, y);
+  }
 }
 void ClpPoolMatrix::transposeTimes(double scalar,
   const double *COIN_RESTRICT x, double *COIN_RESTRICT y,
@@ -2713,8 +2783,7 @@ void ClpPoolMatrix::transposeTimes(double scalar,
     } else {
       // can use spare region
       int iRow;
-      int numberRows = matrix_->getNumRows();
-      for (iRow = 0; iRow < numberRows; iRow++) {
+      for (iRow = 0; iRow < numberRows_; iRow++) {
         double value = x[iRow];
         if (value)
           spare[iRow] = value * rowScale[iRow];
@@ -2723,14 +2792,8 @@ void ClpPoolMatrix::transposeTimes(double scalar,
       }
       CoinBigIndex start = columnStart_[0];
       for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-        CoinBigIndex j;
         CoinBigIndex next = columnStart_[iColumn + 1];
-        double value = 0.0;
-        // scaled
-        for (j = start; j < next; j++) {
-          int jRow = stuff_[j].row_;
-          value += spare[jRow] * elements_[stuff_[j].pool_];
-        }
+        double value = poolDot(stuff_, elements_, spare, start, next);
         start = next;
         y[iColumn] += value * scalar * columnScale[iColumn];
       }
@@ -2747,12 +2810,6 @@ void ClpPoolMatrix::transposeTimes(const ClpSimplex *model, double scalar,
   CoinIndexedVector *y,
   CoinIndexedVector *columnArray) const
 {
-#if 0
-  bool packed = rowArray->packedMode();
-  assert (packed);
-  printf("CcreateMatrix at file %s line %d\n",__FILE__,__LINE__);
-  createMatrix()->transposeTimes(model,scalar,rowArray,y,columnArray);
-#else
   columnArray->clear();
   // do by column
   double *COIN_RESTRICT pi = rowArray->denseVector();
@@ -2773,6 +2830,7 @@ void ClpPoolMatrix::transposeTimes(const ClpSimplex *model, double scalar,
   pi = y->denseVector();
   const int *COIN_RESTRICT whichRow = rowArray->getIndices();
   int i;
+  int iColumn;
   // later combine phases
   if (!rowScale) {
     // modify pi so can collapse to one loop
@@ -2780,30 +2838,86 @@ void ClpPoolMatrix::transposeTimes(const ClpSimplex *model, double scalar,
       int iRow = whichRow[i];
       pi[iRow] = scalar * piOld[i];
     }
-    double value = 0.0;
-    CoinBigIndex j;
-    CoinBigIndex end = columnStart_[1];
-    for (j = columnStart_[0]; j < end; j++) {
-      int iRow = stuff_[j].row_;
-      value += pi[iRow] * elements_[stuff_[j].pool_];
-    }
-    int iColumn;
-    for (iColumn = 0; iColumn < numberColumns_ - 1; iColumn++) {
-      CoinBigIndex start = end;
-      end = columnStart_[iColumn + 2];
-      if (fabs(value) > zeroTolerance) {
-        array[numberNonZero] = value;
-        index[numberNonZero++] = iColumn;
+    if (model->spareIntArray_[0] > 0 && scalar == -1.0
+      && (model->moreSpecialOptions() & 8) != 0 && model->algorithm() < 0) {
+      // also do first pass of dual ratio test (as ClpPackedMatrix)
+      CoinIndexedVector *spareArray = model->rowArray(3);
+      double *COIN_RESTRICT spare = spareArray->denseVector();
+      int *COIN_RESTRICT spareIndex = spareArray->getIndices();
+      const unsigned char *COIN_RESTRICT statusArray = model->statusArray();
+      double multiplier[] = { -1.0, 1.0 };
+      double dualT = -model->currentDualTolerance();
+      double acceptablePivot = model->spareDoubleArray_[0];
+      // We can also see if infeasible or pivoting on free
+      double tentativeTheta = 1.0e15;
+      double upperTheta = 1.0e31;
+      int numberRemaining = 0;
+      // slacks first
+      int addSequence = numberColumns_;
+      const double *COIN_RESTRICT reducedCost = model->djRegion(0);
+      for (i = 0; i < numberInRowArray; i++) {
+        int iSequence = whichRow[i];
+        int iStatus = (statusArray[iSequence + addSequence] & 3) - 1;
+        if (iStatus) {
+          double mult = multiplier[iStatus - 1];
+          double alpha = piOld[i] * mult;
+          if (alpha > 0.0) {
+            double oldValue = reducedCost[iSequence] * mult;
+            double value = oldValue - tentativeTheta * alpha;
+            if (value < dualT) {
+              value = oldValue - upperTheta * alpha;
+              if (value < dualT && alpha >= acceptablePivot) {
+                upperTheta = (oldValue - dualT) / alpha;
+              }
+              // add to list
+              spare[numberRemaining] = alpha * mult;
+              spareIndex[numberRemaining++] = iSequence + addSequence;
+            }
+          }
+        }
       }
-      value = 0.0;
-      for (j = start; j < end; j++) {
-        int iRow = stuff_[j].row_;
-        value += pi[iRow] * elements_[stuff_[j].pool_];
+      reducedCost = model->djRegion(1);
+      for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
+        int wanted = (statusArray[iColumn] & 3) - 1;
+        if (wanted) {
+          double value = poolDot(stuff_, elements_, pi,
+            columnStart_[iColumn], columnStart_[iColumn + 1]);
+          if (fabs(value) > zeroTolerance) {
+            double mult = multiplier[wanted - 1];
+            double alpha = value * mult;
+            array[numberNonZero] = value;
+            index[numberNonZero++] = iColumn;
+            if (alpha > 0.0) {
+              double oldValue = reducedCost[iColumn] * mult;
+              double value = oldValue - tentativeTheta * alpha;
+              if (value < dualT) {
+                value = oldValue - upperTheta * alpha;
+                if (value < dualT && alpha >= acceptablePivot) {
+                  upperTheta = (oldValue - dualT) / alpha;
+                }
+                // add to list
+                spare[numberRemaining] = alpha * mult;
+                spareIndex[numberRemaining++] = iColumn;
+              }
+            }
+          }
+        }
+      }
+      model->spareDoubleArray_[0] = upperTheta;
+      spareArray->setNumElements(numberRemaining);
+      // signal partially done
+      model->spareIntArray_[0] = -2;
+    } else {
+      CoinBigIndex start = columnStart_[0];
+      for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
+        CoinBigIndex end = columnStart_[iColumn + 1];
+        double value = poolDot(stuff_, elements_, pi, start, end);
+        start = end;
+        if (fabs(value) > zeroTolerance) {
+          array[numberNonZero] = value;
+          index[numberNonZero++] = iColumn;
+        }
       }
-    }
-    if (fabs(value) > zeroTolerance) {
-      array[numberNonZero] = value;
-      index[numberNonZero++] = iColumn;
     }
   } else {
     // scaled
@@ -2812,35 +2926,17 @@ void ClpPoolMatrix::transposeTimes(const ClpSimplex *model, double scalar,
       int iRow = whichRow[i];
       pi[iRow] = scalar * piOld[i] * rowScale[iRow];
     }
-    const double *columnScale = model->columnScale();
-    double value = 0.0;
-    double scale = columnScale[0];
-    CoinBigIndex j;
-    CoinBigIndex end = columnStart_[1];
-    for (j = columnStart_[0]; j < end; j++) {
-      int iRow = stuff_[j].row_;
-      value += pi[iRow] * elements_[stuff_[j].pool_];
-    }
-    int iColumn;
-    for (iColumn = 0; iColumn < numberColumns_ - 1; iColumn++) {
-      value *= scale;
-      CoinBigIndex start = end;
-      scale = columnScale[iColumn + 1];
-      end = columnStart_[iColumn + 2];
+    const double *COIN_RESTRICT columnScale = model->columnScale();
+    CoinBigIndex start = columnStart_[0];
+    for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
+      CoinBigIndex end = columnStart_[iColumn + 1];
+      double value = poolDot(stuff_, elements_, pi, start, end);
+      start = end;
+      value *= columnScale[iColumn];
       if (fabs(value) > zeroTolerance) {
         array[numberNonZero] = value;
         index[numberNonZero++] = iColumn;
       }
-      value = 0.0;
-      for (j = start; j < end; j++) {
-        int iRow = stuff_[j].row_;
-        value += pi[iRow] * elements_[stuff_[j].pool_];
-      }
-    }
-    value *= scale;
-    if (fabs(value) > zeroTolerance) {
-      array[numberNonZero] = value;
-      index[numberNonZero++] = iColumn;
     }
   }
   // zero out
@@ -2856,7 +2952,6 @@ void ClpPoolMatrix::transposeTimes(const ClpSimplex *model, double scalar,
   columnArray->setNumElements(numberNonZero);
   y->setNumElements(0);
   columnArray->setPackedMode(true);
-#endif
 }
 /* Return <code>x * A + y</code> in <code>z</code>.
    Squashes small elements and knows about ClpSimplex */
@@ -2865,7 +2960,9 @@ void ClpPoolMatrix::transposeTimesByRow(const ClpSimplex *model, double scalar,
   CoinIndexedVector *y,
   CoinIndexedVector *columnArray) const
 {
+#ifdef CLP_INVESTIGATE
   printf("createMatrix at file %s line %d\n", __FILE__, __LINE__);
+#endif
   createMatrix()->transposeTimesByRow(model, scalar, rowArray, y, columnArray);
 }
 /* Return <code>x *A in <code>z</code> but
@@ -2892,16 +2989,8 @@ void ClpPoolMatrix::subsetTransposeTimes(const ClpSimplex *model,
   if (!rowScale) {
     for (jColumn = 0; jColumn < numberToDo; jColumn++) {
       int iColumn = which[jColumn];
-      double value = 0.0;
-      CoinBigIndex start = columnStart_[iColumn];
-      CoinBigIndex end = columnStart_[iColumn + 1];
-      array[jColumn] = value;
-      CoinBigIndex j;
-      for (j = start; j < end; j++) {
-        int iRow = stuff_[j].row_;
-        value += pi[iRow] * elements_[stuff_[j].pool_];
-      }
-      array[jColumn] = value;
+      array[jColumn] = poolDot(stuff_, elements_, pi,
+        columnStart_[iColumn], columnStart_[iColumn + 1]);
     }
   } else {
     // scaled
@@ -3031,7 +3120,9 @@ ClpPoolMatrix::getPackedMatrix() const
 const double *
 ClpPoolMatrix::getElements() const
 {
+#ifdef CLP_INVESTIGATE
   printf("createMatrix at file %s line %d\n", __FILE__, __LINE__);
+#endif
   return createMatrix()->getElements();
 }
 
@@ -3043,13 +3134,17 @@ ClpPoolMatrix::getElements() const
 const int *
 ClpPoolMatrix::getIndices() const
 {
+#ifdef CLP_INVESTIGATE
   printf("createMatrix at file %s line %d\n", __FILE__, __LINE__);
+#endif
   return createMatrix()->getIndices();
 }
 const CoinBigIndex *
 ClpPoolMatrix::getVectorStarts() const
 {
+#ifdef CLP_INVESTIGATE
   printf("createMatrix at file %s line %d\n", __FILE__, __LINE__);
+#endif
   return createMatrix()->getVectorStarts();
 }
 /* The lengths of the major-dimension vectors. */
@@ -3236,10 +3331,90 @@ bool ClpPoolMatrix::canDoPartialPricing() const
 void ClpPoolMatrix::partialPricing(ClpSimplex *model, double startFraction, double endFraction,
   int &bestSequence, int &numberWanted)
 {
-  printf("createMatrix at file %s line %d\n", __FILE__, __LINE__);
-  createMatrix()->partialPricing(model, startFraction,
-    endFraction, bestSequence,
-    numberWanted);
+  numberWanted = currentWanted_;
+  int start = static_cast< int >(startFraction * numberColumns_);
+  int end = CoinMin(static_cast< int >(endFraction * numberColumns_ + 1), numberColumns_);
+  const double *COIN_RESTRICT rowScale = model->rowScale();
+  const double *COIN_RESTRICT columnScale = model->columnScale();
+  double tolerance = model->currentDualTolerance();
+  double *COIN_RESTRICT reducedCost = model->djRegion();
+  const double *COIN_RESTRICT duals = model->dualRowSolution();
+  const double *COIN_RESTRICT cost = model->costRegion();
+  const double *COIN_RESTRICT pi = duals;
+  double *scaledDuals = NULL;
+  if (rowScale) {
+    // scale duals once so inner loops are same as unscaled
+    int numberRows = model->numberRows();
+    scaledDuals = new double[numberRows];
+    for (int iRow = 0; iRow < numberRows; iRow++)
+      scaledDuals[iRow] = duals[iRow] * rowScale[iRow];
+    pi = scaledDuals;
+  }
+  double bestDj;
+  if (bestSequence >= 0)
+    bestDj = fabs(model->clpMatrix()->reducedCost(model, bestSequence));
+  else
+    bestDj = tolerance;
+  int sequenceOut = model->sequenceOut();
+  int saveSequence = bestSequence;
+  int lastScan = minimumObjectsScan_ < 0 ? end : start + minimumObjectsScan_;
+  int minNeg = minimumGoodReducedCosts_ == -1 ? numberWanted : minimumGoodReducedCosts_;
+  for (int iSequence = start; iSequence < end; iSequence++) {
+    if (iSequence != sequenceOut) {
+      ClpSimplex::Status status = model->getStatus(iSequence);
+      if (status != ClpSimplex::basic && status != ClpSimplex::isFixed) {
+        double value = poolDot(stuff_, elements_, pi,
+          columnStart_[iSequence], columnStart_[iSequence + 1]);
+        if (columnScale)
+          value *= columnScale[iSequence];
+        value = cost[iSequence] - value;
+        bool good;
+        if (status == ClpSimplex::atUpperBound) {
+          good = value > tolerance;
+        } else if (status == ClpSimplex::atLowerBound) {
+          value = -value;
+          good = value > tolerance;
+        } else {
+          // free or superbasic
+          value = fabs(value);
+          good = value > FREE_ACCEPT * tolerance;
+          // we are going to bias towards free (but only if reasonable)
+          value *= FREE_BIAS;
+        }
+        if (good) {
+          numberWanted--;
+          if (value > bestDj) {
+            // check flagged variable and correct dj
+            if (!model->flagged(iSequence)) {
+              bestDj = value;
+              bestSequence = iSequence;
+            } else {
+              // just to make sure we don't exit before got something
+              numberWanted++;
+            }
+          }
+        }
+      }
+    }
+    if (numberWanted + minNeg < originalWanted_ && iSequence > lastScan) {
+      // give up
+      break;
+    }
+    if (!numberWanted)
+      break;
+  }
+  if (bestSequence != saveSequence) {
+    // recompute dj
+    double value = poolDot(stuff_, elements_, pi,
+      columnStart_[bestSequence], columnStart_[bestSequence + 1]);
+    if (columnScale)
+      value *= columnScale[bestSequence];
+    reducedCost[bestSequence] = cost[bestSequence] - value;
+    savedBestSequence_ = bestSequence;
+    savedBestDj_ = reducedCost[savedBestSequence_];
+  }
+  delete[] scaledDuals;
+  currentWanted_ = numberWanted;
 }
 // Allow any parts of a created CoinMatrix to be deleted
 void ClpPoolMatrix::releasePackedMatrix() const
@@ -3247,27 +3422,19 @@ void ClpPoolMatrix::releasePackedMatrix() const
   delete matrix_;
   matrix_ = NULL;
 }
-// These have to match ClpPrimalColumnSteepest version
-#define reference(i) (((reference[i >> 5] >> (i & 31)) & 1) != 0)
 /* Updates two arrays for steepest and does devex weights 
    Returns nonzero if updates reduced cost and infeas -
-   new infeas in dj1  - This does not at present*/
+   new infeas in dj1 */
 int ClpPoolMatrix::transposeTimes2(const ClpSimplex *model,
   const CoinIndexedVector *pi1, CoinIndexedVector *dj1,
   const CoinIndexedVector *pi2,
   CoinIndexedVector *spare,
-  double *infeas, double *reducedCost,
+  double *COIN_RESTRICT infeas, double *COIN_RESTRICT reducedCost,
   double referenceIn, double devex,
   // Array for exact devex to say what is in reference framework
   unsigned int *COIN_RESTRICT reference,
   double *COIN_RESTRICT weights, double scaleFactor)
 {
-#if 0
-  printf("CcreateMatrix at file %s line %d\n",__FILE__,__LINE__);
-  return createMatrix()->transposeTimes2(model,pi1,dj1,pi2,spare,
-					 infeas,reducedCost,referenceIn,devex,
-					 reference,weights,scaleFactor);
-#else
   int returnCode = 0;
   // put row of tableau in dj1
   double *COIN_RESTRICT pi = pi1->denseVector();
@@ -3287,6 +3454,7 @@ int ClpPoolMatrix::transposeTimes2(const ClpSimplex *model,
   // do by column
   int iColumn;
   const double *COIN_RESTRICT rowScale = model->rowScale();
+  const double *COIN_RESTRICT columnScale = model->columnScale();
   assert(!spare->getNumElements());
   assert(numberColumns_ > 0);
   double *COIN_RESTRICT piWeight = pi2->denseVector();
@@ -3306,107 +3474,6 @@ int ClpPoolMatrix::transposeTimes2(const ClpSimplex *model,
       int iRow = whichRow[i];
       pi[iRow] = piOld[i];
     }
-    if (infeas)
-      returnCode = 1;
-    CoinBigIndex j;
-    CoinBigIndex end = columnStart_[0];
-    for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-      CoinBigIndex start = end;
-      end = columnStart_[iColumn + 1];
-      ClpSimplex::Status status = model->getStatus(iColumn);
-      if (status == ClpSimplex::basic || status == ClpSimplex::isFixed)
-        continue;
-      double value = 0.0;
-      for (j = start; j < end; j++) {
-        int iRow = stuff_[j].row_;
-        value -= pi[iRow] * elements_[stuff_[j].pool_];
-      }
-      if (fabs(value) > zeroTolerance) {
-        // and do other array
-        double modification = 0.0;
-        for (j = start; j < end; j++) {
-          int iRow = stuff_[j].row_;
-          modification += piWeight[iRow] * elements_[stuff_[j].pool_];
-        }
-        double thisWeight = weights[iColumn];
-        double pivot = value * scaleFactor;
-        double pivotSquared = pivot * pivot;
-        thisWeight += pivotSquared * devex + pivot * modification;
-        if (thisWeight < DEVEX_TRY_NORM) {
-          if (referenceIn < 0.0) {
-            // steepest
-            thisWeight = CoinMax(DEVEX_TRY_NORM, DEVEX_ADD_ONE + pivotSquared);
-          } else {
-            // exact
-            thisWeight = referenceIn * pivotSquared;
-            if (reference(iColumn))
-              thisWeight += 1.0;
-            thisWeight = CoinMax(thisWeight, DEVEX_TRY_NORM);
-          }
-        }
-        weights[iColumn] = thisWeight;
-        if (!killDjs) {
-          value = reducedCost[iColumn] - value;
-          reducedCost[iColumn] = value;
-          // simplify status
-          ClpSimplex::Status status = model->getStatus(iColumn);
-
-          switch (status) {
-
-          case ClpSimplex::basic:
-          case ClpSimplex::isFixed:
-            break;
-          case ClpSimplex::isFree:
-          case ClpSimplex::superBasic:
-            if (fabs(value) > FREE_ACCEPT * dualTolerance) {
-              // we are going to bias towards free (but only if reasonable)
-              value *= FREE_BIAS;
-              value *= value;
-              // store square in list
-              if (infeas[iColumn]) {
-                infeas[iColumn] = value; // already there
-              } else {
-                array[numberNonZero] = value;
-                index[numberNonZero++] = iColumn;
-              }
-            } else {
-              array[numberNonZero] = 0.0;
-              index[numberNonZero++] = iColumn;
-            }
-            break;
-          case ClpSimplex::atUpperBound:
-            if (value > dualTolerance) {
-              value *= value;
-              // store square in list
-              if (infeas[iColumn]) {
-                infeas[iColumn] = value; // already there
-              } else {
-                array[numberNonZero] = value;
-                index[numberNonZero++] = iColumn;
-              }
-            } else {
-              array[numberNonZero] = 0.0;
-              index[numberNonZero++] = iColumn;
-            }
-            break;
-          case ClpSimplex::atLowerBound:
-            if (value < -dualTolerance) {
-              value *= value;
-              // store square in list
-              if (infeas[iColumn]) {
-                infeas[iColumn] = value; // already there
-              } else {
-                array[numberNonZero] = value;
-                index[numberNonZero++] = iColumn;
-              }
-            } else {
-              array[numberNonZero] = 0.0;
-              index[numberNonZero++] = iColumn;
-            }
-          }
-        }
-      }
-    }
   } else {
     // scaled
     // modify pi so can collapse to one loop
@@ -3416,111 +3483,82 @@ int ClpPoolMatrix::transposeTimes2(const ClpSimplex *model,
     }
     // can also scale piWeight as not used again
     int numberWeight = pi2->getNumElements();
-    const int *indexWeight = pi2->getIndices();
+    const int *COIN_RESTRICT indexWeight = pi2->getIndices();
     for (i = 0; i < numberWeight; i++) {
       int iRow = indexWeight[i];
       piWeight[iRow] *= rowScale[iRow];
     }
-    if (infeas)
-      returnCode = 1;
-    const double *COIN_RESTRICT columnScale = model->columnScale();
-    CoinBigIndex j;
-    CoinBigIndex end = columnStart_[0];
-    for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-      CoinBigIndex start = end;
-      end = columnStart_[iColumn + 1];
-      ClpSimplex::Status status = model->getStatus(iColumn);
-      if (status == ClpSimplex::basic || status == ClpSimplex::isFixed)
-        continue;
-      double scale = columnScale[iColumn];
-      double value = 0.0;
-      for (j = start; j < end; j++) {
-        int iRow = stuff_[j].row_;
-        value -= pi[iRow] * elements_[stuff_[j].pool_];
-      }
-      value *= scale;
-      if (fabs(value) > zeroTolerance) {
-        double modification = 0.0;
-        for (j = start; j < end; j++) {
-          int iRow = stuff_[j].row_;
-          modification += piWeight[iRow] * elements_[stuff_[j].pool_];
-        }
-        modification *= scale;
-        double thisWeight = weights[iColumn];
-        double pivot = value * scaleFactor;
-        double pivotSquared = pivot * pivot;
-        thisWeight += pivotSquared * devex + pivot * modification;
-        if (thisWeight < DEVEX_TRY_NORM) {
-          if (referenceIn < 0.0) {
-            // steepest
-            thisWeight = CoinMax(DEVEX_TRY_NORM, DEVEX_ADD_ONE + pivotSquared);
-          } else {
-            // exact
-            thisWeight = referenceIn * pivotSquared;
-            if (reference(iColumn))
-              thisWeight += 1.0;
-            thisWeight = CoinMax(thisWeight, DEVEX_TRY_NORM);
-          }
-        }
-        weights[iColumn] = thisWeight;
-        if (!killDjs) {
-          value = reducedCost[iColumn] - value;
-          reducedCost[iColumn] = value;
-          // simplify status
-          ClpSimplex::Status status = model->getStatus(iColumn);
-
-          switch (status) {
+  }
+  if (infeas)
+    returnCode = 1;
+  for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    ClpSimplex::Status status = model->getStatus(iColumn);
+    if (status == ClpSimplex::basic || status == ClpSimplex::isFixed)
+      continue;
+    CoinBigIndex start = columnStart_[iColumn];
+    CoinBigIndex end = columnStart_[iColumn + 1];
+    double scale = rowScale ? columnScale[iColumn] : 1.0;
+    double value = -poolDot(stuff_, elements_, pi, start, end) * scale;
+    if (fabs(value) > zeroTolerance) {
+      // and do other array
+      double modification = poolDot(stuff_, elements_, piWeight, start, end) * scale;
+      poolWeight(iColumn, value * scaleFactor, modification,
+        referenceIn, devex, reference, weights);
+      if (!killDjs) {
+        value = reducedCost[iColumn] - value;
+        reducedCost[iColumn] = value;
+        // simplify status
+        switch (status) {
 
-          case ClpSimplex::basic:
-          case ClpSimplex::isFixed:
-            break;
-          case ClpSimplex::isFree:
-          case ClpSimplex::superBasic:
-            if (fabs(value) > FREE_ACCEPT * dualTolerance) {
-              // we are going to bias towards free (but only if reasonable)
-              value *= FREE_BIAS;
-              value *= value;
-              // store square in list
-              if (infeas[iColumn]) {
-                infeas[iColumn] = value; // already there
-              } else {
-                array[numberNonZero] = value;
-                index[numberNonZero++] = iColumn;
-              }
+        case ClpSimplex::basic:
+        case ClpSimplex::isFixed:
+          break;
+        case ClpSimplex::isFree:
+        case ClpSimplex::superBasic:
+          if (fabs(value) > FREE_ACCEPT * dualTolerance) {
+            // we are going to bias towards free (but only if reasonable)
+            value *= FREE_BIAS;
+            value *= value;
+            // store square in list
+            if (infeas[iColumn]) {
+              infeas[iColumn] = value; // already there
             } else {
-              array[numberNonZero] = 0.0;
+              array[numberNonZero] = value;
               index[numberNonZero++] = iColumn;
             }
-            break;
-          case ClpSimplex::atUpperBound:
-            if (value > dualTolerance) {
-              value *= value;
-              // store square in list
-              if (infeas[iColumn]) {
-                infeas[iColumn] = value; // already there
-              } else {
-                array[numberNonZero] = value;
-                index[numberNonZero++] = iColumn;
-              }
+          } else {
+            array[numberNonZero] = 0.0;
+            index[numberNonZero++] = iColumn;
+          }
+          break;
+        case ClpSimplex::atUpperBound:
+          if (value > dualTolerance) {
+            value *= value;
+            // store square in list
+            if (infeas[iColumn]) {
+              infeas[iColumn] = value; // already there
             } else {
-              array[numberNonZero] = 0.0;
+              array[numberNonZero] = value;
               index[numberNonZero++] = iColumn;
             }
-            break;
-          case ClpSimplex::atLowerBound:
-            if (value < -dualTolerance) {
-              value *= value;
-              // store square in list
-              if (infeas[iColumn]) {
-                infeas[iColumn] = value; // already there
-              } else {
-                array[numberNonZero] = value;
-                index[numberNonZero++] = iColumn;
-              }
+          } else {
+            array[numberNonZero] = 0.0;
+            index[numberNonZero++] = iColumn;
+          }
+          break;
+        case ClpSimplex::atLowerBound:
+          if (value < -dualTolerance) {
+            value *= value;
+            // store square in list
+            if (infeas[iColumn]) {
+              infeas[iColumn] = value; // already there
             } else {
-              array[numberNonZero] = 0.0;
+              array[numberNonZero] = value;
               index[numberNonZero++] = iColumn;
             }
+          } else {
+            array[numberNonZero] = 0.0;
+            index[numberNonZero++] = iColumn;
           }
         }
       }
@@ -3541,21 +3579,48 @@ int ClpPoolMatrix::transposeTimes2(const ClpSimplex *model,
   if (packed)
     dj1->setPackedMode(true);
   return returnCode;
-#endif
 }
 // Updates second array for steepest and does devex weights
 void ClpPoolMatrix::subsetTimes2(const ClpSimplex *model,
   CoinIndexedVector *dj1,
-  const CoinIndexedVector *pi2, CoinIndexedVector *dj2,
+  const CoinIndexedVector *pi2, CoinIndexedVector *,
   double referenceIn, double devex,
   // Array for exact devex to say what is in reference framework
   unsigned int *COIN_RESTRICT reference,
   double *COIN_RESTRICT weights, double scaleFactor)
 {
-  printf("createMatrix at file %s line %d\n", __FILE__, __LINE__);
-  createMatrix()->subsetTimes2(model, dj1, pi2, dj2,
-    referenceIn, devex,
-    reference, weights, scaleFactor);
+  int number = dj1->getNumElements();
+  const int *COIN_RESTRICT index = dj1->getIndices();
+  double *COIN_RESTRICT array = dj1->denseVector();
+  assert(dj1->packedMode());
+  const double *COIN_RESTRICT rowScale = model->rowScale();
+  const double *COIN_RESTRICT columnScale = model->columnScale();
+  const double *COIN_RESTRICT piWeight = pi2->denseVector();
+  bool killDjs = (scaleFactor == 0.0);
+  if (!scaleFactor)
+    scaleFactor = 1.0;
+  for (int k = 0; k < number; k++) {
+    int iColumn = index[k];
+    double pivot = array[k] * scaleFactor;
+    if (killDjs)
+      array[k] = 0.0;
+    // and do other array
+    CoinBigIndex start = columnStart_[iColumn];
+    CoinBigIndex end = columnStart_[iColumn + 1];
+    double modification;
+    if (!rowScale) {
+      modification = poolDot(stuff_, elements_, piWeight, start, end);
+    } else {
+      modification = 0.0;
+      for (CoinBigIndex j = start; j < end; j++) {
+        int iRow = stuff_[j].row_;
+        modification += piWeight[iRow] * elements_[stuff_[j].pool_] * rowScale[iRow];
+      }
+      modification *= columnScale[iColumn];
+    }
+    poolWeight(iColumn, pivot, modification,
+      referenceIn, devex, reference, weights);
+  }
 }
 /* Set the dimensions of the matrix. In effect, append new empty
    columns/rows to the matrix. A negative number for either dimension
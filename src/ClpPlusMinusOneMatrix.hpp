@@ -294,6 +294,11 @@ protected:
 #if CLP_POOL_MATRIX
 /** This implements a matrix with few different coefficients 
     as derived from ClpMatrixBase.  This version only up to 65K rows
+
+    Each element is one 32 bit word (row and index into pool) so
+    pricing streams a third of the data of ClpPackedMatrix.  Column
+    products gather with AVX2 if available.  ClpSolve switches to this
+    automatically for large dual solves when the pool fits.
 */
 #define CLP_POOL_SIZE 32 - CLP_POOL_MATRIX
 #if CLP_POOL_MATRIX == 16
@@ -12,6 +12,7 @@
 #include <math.h>
 
 #include "CoinHelperFunctions.hpp"
+#include "CoinTime.hpp"
 #include "ClpPredictorCorrector.hpp"
 #include "ClpEventHandler.hpp"
 #include "CoinPackedMatrix.hpp"
@@ -85,6 +86,10 @@ int ClpPredictorCorrector::solve()
   // reallocate some regions
   double *dualSave = dual_;
   dual_ = reinterpret_cast< double * >(new CoinWorkDouble[numberRows_]);
+  if (warmStart_) {
+    for (int iRow = 0; iRow < numberRows_; iRow++)
+      reinterpret_cast< CoinWorkDouble * >(dual_)[iRow] = dualSave[iRow];
+  }
   double *reducedCostSave = reducedCost_;
   reducedCost_ = reinterpret_cast< double * >(new CoinWorkDouble[numberColumns_]);
 #endif
@@ -130,6 +135,7 @@ int ClpPredictorCorrector::solve()
   }
   //initializeFeasible(); - this just set fixed flag
   smallestInfeasibility_ = COIN_DBL_MAX;
+  numberCorrectors_ = 0;
   int i;
   for (i = 0; i < LENGTH_HISTORY; i++)
     historyInfeasibility_[i] = COIN_DBL_MAX;
@@ -175,7 +181,8 @@ int ClpPredictorCorrector::solve()
   CoinWorkDouble *dualArray = reinterpret_cast< CoinWorkDouble * >(dual_);
   // Could try centering steps without any original step i.e. just center
   //firstFactorization(false);
-  CoinZeroN(dualArray, numberRows_);
+  if (!warmStart_)
+    CoinZeroN(dualArray, numberRows_);
   multiplyAdd(solution_ + numberColumns_, numberRows_, -1.0, errorRegion_, 0.0);
   matrix_->times(1.0, solution_, errorRegion_);
   maximumRHSError_ = maximumAbsElement(errorRegion_, numberRows_);
@@ -221,6 +228,11 @@ int ClpPredictorCorrector::solve()
   CoinWorkDouble *saveW = new CoinWorkDouble[numberTotal];
   CoinWorkDouble *saveSL = new CoinWorkDouble[numberTotal];
   CoinWorkDouble *saveSU = new CoinWorkDouble[numberTotal];
+  // Times for choosing number of centrality correctors
+  double factorizationTime = 0.0;
+  double solveTime = 0.0;
+  int numberTimedSolves = 0;
+  int numberFactorizations = 0;
   // Save smallest mu used in primal dual moves
   CoinWorkDouble objScale = optimizationDirection_ / (rhsScale_ * objectiveScale_);
   while (problemStatus_ < 0) {
@@ -531,7 +543,10 @@ int ClpPredictorCorrector::solve()
     multiplyAdd(NULL, numberTotal, 0.0, diagonal_,
       diagonalScaleFactor_);
     int *rowsDroppedThisTime = new int[numberRows_];
+    double time1 = CoinCpuTime();
     newDropped = cholesky_->factorize(diagonal_, rowsDroppedThisTime);
+    factorizationTime += CoinCpuTime() - time1;
+    numberFactorizations++;
     if (newDropped) {
       if (newDropped == -1) {
         COIN_DETAIL_PRINT(printf("Out of memory\n"));
@@ -571,7 +586,10 @@ int ClpPredictorCorrector::solve()
     //set up for affine direction
     setupForSolve(phase);
     if ((modeSwitch & 2) == 0) {
+      time1 = CoinCpuTime();
       directionAccuracy = findDirectionVector(phase);
+      solveTime += CoinCpuTime() - time1;
+      numberTimedSolves++;
       if (directionAccuracy > worstDirectionAccuracy_) {
         worstDirectionAccuracy_ = directionAccuracy;
       }
@@ -841,7 +859,28 @@ int ClpPredictorCorrector::solve()
       goodMove = false; // don't bother
     if ((modeSwitch & 1) != 0)
       goodMove = false;
-    while (goodMove && numberTries < 5) {
+    /* Number of centrality correctors (Gondzio) - if factorization is
+       expensive compared to a solve then it is worth trying more
+       correctors to get a longer step.  Until there is enough time to
+       measure use old fixed number. */
+    int maximumCorrectors = maximumCorrectors_;
+    if (maximumCorrectors < 0) {
+      maximumCorrectors = 5;
+      if (factorizationTime > 0.05 && solveTime > 0.0) {
+        double ratio = (factorizationTime * numberTimedSolves) / (solveTime * numberFactorizations);
+        if (ratio <= 10.0)
+          maximumCorrectors = 2;
+        else if (ratio <= 30.0)
+          maximumCorrectors = 3;
+        else if (ratio <= 50.0)
+          maximumCorrectors = 4;
+        else if (ratio <= 100.0)
+          maximumCorrectors = 5;
+        else
+          maximumCorrectors = 6;
+      }
+    }
+    while (goodMove && numberTries < maximumCorrectors) {
       goodMove = false;
       numberTries++;
       CoinMemcpyN(deltaX_, numberTotal, saveX);
@@ -897,6 +936,7 @@ int ClpPredictorCorrector::solve()
         }
       }
     }
+    numberCorrectors_ += numberTries;
     if (numberGoodTries && handler_->logLevel() > 1) {
       COIN_DETAIL_PRINT(printf("%d centering steps moved from (gap %.18g, dual %.18g, primal %.18g) to (gap %.18g, dual %.18g, primal %.18g)\n",
         numberGoodTries, static_cast< double >(nextGap), static_cast< double >(originalDualStep),
@@ -959,6 +999,19 @@ int ClpPredictorCorrector::solve()
     << static_cast< double >(complementarityGap_)
     << static_cast< double >(objectiveValue())
     << CoinMessageEol;
+  if (warmStart_) {
+    char line[100];
+    if (coldStartIterations_ > 0)
+      sprintf(line, "Warm started barrier took %d iterations - %d saved compared to cold start",
+        numberIterations_, coldStartIterations_ - numberIterations_);
+    else
+      sprintf(line, "Warm started barrier took %d iterations", numberIterations_);
+    handler_->message(CLP_GENERAL, messages_)
+      << line
+      << CoinMessageEol;
+  } else if (!problemStatus_) {
+    coldStartIterations_ = numberIterations_;
+  }
   //#ifdef SOME_DEBUG
   if (handler_->logLevel() > 1)
     COIN_DETAIL_PRINT(printf("ENDRUN status %d after %d iterations\n", problemStatus_, numberIterations_));
@@ -1870,6 +1923,23 @@ int ClpPredictorCorrector::createSolution()
   int numberTotal = numberRows_ + numberColumns_;
   int iColumn;
   CoinWorkDouble tolerance = primalTolerance();
+  CoinWorkDouble *warmSolution = NULL;
+  if (warmStart_) {
+    // save given solution in scaled space
+    warmSolution = new CoinWorkDouble[numberTotal];
+    for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
+      CoinWorkDouble value = solution_[iColumn] * rhsScale_;
+      if (rowScale_)
+        value /= columnScale_[iColumn];
+      warmSolution[iColumn] = value;
+    }
+    for (int iRow = 0; iRow < numberRows_; iRow++) {
+      CoinWorkDouble value = solution_[iRow + numberColumns_] * rhsScale_;
+      if (rowScale_)
+        value *= rowScale_[iRow];
+      warmSolution[iRow + numberColumns_] = value;
+    }
+  }
   // See if quadratic objective
 #ifndef NO_RTTI
   ClpQuadraticObjective *quadraticObj = (dynamic_cast< ClpQuadraticObjective * >(objective_));
@@ -1948,6 +2018,17 @@ int ClpPredictorCorrector::createSolution()
     }
   }
   baseObjectiveNorm_ = objectiveNorm_;
+  if (warmSolution) {
+    // given duals into scaled space (as in deleteWorkingData)
+    CoinWorkDouble *dualArray = reinterpret_cast< CoinWorkDouble * >(dual_);
+    CoinWorkDouble scaleC = scaleFactor_ * optimizationDirection_ / objectiveScale_;
+    for (int iRow = 0; iRow < numberRows_; iRow++) {
+      CoinWorkDouble value = scaleC ? dualArray[iRow] / scaleC : 0.0;
+      if (rowScale_)
+        value /= rowScale_[iRow];
+      dualArray[iRow] = value;
+    }
+  }
   //accumulate fixed in dj region (as spare)
   //accumulate primal solution in primal region
   //DZ in lowerDual
@@ -2033,6 +2114,8 @@ int ClpPredictorCorrector::createSolution()
   if (returnCode == -1) {
     COIN_DETAIL_PRINT(printf("Out of memory\n"));
     problemStatus_ = 4;
+    delete[] rowsDropped;
+    delete[] warmSolution;
     return -1;
   }
   if (cholesky_->status()) {
@@ -2045,6 +2128,11 @@ int ClpPredictorCorrector::createSolution()
     //}
   }
   delete[] rowsDropped;
+  if (warmSolution) {
+    returnCode = warmStartSolution(warmSolution);
+    delete[] warmSolution;
+    return returnCode;
+  }
   if (cholesky_->type() < 20) {
     // not KKT
     cholesky_->solve(errorRegion_);
@@ -2354,6 +2442,143 @@ int ClpPredictorCorrector::createSolution()
 #endif
   return 0;
 }
+/* Warm start - warmSolution has given primal solution (scaled) and dual_
+   given duals.  Primal is moved inside bounds and slacks and bound duals
+   are shifted away from zero (as Mehrotra but with a floor so not too
+   close to boundary), then any complementarity product much smaller
+   than average is increased so start is reasonably well centred. */
+int ClpPredictorCorrector::warmStartSolution(const CoinWorkDouble *warmSolution)
+{
+  int numberTotal = numberRows_ + numberColumns_;
+  int iColumn;
+  CoinWorkDouble *dualArray = reinterpret_cast< CoinWorkDouble * >(dual_);
+  // reduced costs from given duals
+  CoinMemcpyN(dualArray, numberRows_, dj_ + numberColumns_);
+  CoinMemcpyN(cost_, numberColumns_, dj_);
+  quadraticDjs(dj_, warmSolution, 1.0);
+  matrix_->transposeTimes(-1.0, dualArray, dj_);
+  // as createSolution - long way from bounds (or free) then bound
+  CoinWorkDouble largeGap = CoinMax(1.0e7, 1.02 * maximumAbsElement(warmSolution, numberTotal));
+  for (iColumn = 0; iColumn < numberTotal; iColumn++) {
+    if (!flagged(iColumn)) {
+      CoinWorkDouble value = warmSolution[iColumn];
+      if (value > lower_[iColumn] + largeGap && value < upper_[iColumn] - largeGap) {
+        clearFixedOrFree(iColumn);
+        setLowerBound(iColumn);
+        setUpperBound(iColumn);
+        lower_[iColumn] = CoinMax(lower_[iColumn], value - largeGap);
+        upper_[iColumn] = CoinMin(upper_[iColumn], value + largeGap);
+      }
+    }
+  }
+  // sizes of slacks, bound duals and products at given solution
+  CoinWorkDouble sumSlack = 0.0;
+  CoinWorkDouble sumDual = 0.0;
+  CoinWorkDouble sumProduct = 0.0;
+  int numberItems = 0;
+  for (iColumn = 0; iColumn < numberTotal; iColumn++) {
+    if (!flagged(iColumn)) {
+      CoinWorkDouble value = CoinMax(lower_[iColumn], CoinMin(upper_[iColumn], warmSolution[iColumn]));
+      CoinWorkDouble reducedCost = dj_[iColumn];
+      if (lowerBound(iColumn)) {
+        CoinWorkDouble slack = value - lower_[iColumn];
+        CoinWorkDouble dualValue = CoinMax(reducedCost, 0.0);
+        sumSlack += slack;
+        sumDual += dualValue;
+        sumProduct += slack * dualValue;
+        numberItems++;
+      }
+      if (upperBound(iColumn)) {
+        CoinWorkDouble slack = upper_[iColumn] - value;
+        CoinWorkDouble dualValue = CoinMax(-reducedCost, 0.0);
+        sumSlack += slack;
+        sumDual += dualValue;
+        sumProduct += slack * dualValue;
+        numberItems++;
+      }
+    }
+  }
+  CoinWorkDouble averageSlack = sumSlack / CoinMax(numberItems, 1);
+  CoinWorkDouble averageDual = sumDual / CoinMax(numberItems, 1);
+  CoinWorkDouble primalShift = 1.0e-2 * CoinMin(1.0 + averageSlack, 1.0e2);
+  CoinWorkDouble dualShift = 1.0e-2 * CoinMin(1.0 + averageDual, objectiveNorm_ + 1.0);
+  if (sumDual > 0.0)
+    primalShift = CoinMax(primalShift, 0.5 * sumProduct / sumDual);
+  if (sumSlack > 0.0)
+    dualShift = CoinMax(dualShift, 0.5 * sumProduct / sumSlack);
+  // shifted solution
+  sumProduct = 0.0;
+  for (iColumn = 0; iColumn < numberTotal; iColumn++) {
+    if (!flagged(iColumn)) {
+      CoinWorkDouble lowerValue = lower_[iColumn];
+      CoinWorkDouble upperValue = upper_[iColumn];
+      CoinWorkDouble value = warmSolution[iColumn];
+      if (lowerBound(iColumn)) {
+        if (upperBound(iColumn)) {
+          if (upperValue - lowerValue > 2.0 * primalShift)
+            value = CoinMin(CoinMax(value, lowerValue + primalShift), upperValue - primalShift);
+          else
+            value = 0.5 * (upperValue + lowerValue);
+        } else {
+          value = CoinMax(value, lowerValue + primalShift);
+        }
+      } else if (upperBound(iColumn)) {
+        value = CoinMin(value, upperValue - primalShift);
+      }
+      solution_[iColumn] = value;
+      CoinWorkDouble reducedCost = dj_[iColumn];
+      lowerSlack_[iColumn] = 0.0;
+      upperSlack_[iColumn] = 0.0;
+      zVec_[iColumn] = 0.0;
+      wVec_[iColumn] = 0.0;
+      if (lowerBound(iColumn)) {
+        lowerSlack_[iColumn] = value - lowerValue;
+        zVec_[iColumn] = CoinMax(reducedCost, 0.0) + dualShift;
+        sumProduct += lowerSlack_[iColumn] * zVec_[iColumn];
+      }
+      if (upperBound(iColumn)) {
+        upperSlack_[iColumn] = upperValue - value;
+        wVec_[iColumn] = CoinMax(-reducedCost, 0.0) + dualShift;
+        sumProduct += upperSlack_[iColumn] * wVec_[iColumn];
+      }
+    } else {
+      // fixed
+      lowerSlack_[iColumn] = 0.0;
+      upperSlack_[iColumn] = 0.0;
+      solution_[iColumn] = lower_[iColumn];
+      zVec_[iColumn] = 0.0;
+      wVec_[iColumn] = 0.0;
+      diagonal_[iColumn] = 0.0;
+    }
+  }
+  // no product too small compared to average
+  CoinWorkDouble smallProduct = 0.1 * sumProduct / CoinMax(numberItems, 1);
+  CoinWorkDouble extra = 1.0e-10;
+  CoinWorkDouble gamma2 = gamma_ * gamma_; // gamma*gamma will be added to diagonal
+  for (iColumn = 0; iColumn < numberTotal; iColumn++) {
+    if (!flagged(iColumn)) {
+      CoinWorkDouble s = lowerSlack_[iColumn] + extra;
+      CoinWorkDouble t = upperSlack_[iColumn] + extra;
+      if (lowerBound(iColumn) && s * zVec_[iColumn] < smallProduct)
+        zVec_[iColumn] = smallProduct / s;
+      if (upperBound(iColumn) && t * wVec_[iColumn] < smallProduct)
+        wVec_[iColumn] = smallProduct / t;
+      CoinWorkDouble gammaTerm = gamma2;
+      if (primalR_)
+        gammaTerm += primalR_[iColumn];
+      if (lowerBound(iColumn)) {
+        if (upperBound(iColumn))
+          diagonal_[iColumn] = (t * s) / (s * wVec_[iColumn] + t * zVec_[iColumn] + gammaTerm * t * s);
+        else
+          diagonal_[iColumn] = s / (zVec_[iColumn] + s * gammaTerm);
+      } else if (upperBound(iColumn)) {
+        diagonal_[iColumn] = t / (wVec_[iColumn] + t * gammaTerm);
+      }
+    }
+  }
+  solutionNorm_ = maximumAbsElement(solution_, numberTotal);
+  return 0;
+}
 // complementarityGap.  Computes gap
 //phase 0=as is , 1 = after predictor , 2 after corrector
 CoinWorkDouble ClpPredictorCorrector::complementarityGap(int &numberComplementarityPairs,
@@ -59,6 +59,9 @@ public:
   CoinWorkDouble findDirectionVector(const int phase);
   /// createSolution.  Creates solution from scratch (- code if no memory)
   int createSolution();
+  /** Warm start - shifts given solution into interior with safeguarded
+      centrality (called from createSolution) */
+  int warmStartSolution(const CoinWorkDouble *warmSolution);
   /// complementarityGap.  Computes gap
   //phase 0=as is , 1 = after predictor , 2 after corrector
   CoinWorkDouble complementarityGap(int &numberComplementarityPairs, int &numberComplementarityItems,
@@ -8,6 +8,105 @@
 #include "ClpFactorization.hpp"
 #include "ClpSimplex.hpp"
 #include "ClpQuadraticObjective.hpp"
+#include "ClpTaskPool.hpp"
+
+// Minimum number of columns per chunk if shared ClpTaskPool used
+#ifndef CLP_HESSIAN_GRAIN
+#define CLP_HESSIAN_GRAIN 2048
+#endif
+/* Hessian times vector is split by columns over the shared ClpTaskPool.
+   With a full matrix each column just gathers.  With half storage the
+   other triangle is scattered into a vector for each thread and these
+   are added in at end.  Quadratic forms go into one slot per thread. */
+typedef struct {
+  double value;
+  double spare[7]; // keep slots on own cache line
+} clpHessianReduce;
+typedef struct {
+  const int *column;
+  const CoinBigIndex *start;
+  const int *length;
+  const double *element;
+  const double *x;
+  const double *scale;
+  double *y;
+  // one vector per thread for other triangle (or NULL to use y)
+  double *scatter;
+  double scalar;
+  int numberColumns;
+  int numberThreads;
+  bool fullMatrix;
+  clpHessianReduce reduce[CLP_MAX_POOL_THREADS + 1];
+} clpHessianInfo;
+static void clpHessianTimesRange(void *stuff, int first, int last, int iThread)
+{
+  clpHessianInfo *info = reinterpret_cast< clpHessianInfo * >(stuff);
+  const int *COIN_RESTRICT column = info->column;
+  const CoinBigIndex *COIN_RESTRICT columnStart = info->start;
+  const int *COIN_RESTRICT columnLength = info->length;
+  const double *COIN_RESTRICT element = info->element;
+  const double *COIN_RESTRICT x = info->x;
+  const double *COIN_RESTRICT scale = info->scale;
+  double *COIN_RESTRICT y = info->y;
+  // not restrict - is y when single thread
+  double *scatter = info->scatter;
+  if (scatter)
+    scatter += iThread * info->numberColumns;
+  else
+    scatter = y;
+  double scalar = info->scalar;
+  double form = 0.0;
+  for (int iColumn = first; iColumn < last; iColumn++) {
+    double scaleI = scale ? scale[iColumn] : 1.0;
+    double valueI = x[iColumn] * scaleI;
+    double value = 0.0;
+    CoinBigIndex end = columnStart[iColumn] + columnLength[iColumn];
+    if (info->fullMatrix) {
+      for (CoinBigIndex j = columnStart[iColumn]; j < end; j++) {
+        int jColumn = column[j];
+        double valueJ = x[jColumn];
+        if (scale)
+          valueJ *= scale[jColumn];
+        value += valueJ * element[j];
+      }
+      form += valueI * value;
+    } else {
+      for (CoinBigIndex j = columnStart[iColumn]; j < end; j++) {
+        int jColumn = column[j];
+        double valueJ = x[jColumn];
+        if (scale)
+          valueJ *= scale[jColumn];
+        double elementValue = element[j];
+        value += valueJ * elementValue;
+        if (iColumn != jColumn) {
+          form += 2.0 * valueI * valueJ * elementValue;
+          if (y) {
+            double scaleJ = scale ? scale[jColumn] : 1.0;
+            scatter[jColumn] += scalar * scaleJ * valueI * elementValue;
+          }
+        } else {
+          form += valueI * valueI * elementValue;
+        }
+      }
+    }
+    if (y)
+      y[iColumn] += scalar * scaleI * value;
+  }
+  info->reduce[iThread].value += form;
+}
+// Adds in other triangle from per thread vectors
+static void clpHessianAddRange(void *stuff, int first, int last, int)
+{
+  clpHessianInfo *info = reinterpret_cast< clpHessianInfo * >(stuff);
+  double *COIN_RESTRICT y = info->y;
+  const double *COIN_RESTRICT scatter = info->scatter;
+  int numberColumns = info->numberColumns;
+  for (int i = 0; i < info->numberThreads; i++) {
+    for (int iColumn = first; iColumn < last; iColumn++)
+      y[iColumn] += scatter[iColumn];
+    scatter += numberColumns;
+  }
+}
 //#############################################################################
 // Constructors / Destructor / Assignment
 //#############################################################################
@@ -25,6 +124,15 @@ ClpQuadraticObjective::ClpQuadraticObjective()
   numberExtendedColumns_ = 0;
   activated_ = 0;
   fullMatrix_ = false;
+  quadraticRowCopy_ = NULL;
+  savedSolution_ = NULL;
+  savedProduct_ = NULL;
+  savedScale_ = NULL;
+  numberSinceRefresh_ = 0;
+  numberIncrementalGradients_ = 0;
+  numberFullGradients_ = 0;
+  incremental_ = true;
+  incrementalActive_ = false;
 }
 
 //-------------------------------------------------------------------
@@ -59,6 +167,15 @@ ClpQuadraticObjective::ClpQuadraticObjective(const double *objective,
   gradient_ = NULL;
   activated_ = 1;
   fullMatrix_ = false;
+  quadraticRowCopy_ = NULL;
+  savedSolution_ = NULL;
+  savedProduct_ = NULL;
+  savedScale_ = NULL;
+  numberSinceRefresh_ = 0;
+  numberIncrementalGradients_ = 0;
+  numberFullGradients_ = 0;
+  incremental_ = true;
+  incrementalActive_ = false;
 }
 
 //-------------------------------------------------------------------
@@ -71,6 +188,15 @@ ClpQuadraticObjective::ClpQuadraticObjective(const ClpQuadraticObjective &rhs,
   numberColumns_ = rhs.numberColumns_;
   numberExtendedColumns_ = rhs.numberExtendedColumns_;
   fullMatrix_ = rhs.fullMatrix_;
+  quadraticRowCopy_ = NULL;
+  savedSolution_ = NULL;
+  savedProduct_ = NULL;
+  savedScale_ = NULL;
+  numberSinceRefresh_ = 0;
+  numberIncrementalGradients_ = 0;
+  numberFullGradients_ = 0;
+  incremental_ = rhs.incremental_;
+  incrementalActive_ = false;
   if (rhs.objective_) {
     objective_ = new double[numberExtendedColumns_];
     CoinMemcpyN(rhs.objective_, numberExtendedColumns_, objective_);
@@ -198,6 +324,15 @@ ClpQuadraticObjective::ClpQuadraticObjective(const ClpQuadraticObjective &rhs,
   : ClpObjective(rhs)
 {
   fullMatrix_ = rhs.fullMatrix_;
+  quadraticRowCopy_ = NULL;
+  savedSolution_ = NULL;
+  savedProduct_ = NULL;
+  savedScale_ = NULL;
+  numberSinceRefresh_ = 0;
+  numberIncrementalGradients_ = 0;
+  numberFullGradients_ = 0;
+  incremental_ = rhs.incremental_;
+  incrementalActive_ = false;
   objective_ = NULL;
   int extra = rhs.numberExtendedColumns_ - rhs.numberColumns_;
   numberColumns_ = 0;
@@ -248,6 +383,7 @@ ClpQuadraticObjective::~ClpQuadraticObjective()
   delete[] objective_;
   delete[] gradient_;
   delete quadraticObjective_;
+  deleteSaved();
 }
 
 //----------------------------------------------------------------
@@ -258,6 +394,11 @@ ClpQuadraticObjective::operator=(const ClpQuadraticObjective &rhs)
 {
   if (this != &rhs) {
     fullMatrix_ = rhs.fullMatrix_;
+    deleteSaved();
+    incremental_ = rhs.incremental_;
+    incrementalActive_ = false;
+    numberIncrementalGradients_ = 0;
+    numberFullGradients_ = 0;
     delete quadraticObjective_;
     quadraticObjective_ = NULL;
     delete[] objective_;
@@ -311,10 +452,6 @@ ClpQuadraticObjective::gradient(const ClpSimplex *model,
       if (refresh || !gradient_) {
         if (!gradient_)
           gradient_ = new double[numberExtendedColumns_];
-        const int *columnQuadratic = quadraticObjective_->getIndices();
-        const CoinBigIndex *columnQuadraticStart = quadraticObjective_->getVectorStarts();
-        const int *columnQuadraticLength = quadraticObjective_->getVectorLengths();
-        const double *quadraticElement = quadraticObjective_->getElements();
         offset = 0.0;
         // use current linear cost region
         if (includeLinear == 1)
@@ -323,58 +460,8 @@ ClpQuadraticObjective::gradient(const ClpSimplex *model,
           CoinMemcpyN(objective_, numberExtendedColumns_, gradient_);
         else
           memset(gradient_, 0, numberExtendedColumns_ * sizeof(double));
-        if (activated_) {
-          if (!fullMatrix_) {
-            int iColumn;
-            for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-              double valueI = solution[iColumn];
-              CoinBigIndex j;
-              for (j = columnQuadraticStart[iColumn];
-                   j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
-                int jColumn = columnQuadratic[j];
-                double valueJ = solution[jColumn];
-                double elementValue = quadraticElement[j];
-                if (iColumn != jColumn) {
-                  offset += valueI * valueJ * elementValue;
-                  //if (fabs(valueI*valueJ*elementValue)>1.0e-12)
-                  //printf("%d %d %g %g %g -> %g\n",
-                  //       iColumn,jColumn,valueI,valueJ,elementValue,
-                  //       valueI*valueJ*elementValue);
-                  double gradientI = valueJ * elementValue;
-                  double gradientJ = valueI * elementValue;
-                  gradient_[iColumn] += gradientI;
-                  gradient_[jColumn] += gradientJ;
-                } else {
-                  offset += 0.5 * valueI * valueI * elementValue;
-                  //if (fabs(valueI*valueI*elementValue)>1.0e-12)
-                  //printf("XX %d %g %g -> %g\n",
-                  //       iColumn,valueI,elementValue,
-                  //       0.5*valueI*valueI*elementValue);
-                  double gradientI = valueI * elementValue;
-                  gradient_[iColumn] += gradientI;
-                }
-              }
-            }
-          } else {
-            // full matrix
-            int iColumn;
-            offset *= 2.0;
-            for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-              CoinBigIndex j;
-              double value = 0.0;
-              double current = gradient_[iColumn];
-              for (j = columnQuadraticStart[iColumn];
-                   j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
-                int jColumn = columnQuadratic[j];
-                double valueJ = solution[jColumn] * quadraticElement[j];
-                value += valueJ;
-              }
-              offset += value * solution[iColumn];
-              gradient_[iColumn] = current + value;
-            }
-            offset *= 0.5;
-          }
-        }
+        if (activated_)
+          offset = hessianTimesSaved(model, solution, gradient_, 1.0, NULL);
       }
       if (model)
         offset *= /*model->optimizationDirection() **/ model->objectiveScale();
@@ -383,8 +470,6 @@ ClpQuadraticObjective::gradient(const ClpSimplex *model,
   } else {
     // do scaling
     assert(solution);
-    // for now only if half
-    assert(!fullMatrix_);
     if (refresh || !gradient_) {
       if (!gradient_)
         gradient_ = new double[numberExtendedColumns_];
@@ -392,10 +477,6 @@ ClpQuadraticObjective::gradient(const ClpSimplex *model,
       // direction is actually scale out not scale in
       //if (direction)
       //direction = 1.0/direction;
-      const int *columnQuadratic = quadraticObjective_->getIndices();
-      const CoinBigIndex *columnQuadraticStart = quadraticObjective_->getVectorStarts();
-      const int *columnQuadraticLength = quadraticObjective_->getVectorLengths();
-      const double *quadraticElement = quadraticObjective_->getElements();
       int iColumn;
       const double *columnScale = model->columnScale();
       // use current linear cost region (already scaled)
@@ -415,60 +496,8 @@ ClpQuadraticObjective::gradient(const ClpSimplex *model,
       } else {
         memset(gradient_, 0, numberExtendedColumns_ * sizeof(double));
       }
-      if (!columnScale) {
-        if (activated_) {
-          for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-            double valueI = solution[iColumn];
-            CoinBigIndex j;
-            for (j = columnQuadraticStart[iColumn];
-                 j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
-              int jColumn = columnQuadratic[j];
-              double valueJ = solution[jColumn];
-              double elementValue = quadraticElement[j];
-              elementValue *= direction;
-              if (iColumn != jColumn) {
-                offset += valueI * valueJ * elementValue;
-                double gradientI = valueJ * elementValue;
-                double gradientJ = valueI * elementValue;
-                gradient_[iColumn] += gradientI;
-                gradient_[jColumn] += gradientJ;
-              } else {
-                offset += 0.5 * valueI * valueI * elementValue;
-                double gradientI = valueI * elementValue;
-                gradient_[iColumn] += gradientI;
-              }
-            }
-          }
-        }
-      } else {
-        // scaling
-        if (activated_) {
-          for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-            double valueI = solution[iColumn];
-            double scaleI = columnScale[iColumn] * direction;
-            CoinBigIndex j;
-            for (j = columnQuadraticStart[iColumn];
-                 j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
-              int jColumn = columnQuadratic[j];
-              double valueJ = solution[jColumn];
-              double elementValue = quadraticElement[j];
-              double scaleJ = columnScale[jColumn];
-              elementValue *= scaleI * scaleJ;
-              if (iColumn != jColumn) {
-                offset += valueI * valueJ * elementValue;
-                double gradientI = valueJ * elementValue;
-                double gradientJ = valueI * elementValue;
-                gradient_[iColumn] += gradientI;
-                gradient_[jColumn] += gradientJ;
-              } else {
-                offset += 0.5 * valueI * valueI * elementValue;
-                double gradientI = valueI * elementValue;
-                gradient_[iColumn] += gradientI;
-              }
-            }
-          }
-        }
-      }
+      if (activated_)
+        offset = direction * hessianTimesSaved(model, solution, gradient_, direction, columnScale);
     }
     if (model)
       offset *= model->optimizationDirection();
@@ -496,6 +525,7 @@ ClpQuadraticObjective::subsetClone(int numberColumns,
 void ClpQuadraticObjective::resize(int newNumberColumns)
 {
   if (numberColumns_ != newNumberColumns) {
+    deleteSaved();
     int newExtended = newNumberColumns + (numberExtendedColumns_ - numberColumns_);
     int i;
     double *newArray = new double[newExtended];
@@ -534,6 +564,7 @@ void ClpQuadraticObjective::resize(int newNumberColumns)
 // Delete columns in  objective
 void ClpQuadraticObjective::deleteSome(int numberToDelete, const int *which)
 {
+  deleteSaved();
   int newNumberColumns = numberColumns_ - numberToDelete;
   int newExtended = numberExtendedColumns_ - numberToDelete;
   if (objective_) {
@@ -603,6 +634,7 @@ void ClpQuadraticObjective::loadQuadraticObjective(const int numberColumns, cons
   const int *column, const double *element, int numberExtended)
 {
   fullMatrix_ = false;
+  deleteSaved();
   delete quadraticObjective_;
   quadraticObjective_ = new CoinPackedMatrix(true, numberColumns, numberColumns,
     start[numberColumns], element, column, start, NULL);
@@ -631,12 +663,14 @@ void ClpQuadraticObjective::loadQuadraticObjective(const int numberColumns, cons
 }
 void ClpQuadraticObjective::loadQuadraticObjective(const CoinPackedMatrix &matrix)
 {
+  deleteSaved();
   delete quadraticObjective_;
   quadraticObjective_ = new CoinPackedMatrix(matrix);
 }
 // Get rid of quadratic objective
 void ClpQuadraticObjective::deleteQuadraticObjective()
 {
+  deleteSaved();
   delete quadraticObjective_;
   quadraticObjective_ = NULL;
 }
@@ -910,99 +944,189 @@ ClpQuadraticObjective::objectiveValue(const ClpSimplex *model, const double *sol
     return currentObj;
   }
   assert(model);
+  double c;
+  if (!scaling) {
+    c = hessianTimes(solution, NULL);
+  } else {
+    double direction = model->objectiveScale();
+    // direction is actually scale out not scale in
+    if (direction)
+      direction = 1.0 / direction;
+    c = direction * hessianTimes(solution, NULL, 1.0, model->columnScale());
+  }
+  currentObj = c + linearCost;
+  return currentObj;
+}
+/* Adds scalar * S H S x to y (if y not NULL) and returns 0.5 x' S H S x */
+double
+ClpQuadraticObjective::hessianTimes(const double *x, double *y, double scalar,
+  const double *columnScale) const
+{
+  if (!quadraticObjective_)
+    return 0.0;
+  clpHessianInfo info;
+  info.column = quadraticObjective_->getIndices();
+  info.start = quadraticObjective_->getVectorStarts();
+  info.length = quadraticObjective_->getVectorLengths();
+  info.element = quadraticObjective_->getElements();
+  info.x = x;
+  info.scale = columnScale;
+  info.y = y;
+  info.scatter = NULL;
+  info.scalar = scalar;
+  info.numberColumns = numberColumns_;
+  info.numberThreads = 0;
+  info.fullMatrix = fullMatrix_;
+  for (int i = 0; i <= CLP_MAX_POOL_THREADS; i++)
+    info.reduce[i].value = 0.0;
+  ClpTaskPool *pool = ClpTaskPool::sharedIfExists();
+  bool parallel = pool && pool->numberThreads()
+    && numberColumns_ >= 2 * CLP_HESSIAN_GRAIN;
+  if (parallel && y && !fullMatrix_) {
+    // other triangle needs a vector per thread - only if enough work
+    int numberThreads = pool->numberThreads() + 1;
+    if (quadraticObjective_->getNumElements() >= static_cast< double >(numberThreads) * numberColumns_) {
+      info.numberThreads = numberThreads;
+      info.scatter = new double[numberThreads * numberColumns_];
+      CoinZeroN(info.scatter, numberThreads * numberColumns_);
+    } else {
+      parallel = false;
+    }
+  }
+  if (parallel)
+    pool->parallelFor(0, numberColumns_, CLP_HESSIAN_GRAIN, clpHessianTimesRange, &info);
+  else
+    clpHessianTimesRange(&info, 0, numberColumns_, 0);
+  if (info.scatter) {
+    pool->parallelFor(0, numberColumns_, CLP_HESSIAN_GRAIN, clpHessianAddRange, &info);
+    delete[] info.scatter;
+  }
+  double form = 0.0;
+  for (int i = 0; i <= CLP_MAX_POOL_THREADS; i++)
+    form += info.reduce[i].value;
+  return 0.5 * form;
+}
+#ifndef CLP_INCREMENTAL_REFRESH
+#define CLP_INCREMENTAL_REFRESH 50
+#endif
+/* As hessianTimes but if active and solution is that of model
+   then updates saved S H S x using changed columns only */
+double
+ClpQuadraticObjective::hessianTimesSaved(const ClpSimplex *model, const double *solution,
+  double *y, double scalar, const double *columnScale)
+{
+  if (!incrementalActive_ || !quadraticObjective_ || !model
+    || solution != model->solutionRegion())
+    return hessianTimes(solution, y, scalar, columnScale);
   const int *columnQuadratic = quadraticObjective_->getIndices();
   const CoinBigIndex *columnQuadraticStart = quadraticObjective_->getVectorStarts();
   const int *columnQuadraticLength = quadraticObjective_->getVectorLengths();
   const double *quadraticElement = quadraticObjective_->getElements();
-  double c = 0.0;
-  if (!scaling) {
-    if (!fullMatrix_) {
-      int iColumn;
-      for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-        double valueI = solution[iColumn];
-        CoinBigIndex j;
-        for (j = columnQuadraticStart[iColumn];
-             j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
-          int jColumn = columnQuadratic[j];
-          double valueJ = solution[jColumn];
-          double elementValue = quadraticElement[j];
-          if (iColumn != jColumn) {
-            c += valueI * valueJ * elementValue;
-          } else {
-            c += 0.5 * valueI * valueI * elementValue;
-          }
-        }
-      }
-    } else {
-      // full matrix stored
-      int iColumn;
-      for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-        double valueI = solution[iColumn];
-        CoinBigIndex j;
-        for (j = columnQuadraticStart[iColumn];
-             j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
-          int jColumn = columnQuadratic[j];
-          double valueJ = solution[jColumn];
-          double elementValue = quadraticElement[j];
-          valueJ *= elementValue;
-          c += valueI * valueJ;
+  if (!fullMatrix_ && !quadraticRowCopy_) {
+    // other triangle of column j is row j
+    quadraticRowCopy_ = new CoinPackedMatrix();
+    quadraticRowCopy_->reverseOrderedCopyOf(*quadraticObjective_);
+  }
+  const int *rowLength = fullMatrix_ ? NULL : quadraticRowCopy_->getVectorLengths();
+  int iColumn;
+  bool refresh = !savedProduct_ || columnScale != savedScale_
+    || numberSinceRefresh_ >= CLP_INCREMENTAL_REFRESH;
+  if (!refresh) {
+    // update only worth while if not too many elements touched
+    CoinBigIndex numberTouched = 0;
+    CoinBigIndex maximumTouched = quadraticObjective_->getNumElements() / 3;
+    for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
+      if (solution[iColumn] != savedSolution_[iColumn]) {
+        numberTouched += columnQuadraticLength[iColumn];
+        if (rowLength)
+          numberTouched += rowLength[iColumn];
+        if (numberTouched > maximumTouched) {
+          refresh = true;
+          break;
         }
       }
-      c *= 0.5;
     }
+  }
+  if (refresh) {
+    if (!savedProduct_) {
+      savedSolution_ = new double[numberColumns_];
+      savedProduct_ = new double[numberColumns_];
+    }
+    CoinZeroN(savedProduct_, numberColumns_);
+    hessianTimes(solution, savedProduct_, 1.0, columnScale);
+    savedScale_ = columnScale;
+    numberSinceRefresh_ = 0;
+    numberFullGradients_++;
   } else {
-    // scaling
-    // for now only if half
-    assert(!fullMatrix_);
-    const double *columnScale = model->columnScale();
-    double direction = model->objectiveScale();
-    // direction is actually scale out not scale in
-    if (direction)
-      direction = 1.0 / direction;
-    if (!columnScale) {
-      for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
-        double valueI = solution[iColumn];
-        CoinBigIndex j;
-        for (j = columnQuadraticStart[iColumn];
-             j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
-          int jColumn = columnQuadratic[j];
-          double valueJ = solution[jColumn];
-          double elementValue = quadraticElement[j];
-          elementValue *= direction;
-          if (iColumn != jColumn) {
-            c += valueI * valueJ * elementValue;
-          } else {
-            c += 0.5 * valueI * valueI * elementValue;
-          }
-        }
+    const int *row = rowLength ? quadraticRowCopy_->getIndices() : NULL;
+    const CoinBigIndex *rowStart = rowLength ? quadraticRowCopy_->getVectorStarts() : NULL;
+    const double *rowElement = rowLength ? quadraticRowCopy_->getElements() : NULL;
+    for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
+      double change = solution[iColumn] - savedSolution_[iColumn];
+      if (!change)
+        continue;
+      if (columnScale)
+        change *= columnScale[iColumn];
+      CoinBigIndex j;
+      for (j = columnQuadraticStart[iColumn];
+           j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
+        int jColumn = columnQuadratic[j];
+        double value = quadraticElement[j] * change;
+        if (columnScale)
+          value *= columnScale[jColumn];
+        savedProduct_[jColumn] += value;
       }
-    } else {
-      // scaling
-      for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
-        double valueI = solution[iColumn];
-        double scaleI = columnScale[iColumn] * direction;
-        CoinBigIndex j;
-        for (j = columnQuadraticStart[iColumn];
-             j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
-          int jColumn = columnQuadratic[j];
-          double valueJ = solution[jColumn];
-          double elementValue = quadraticElement[j];
-          elementValue *= scaleI * columnScale[jColumn];
-          if (iColumn != jColumn) {
-            c += valueI * valueJ * elementValue;
-          } else {
-            c += 0.5 * valueI * valueI * elementValue;
-          }
+      if (rowLength) {
+        for (j = rowStart[iColumn]; j < rowStart[iColumn] + rowLength[iColumn]; j++) {
+          int jColumn = row[j];
+          if (jColumn == iColumn)
+            continue;
+          double value = rowElement[j] * change;
+          if (columnScale)
+            value *= columnScale[jColumn];
+          savedProduct_[jColumn] += value;
         }
       }
     }
+    numberSinceRefresh_++;
+    numberIncrementalGradients_++;
+  }
+  CoinMemcpyN(solution, numberColumns_, savedSolution_);
+  double form = 0.0;
+  for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    double value = savedProduct_[iColumn];
+    form += solution[iColumn] * value;
+    if (y)
+      y[iColumn] += scalar * value;
+  }
+  return 0.5 * form;
+}
+// Frees saved vectors for incremental gradient
+void ClpQuadraticObjective::deleteSaved()
+{
+  delete quadraticRowCopy_;
+  quadraticRowCopy_ = NULL;
+  delete[] savedSolution_;
+  savedSolution_ = NULL;
+  delete[] savedProduct_;
+  savedProduct_ = NULL;
+  savedScale_ = NULL;
+  numberSinceRefresh_ = 0;
+}
+// Starts or stops saving S H S x for incremental gradient
+void ClpQuadraticObjective::activateIncrementalGradient(bool yesNo)
+{
+  deleteSaved();
+  incrementalActive_ = yesNo && incremental_;
+  if (incrementalActive_) {
+    numberIncrementalGradients_ = 0;
+    numberFullGradients_ = 0;
   }
-  currentObj = c + linearCost;
-  return currentObj;
 }
 // Scale objective
 void ClpQuadraticObjective::reallyScale(const double *columnScale)
 {
+  deleteSaved();
   const int *columnQuadratic = quadraticObjective_->getIndices();
   const CoinBigIndex *columnQuadraticStart = quadraticObjective_->getVectorStarts();
   const int *columnQuadraticLength = quadraticObjective_->getVectorLengths();
@@ -50,6 +50,13 @@ public:
     double &thetaObj);
   /// Return objective value (without any ClpModel offset) (model may be NULL)
   virtual double objectiveValue(const ClpSimplex *model, const double *solution) const;
+  /** Adds scalar * S H S x to y (if y not NULL) where H is the symmetric
+      quadratic objective (full or half stored) and S is columnScale (if
+      given).  Returns 0.5 x' S H S x.  Columns are split over the shared
+      ClpTaskPool if big enough.
+     */
+  double hessianTimes(const double *x, double *y, double scalar = 1.0,
+    const double *columnScale = NULL) const;
   virtual void resize(int newNumberColumns);
   /// Delete columns in  objective
   virtual void deleteSome(int numberToDelete, const int *which);
@@ -134,11 +141,46 @@ public:
   {
     return fullMatrix_;
   }
+  /** Allows or stops incremental gradient (default allowed).  When
+      active S H S x for the model solution is kept and the next gradient
+      only uses the columns of H whose solution value has changed (with a
+      full product every so often to stop drift).
+  */
+  inline void setIncrementalGradient(bool yesNo)
+  {
+    incremental_ = yesNo;
+  }
+  /// If incremental gradient allowed
+  inline bool incrementalGradient() const
+  {
+    return incremental_;
+  }
+  /** Used by ClpSimplexNonlinear::primal - if yesNo and allowed starts
+      saving S H S x (zeroing counts), otherwise stops.  Always frees
+      any saved vectors.
+  */
+  void activateIncrementalGradient(bool yesNo);
+  /// Number of gradients done by update since activated
+  inline int numberIncrementalGradients() const
+  {
+    return numberIncrementalGradients_;
+  }
+  /// Number of gradients done by full product since activated
+  inline int numberFullGradients() const
+  {
+    return numberFullGradients_;
+  }
   //@}
 
   //---------------------------------------------------------------------------
 
 private:
+  /** As hessianTimes but if active and solution is that of model
+      then updates saved S H S x using changed columns only */
+  double hessianTimesSaved(const ClpSimplex *model, const double *solution,
+    double *y, double scalar, const double *columnScale);
+  /// Frees saved vectors for incremental gradient
+  void deleteSaved();
   ///@name Private member data
   /// Quadratic objective
   CoinPackedMatrix *quadraticObjective_;
@@ -152,6 +194,24 @@ private:
   int numberExtendedColumns_;
   /// True if full symmetric matrix, false if half
   bool fullMatrix_;
+  /// Row copy of half matrix for incremental gradient
+  CoinPackedMatrix *quadraticRowCopy_;
+  /// Solution at which savedProduct_ is correct
+  double *savedSolution_;
+  /// S H S x at savedSolution_
+  double *savedProduct_;
+  /// Column scale used for savedProduct_
+  const double *savedScale_;
+  /// Number of updates since last full product
+  int numberSinceRefresh_;
+  /// Number of gradients done by update
+  int numberIncrementalGradients_;
+  /// Number of gradients done by full product
+  int numberFullGradients_;
+  /// True if incremental gradient allowed
+  bool incremental_;
+  /// True if incremental gradient active
+  bool incrementalActive_;
   //@}
 };
 
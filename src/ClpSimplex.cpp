@@ -547,7 +547,8 @@ void ClpSimplex::getbackSolution(const ClpSimplex &smallModel, const int *whichR
           }
      }
 #endif
-  matrix()->times(columnActivity_, rowActivity_);
+  CoinZeroN(rowActivity_, numberRows_);
+  matrix_->times(1.0, columnActivity_, rowActivity_);
 }
 
 //-----------------------------------------------------------------------------
@@ -2809,26 +2810,30 @@ void ClpSimplex::gutsOfCopy(const ClpSimplex &rhs)
 // type == 0 do everything, most + pivot data, 2 factorization data as well
 void ClpSimplex::gutsOfDelete(int type)
 {
+  // sizes as in createRim (so arena can tell if still right size)
+  int numberRows2 = numberRows_ + numberExtraRows_;
+  int numberTotal = numberRows2 + numberColumns_;
   if (!type || (specialOptions_ & 65536) == 0) {
     maximumInternalColumns_ = -1;
     maximumInternalRows_ = -1;
-    delete[] lower_;
+    // keep for next solve if arena active
+    workArena_.giveArray(ClpWorkArena::lowerArray, lower_, numberTotal);
     lower_ = NULL;
     rowLowerWork_ = NULL;
     columnLowerWork_ = NULL;
-    delete[] upper_;
+    workArena_.giveArray(ClpWorkArena::upperArray, upper_, numberTotal);
     upper_ = NULL;
     rowUpperWork_ = NULL;
     columnUpperWork_ = NULL;
-    delete[] cost_;
+    workArena_.giveArray(ClpWorkArena::costArray, cost_, 2 * numberTotal);
     cost_ = NULL;
     objectiveWork_ = NULL;
     rowObjectiveWork_ = NULL;
-    delete[] dj_;
+    workArena_.giveArray(ClpWorkArena::djArray, dj_, numberTotal);
     dj_ = NULL;
     reducedCostWork_ = NULL;
     rowReducedCost_ = NULL;
-    delete[] solution_;
+    workArena_.giveArray(ClpWorkArena::solutionArray, solution_, numberTotal);
     solution_ = NULL;
     rowActivityWork_ = NULL;
     columnActivityWork_ = NULL;
@@ -2836,15 +2841,15 @@ void ClpSimplex::gutsOfDelete(int type)
     savedSolution_ = NULL;
   }
   if ((specialOptions_ & 2) == 0) {
-    delete nonLinearCost_;
+    workArena_.giveNonLinearCost(nonLinearCost_);
     nonLinearCost_ = NULL;
   }
   int i;
   if ((specialOptions_ & 65536) == 0) {
     for (i = 0; i < 6; i++) {
-      delete rowArray_[i];
+      workArena_.giveVector(i, rowArray_[i]);
       rowArray_[i] = NULL;
-      delete columnArray_[i];
+      workArena_.giveVector(6 + i, columnArray_[i]);
       columnArray_[i] = NULL;
     }
   }
@@ -2868,19 +2873,38 @@ void ClpSimplex::gutsOfDelete(int type)
     delete[] perturbationArray_;
     perturbationArray_ = NULL;
     maximumPerturbationSize_ = 0;
+    workArena_.clear();
   } else {
     // delete any size information in methods
     if (type > 1) {
       //assert (factorization_);
-      if (factorization_)
-        factorization_->clearArrays();
-      delete[] pivotVariable_;
+      if (factorization_) {
+        if (!workArena_.active()) {
+          // drop persistence switched on while arrays were kept
+          if ((specialOptions_ & 65536) == 0)
+            factorization_->setPersistenceFlag(0);
+          factorization_->clearArrays();
+        } else if (!factorization_->persistenceFlag()) {
+          // keep factorization arrays for next solve
+          factorization_->setPersistenceFlag(1);
+        }
+      }
+      workArena_.givePivots(pivotVariable_, numberRows2 + 1);
       pivotVariable_ = NULL;
     }
     dualRowPivot_->clearArrays();
     primalColumnPivot_->clearArrays();
   }
 }
+// New nonlinear cost (reusing one kept from last solve if possible)
+ClpNonLinearCost *
+ClpSimplex::createNonLinearCost()
+{
+  ClpNonLinearCost *cost = workArena_.takeNonLinearCost(this);
+  if (!cost)
+    cost = new ClpNonLinearCost(this);
+  return cost;
+}
 // Clean solver
 void ClpSimplex::cleanSolver()
 {
@@ -3732,6 +3756,15 @@ bool ClpSimplex::createRim(int what, bool makeRowCopy, int startFinishOptions)
     // See if we can try for faster row copy
     if (makeRowCopy && !oldMatrix) {
       ClpPackedMatrix *clpMatrix = dynamic_cast< ClpPackedMatrix * >(matrix_);
+#if ABOCA_LITE
+      // spread pages over threads (NUMA) before any special copies
+      if (clpMatrix) {
+        clpMatrix->placeForThreads();
+        ClpPackedMatrix *clpRowCopy = dynamic_cast< ClpPackedMatrix * >(rowCopy_);
+        if (clpRowCopy)
+          clpRowCopy->placeForThreads();
+      }
+#endif
       if (clpMatrix && numberThreads_)
         clpMatrix->specialRowCopy(this, rowCopy_);
       if (clpMatrix)
@@ -3758,16 +3791,17 @@ bool ClpSimplex::createRim(int what, bool makeRowCopy, int startFinishOptions)
           }
 #endif
     if (newArrays && (specialOptions_ & 65536) == 0) {
-      delete[] cost_;
-      cost_ = new double[2 * numberTotal];
-      delete[] lower_;
-      delete[] upper_;
-      lower_ = new double[numberTotal];
-      upper_ = new double[numberTotal];
-      delete[] dj_;
-      dj_ = new double[numberTotal];
-      delete[] solution_;
-      solution_ = new double[numberTotal];
+      // arena gives back arrays from last solve if same size
+      workArena_.giveArray(ClpWorkArena::costArray, cost_, 2 * numberTotal);
+      cost_ = workArena_.takeArray(ClpWorkArena::costArray, 2 * numberTotal);
+      workArena_.giveArray(ClpWorkArena::lowerArray, lower_, numberTotal);
+      workArena_.giveArray(ClpWorkArena::upperArray, upper_, numberTotal);
+      lower_ = workArena_.takeArray(ClpWorkArena::lowerArray, numberTotal);
+      upper_ = workArena_.takeArray(ClpWorkArena::upperArray, numberTotal);
+      workArena_.giveArray(ClpWorkArena::djArray, dj_, numberTotal);
+      dj_ = workArena_.takeArray(ClpWorkArena::djArray, numberTotal);
+      workArena_.giveArray(ClpWorkArena::solutionArray, solution_, numberTotal);
+      solution_ = workArena_.takeArray(ClpWorkArena::solutionArray, numberTotal);
     }
     reducedCostWork_ = dj_;
     rowReducedCost_ = dj_ + numberColumns_;
@@ -4177,8 +4211,8 @@ bool ClpSimplex::createRim(int what, bool makeRowCopy, int startFinishOptions)
   // we need to treat matrix as if each element by rowScaleIn and columnScaleout??
   // maybe we need to move scales to SimplexModel for factorization?
   if ((what == 63 && !pivotVariable_) || (newArrays && !keepPivots)) {
-    delete[] pivotVariable_;
-    pivotVariable_ = new int[numberRows2 + 1];
+    workArena_.givePivots(pivotVariable_, numberRows2 + 1);
+    pivotVariable_ = workArena_.takePivots(numberRows2 + 1);
     for (int i = 0; i < numberRows2 + 1; i++)
       pivotVariable_[i] = -1;
   } else if (what == 63 && !keepPivots) {
@@ -4261,16 +4295,16 @@ bool ClpSimplex::createRim(int what, bool makeRowCopy, int startFinishOptions)
       else if (iRow == 1)
         length = CoinMax(length, numberColumns_);
       if ((specialOptions_ & 65536) == 0 || !rowArray_[iRow]) {
-        delete rowArray_[iRow];
-        rowArray_[iRow] = new CoinIndexedVector();
+        workArena_.giveVector(iRow, rowArray_[iRow]);
+        rowArray_[iRow] = workArena_.takeVector(iRow);
       }
       rowArray_[iRow]->reserve(length);
     }
 
     for (iColumn = 0; iColumn < SHORT_REGION; iColumn++) {
       if ((specialOptions_ & 65536) == 0 || !columnArray_[iColumn]) {
-        delete columnArray_[iColumn];
-        columnArray_[iColumn] = new CoinIndexedVector();
+        workArena_.giveVector(6 + iColumn, columnArray_[iColumn]);
+        columnArray_[iColumn] = workArena_.takeVector(6 + iColumn);
       }
 #if COIN_AVX2
       // allow extra for chunking
@@ -4836,7 +4870,7 @@ void ClpSimplex::deleteRim(int getRidOfFactorizationData)
     gutsOfDelete(getRidOfFactorizationData + 1);
   } else {
     // at least get rid of nonLinearCost_
-    delete nonLinearCost_;
+    workArena_.giveNonLinearCost(nonLinearCost_);
     nonLinearCost_ = NULL;
   }
   if (!rowObjective_ && problemStatus_ == 0 && objective_->type() == 1 && numberRows && numberColumns) {
@@ -7737,6 +7771,20 @@ void ClpSimplex::loadProblem(const int numcols, const int numrows,
     rowObjective);
   createStatus();
 }
+// As above but matrix arrays may be borrowed
+void ClpSimplex::loadProblem(const int numcols, const int numrows,
+  const CoinBigIndex *start, const int *index,
+  const double *value,
+  const double *collb, const double *colub,
+  const double *obj,
+  const double *rowlb, const double *rowub,
+  const double *rowObjective, bool borrowMatrix)
+{
+  ClpModel::loadProblem(numcols, numrows, start, index, value,
+    collb, colub, obj, rowlb, rowub,
+    rowObjective, borrowMatrix);
+  createStatus();
+}
 
 #ifndef SLIM_NOIO
 // This loads a model from a coinModel object - returns number of errors
@@ -8181,7 +8229,7 @@ void ClpSimplex::checkSolution(int setToBounds)
   if (!setToBounds) {
     // Just use column solution
     CoinZeroN(rowActivity_, numberRows_);
-    matrix()->times(columnActivity_, rowActivity_);
+    matrix_->times(1.0, columnActivity_, rowActivity_);
     // put in standard form
     createRim(7 + 8 + 16 + 32);
     dualTolerance_ = dblParam_[ClpDualTolerance];
@@ -9211,7 +9259,7 @@ int ClpSimplex::primalPivotResult()
   upperIn_ = upper_[sequenceIn_];
   dualIn_ = dj_[sequenceIn_];
   if (!nonLinearCost_)
-    nonLinearCost_ = new ClpNonLinearCost(this);
+    nonLinearCost_ = createNonLinearCost();
 
   int returnCode = static_cast< ClpSimplexPrimal * >(this)->pivotResult();
   if (returnCode < 0 && returnCode > -4) {
@@ -9238,6 +9286,9 @@ void ClpSimplex::setFactorizationFrequency(int value)
 // Common bits of coding for dual and primal
 int ClpSimplex::startup(int ifValuesPass, int startFinishOptions)
 {
+  // density statistics are per solve
+  if (factorization_)
+    factorization_->resetSparseStatistics();
   // Get rid of some arrays and empty factorization
   int useFactorization = false;
   if ((startFinishOptions & 2) != 0 && (whatsChanged_ & (2 + 512)) == 2 + 512)
@@ -9353,7 +9404,7 @@ int ClpSimplex::startup(int ifValuesPass, int startFinishOptions)
       eventHandler_->event(ClpEventHandler::beforeCreateNonLinear);
 #endif
       // get a valid nonlinear cost function
-      nonLinearCost_ = new ClpNonLinearCost(this);
+      nonLinearCost_ = createNonLinearCost();
 #ifdef CLP_USER_DRIVEN
       eventHandler_->event(ClpEventHandler::afterCreateNonLinear);
 #endif
@@ -9513,6 +9564,32 @@ void ClpSimplex::finish(int startFinishOptions)
         << objectiveValue()
         << CoinMessageEol;
     }
+    if (factorization_->sparseStatisticsLevel() && handler_->logLevel() > 1) {
+      // density of FTRAN/BTRAN results
+      const ClpSparseStatistics &stats = factorization_->sparseStatistics();
+      const char *name[] = { "FTRAN", "FT update", "BTRAN" };
+      char line[200];
+      for (int i = 0; i < 3; i++) {
+        if (!stats.numberCalls[i])
+          continue;
+        int n = sprintf(line, "%s %d calls, average density %g, histogram",
+          name[i], stats.numberCalls[i],
+          stats.sumDensity[i] / stats.numberCalls[i]);
+        for (int j = 0; j < CLP_SPARSE_BUCKETS; j++)
+          n += sprintf(line + n, " %d", stats.histogram[i][j]);
+        if (factorization_->sparseStatisticsLevel() > 1)
+          sprintf(line + n, ", time %g normal %g hypersparse",
+            stats.time[i][0], stats.time[i][1]);
+        handler_->message(CLP_GENERAL2, messages_)
+          << line << CoinMessageEol;
+      }
+      if (stats.numberSwitches) {
+        sprintf(line, "Hypersparse switched on or off %d times",
+          stats.numberSwitches);
+        handler_->message(CLP_GENERAL2, messages_)
+          << line << CoinMessageEol;
+      }
+    }
   }
   factorization_->relaxAccuracyCheck(1.0);
   // get rid of any network stuff - could do more
@@ -9615,8 +9692,8 @@ ClpSimplex::checkScaling()
       cost_[i] *= multiplierObj;
     }
     if (algorithm_>0) {
-      delete nonLinearCost_; 
-      nonLinearCost_ = new ClpNonLinearCost(this);
+      workArena_.giveNonLinearCost(nonLinearCost_);
+      nonLinearCost_ = createNonLinearCost();
       nonLinearCost_->checkInfeasibilities(0);
     }
     return COIN_INT_MAX;
@@ -9684,8 +9761,8 @@ ClpSimplex::checkScaling()
 	}
       }
       if (algorithm_>0) {
-	delete nonLinearCost_; 
-	nonLinearCost_ = new ClpNonLinearCost(this);
+	workArena_.giveNonLinearCost(nonLinearCost_);
+	nonLinearCost_ = createNonLinearCost();
 	nonLinearCost_->checkInfeasibilities(0);
       }
     } else {
@@ -13251,159 +13328,3 @@ void ClpSimplex::copyEnabledStuff(const ClpSimplex *rhs)
   if (rhs->primalColumnPivot_)
     primalColumnPivot_ = rhs->primalColumnPivot_->clone();
 }
-CoinPthreadStuff::CoinPthreadStuff(int numberThreads,
-  void *parallelManager(void *stuff))
-{
-#if defined(ABC_INHERIT) || defined(THREADS_IN_ANALYZE)
-  numberThreads_ = numberThreads;
-  if (numberThreads > 8)
-    numberThreads = 1;
-  // For waking up thread
-  memset(mutex_, 0, sizeof(mutex_));
-  for (int iThread = 0; iThread < numberThreads; iThread++) {
-    for (int i = 0; i < 3; i++) {
-      pthread_mutex_init(&mutex_[i + 3 * iThread], NULL);
-      if (i < 2)
-        pthread_mutex_lock(&mutex_[i + 3 * iThread]);
-    }
-    threadInfo_[iThread].status = 100;
-  }
-#ifdef PTHREAD_BARRIER_SERIAL_THREAD
-  //pthread_barrierattr_t attr;
-  pthread_barrier_init(&barrier_, /*&attr*/ NULL, numberThreads + 1);
-#endif
-  for (int iThread = 0; iThread < numberThreads; iThread++) {
-    pthread_create(&abcThread_[iThread], NULL, parallelManager, reinterpret_cast< void * >(this));
-  }
-#ifdef PTHREAD_BARRIER_SERIAL_THREAD
-  pthread_barrier_wait(&barrier_);
-  pthread_barrier_destroy(&barrier_);
-#endif
-  for (int iThread = 0; iThread < numberThreads; iThread++) {
-    threadInfo_[iThread].status = -1;
-    threadInfo_[iThread].stuff[3] = 1; // idle
-    locked_[iThread] = 0;
-  }
-  #endif
-}
-CoinPthreadStuff::~CoinPthreadStuff()
-{
-#if defined(ABC_INHERIT) || defined(THREADS_IN_ANALYZE)
-  for (int iThread = 0; iThread < numberThreads_; iThread++) {
-    startParallelTask(1000, iThread);
-  }
-  for (int iThread = 0; iThread < numberThreads_; iThread++) {
-    pthread_join(abcThread_[iThread], NULL);
-    for (int i = 0; i < 3; i++) {
-      pthread_mutex_destroy(&mutex_[i + 3 * iThread]);
-    }
-  }
-#endif
-}
-// so thread can find out which one it is
-int CoinPthreadStuff::whichThread() const
-{
-#if defined(ABC_INHERIT) || defined(THREADS_IN_ANALYZE)
-  pthread_t thisThread = pthread_self();
-  int whichThread;
-  for (whichThread = 0; whichThread < numberThreads_; whichThread++) {
-    if (pthread_equal(thisThread, abcThread_[whichThread]))
-      break;
-  }
-  assert(whichThread < NUMBER_THREADS + 1);
-  return whichThread;
-  #else
-  return 0;
-  #endif
-}
-void CoinPthreadStuff::startParallelTask(int type, int iThread, void *info)
-{
-  /*
-    first time 0,1 owned by main 2 by child
-    at end of cycle should be 1,2 by main 0 by child then 2,0 by main 1 by child
-  */
-#if defined(ABC_INHERIT) || defined(THREADS_IN_ANALYZE)
-  threadInfo_[iThread].status = type;
-  threadInfo_[iThread].extraInfo = info;
-  threadInfo_[iThread].stuff[3] = 0; // say not idle
-#ifdef DETAIL_THREAD
-  printf("main doing thread %d about to unlock mutex %d\n", iThread, locked_[iThread]);
-#endif
-  pthread_mutex_unlock(&mutex_[locked_[iThread] + 3 * iThread]);
-  #endif
-}
-void CoinPthreadStuff::sayIdle(int iThread)
-{
-#if defined(ABC_INHERIT) || defined(THREADS_IN_ANALYZE)
-  threadInfo_[iThread].status = -1;
-  threadInfo_[iThread].stuff[3] = -1;
-#endif
-}
-int CoinPthreadStuff::waitParallelTask(int type, int &iThread, bool allowIdle)
-{
-#if defined(ABC_INHERIT) || defined(THREADS_IN_ANALYZE)
-  bool finished = false;
-  if (allowIdle) {
-    for (iThread = 0; iThread < numberThreads_; iThread++) {
-      if (threadInfo_[iThread].status < 0 && threadInfo_[iThread].stuff[3]) {
-        finished = true;
-        break;
-      }
-    }
-    if (finished)
-      return 0;
-  }
-  while (!finished) {
-    for (iThread = 0; iThread < numberThreads_; iThread++) {
-      if (threadInfo_[iThread].status < 0 && !threadInfo_[iThread].stuff[3]) {
-        finished = true;
-        break;
-      }
-    }
-    if (!finished) {
-#ifdef _WIN32
-      // wait 1 millisecond
-      Sleep(1);
-#else
-      // wait 0.1 millisecond
-      usleep(100);
-#endif
-    }
-  }
-  int locked = locked_[iThread] + 2;
-  if (locked >= 3)
-    locked -= 3;
-#ifdef DETAIL_THREAD
-  printf("Main do thread %d about to lock mutex %d\n", iThread, locked);
-#endif
-  pthread_mutex_lock(&mutex_[locked + iThread * 3]);
-  locked_[iThread]++;
-  if (locked_[iThread] == 3)
-    locked_[iThread] = 0;
-  threadInfo_[iThread].stuff[3] = 1; // say idle
-  return threadInfo_[iThread].stuff[0];
-#else
-  return 0;
-#endif
-}
-void CoinPthreadStuff::waitAllTasks()
-{
-#if defined(ABC_INHERIT) || defined(THREADS_IN_ANALYZE)
-  int nWait = 0;
-  for (int iThread = 0; iThread < numberThreads_; iThread++) {
-    int idle = threadInfo_[iThread].stuff[3];
-    if (!idle)
-      nWait++;
-  }
-#ifdef DETAIL_THREAD
-  printf("Waiting for %d tasks to finish\n", nWait);
-#endif
-  for (int iThread = 0; iThread < nWait; iThread++) {
-    int jThread;
-    waitParallelTask(0, jThread, false);
-#ifdef DETAIL_THREAD
-    printf("finished with thread %d\n", jThread);
-#endif
-  }
-#endif
-}
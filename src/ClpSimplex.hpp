@@ -16,6 +16,7 @@
 #include "ClpModel.hpp"
 #include "ClpMatrixBase.hpp"
 #include "ClpSolve.hpp"
+#include "ClpWorkArena.hpp"
 #include "ClpConfig.h"
 #include "CoinIndexedVector.hpp"
 
@@ -251,6 +252,15 @@ public:
     const double *obj,
     const double *rowlb, const double *rowub,
     const double *rowObjective = NULL);
+  /** As above but if borrowMatrix true then matrix arrays are used in
+       place (see ClpModel) */
+  void loadProblem(const int numcols, const int numrows,
+    const CoinBigIndex *start, const int *index,
+    const double *value,
+    const double *collb, const double *colub,
+    const double *obj,
+    const double *rowlb, const double *rowub,
+    const double *rowObjective, bool borrowMatrix);
   /// This one is for after presolve to save memory
   void loadProblem(const int numcols, const int numrows,
     const CoinBigIndex *start, const int *index,
@@ -1409,6 +1419,18 @@ public:
   }
   /// Set pointer to details of costs
   void setNonLinearCost(ClpNonLinearCost &nonLinearCost);
+  /// New details of costs (reusing those from last solve if possible)
+  ClpNonLinearCost *createNonLinearCost();
+  /** Whether work arrays are kept for next solve (default true)
+         so resolves of same size do not allocate */
+  inline bool keepWorkArrays() const
+  {
+    return workArena_.active();
+  }
+  inline void setKeepWorkArrays(bool yesNo)
+  {
+    workArena_.setActive(yesNo);
+  }
   /** Return more special options
          1 bit - if presolve says infeasible in ClpSolve return
          2 bit - if presolved problem infeasible return
@@ -1975,6 +1997,8 @@ protected:
   ClpSimplex *baseModel_;
   /// For dealing with all issues of cycling etc
   ClpSimplexProgress progress_;
+  /// Work arrays kept between solves
+  ClpWorkArena workArena_;
 #ifdef ABC_INHERIT
   AbcSimplex *abcSimplex_;
   int abcState_;
@@ -1982,6 +2006,8 @@ protected:
 #define CLP_ABC_WANTED_PARALLEL 2
 #define CLP_ABC_FULL_DONE 8
   // bits 256,512,1024 for crash
+  // bits 2048,4096 for factorization memory mode
+#define CLP_ABC_MEMORY_MODE 2048
 #endif
 #define CLP_ABC_BEEN_FEASIBLE 65536
   /// Number of degenerate pivots since last perturbed
@@ -2038,71 +2064,9 @@ typedef struct {
   int status;
   int stuff[4];
 } CoinThreadInfo;
-class CLPLIB_EXPORT CoinPthreadStuff {
-public:
-  /**@name Constructors and destructor and copy */
-  //@{
-  /** Main constructor
-  */
-  CoinPthreadStuff(int numberThreads = 0,
-    void *parallelManager(void *stuff) = NULL);
-  /// Assignment operator. This copies the data
-  CoinPthreadStuff &operator=(const CoinPthreadStuff &rhs);
-  /// Destructor
-  ~CoinPthreadStuff();
-  /// set stop start
-  inline void setStopStart(int value)
-  {
-    stopStart_ = value;
-  }
 #ifndef NUMBER_THREADS
 #define NUMBER_THREADS 8
 #endif
-#ifdef CLP_USE_PTHREADS
-  // For waking up thread
-  inline pthread_mutex_t *mutexPointer(int which, int thread = 0)
-  {
-    return mutex_ + which + 3 * thread;
-  }
-#ifdef PTHREAD_BARRIER_SERIAL_THREAD
-  inline pthread_barrier_t *barrierPointer()
-  {
-    return &barrier_;
-  }
-#endif
-#endif
-  inline int whichLocked(int thread = 0) const
-  {
-    return locked_[thread];
-  }
-  inline CoinThreadInfo *threadInfoPointer(int thread = 0)
-  {
-    return threadInfo_ + thread;
-  }
-  void startParallelTask(int type, int iThread, void *info = NULL);
-  int waitParallelTask(int type, int &iThread, bool allowIdle);
-  void waitAllTasks();
-  /// so thread can find out which one it is
-  int whichThread() const;
-  void sayIdle(int iThread);
-  //void startThreads(int numberThreads);
-  //void stopThreads();
-  // For waking up thread
-#ifdef CLP_USE_PTHREADS
-  pthread_mutex_t mutex_[3 * (NUMBER_THREADS + 1)];
-#ifdef PTHREAD_BARRIER_SERIAL_THREAD
-  pthread_barrier_t barrier_;
-#endif
-#endif
-  CoinThreadInfo threadInfo_[NUMBER_THREADS + 1];
-#ifdef CLP_USE_PTHREADS
-  pthread_t abcThread_[NUMBER_THREADS + 1];
-#endif
-  int locked_[NUMBER_THREADS + 1];
-  int stopStart_;
-  int numberThreads_;
-};
-void *clp_parallelManager(void *stuff);
 typedef struct {
   double upperTheta;
   double bestPossible;
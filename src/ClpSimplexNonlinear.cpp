@@ -56,7 +56,11 @@ int ClpSimplexNonlinear::primal()
     if (!quadraticObj->fullMatrix() && (!rowScale_ && !scalingFlag_) && objectiveScale_ == 1.0) {
       saveObjective = objective_;
       objective_ = new ClpQuadraticObjective(*quadraticObj, 1);
+      quadraticObj = static_cast< ClpQuadraticObjective * >(objective_);
     }
+    // only update gradient for columns which have moved
+    if (quadraticObj)
+      quadraticObj->activateIncrementalGradient(true);
   }
   double bestObjectiveWhenFlagged = COIN_DBL_MAX;
   int pivotMode = 15;
@@ -187,6 +191,8 @@ int ClpSimplexNonlinear::primal()
   unflag();
   finish();
   restoreData(data);
+  if (objective_->type() == 2)
+    static_cast< ClpQuadraticObjective * >(objective_)->activateIncrementalGradient(false);
   // restore objective if full
   if (saveObjective) {
     delete objective_;
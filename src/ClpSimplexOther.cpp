@@ -23,6 +23,7 @@
 #include "CoinFloatEqual.hpp"
 #include "ClpMessage.hpp"
 #include "CoinTime.hpp"
+#include "ClpTaskPool.hpp"
 #include <cfloat>
 #include <cassert>
 #include <string>
@@ -2430,6 +2431,8 @@ int ClpSimplexOther::parametrics(double startingTheta, double &endingTheta, doub
   bool canTryQuick = (reportIncrement) ? true : false;
   // Save copy of model
   ClpSimplex copyModel = *this;
+  if (eventHandler_)
+    eventHandler_->eventWithInfo(ClpEventHandler::parametricsStart, NULL);
   int savePerturbation = perturbation_;
   perturbation_ = 102; // switch off
   while (needToDoSomething) {
@@ -2442,7 +2445,7 @@ int ClpSimplexOther::parametrics(double startingTheta, double &endingTheta, doub
     ClpDualRowPivot *savePivot = dualRowPivot_;
     dualRowPivot_ = new ClpDualRowDantzig();
     dualRowPivot_->setModel(this);
-    int returnCode = reinterpret_cast< ClpSimplexDual * >(this)->startupSolve(0, NULL, 0);
+    int returnCode = reinterpret_cast< ClpSimplexDual * >(this)->startupSolve(0, NULL, 2);
     int iRow, iColumn;
     double *chgUpper = NULL;
     double *chgLower = NULL;
@@ -2544,8 +2547,7 @@ int ClpSimplexOther::parametrics(double startingTheta, double &endingTheta, doub
       for (int i = 0; i < numberRows_ + numberColumns_; i++)
         setFakeBound(i, noFake);
       // Now do parametrics
-      handler_->message(CLP_PARAMETRICS_STATS, messages_)
-        << startingTheta << objectiveValue() << CoinMessageEol;
+      reportBreakpoint(startingTheta);
       while (!returnCode) {
         //assert (reportIncrement);
         parametricsData paramData;
@@ -2568,8 +2570,7 @@ int ClpSimplexOther::parametrics(double startingTheta, double &endingTheta, doub
           //upper_[i] += change*chgUpper[i];
           //cost_[i] += change*chgObjective[i];
           //}
-          handler_->message(CLP_PARAMETRICS_STATS, messages_)
-            << startingTheta << objectiveValue() << CoinMessageEol;
+          reportBreakpoint(startingTheta);
           if (startingTheta >= endingTheta)
             break;
         } else if (returnCode == -1) {
@@ -2578,8 +2579,7 @@ int ClpSimplexOther::parametrics(double startingTheta, double &endingTheta, doub
         } else if (problemStatus_ == 1) {
           // can't move any further
           if (!canTryQuick) {
-            handler_->message(CLP_PARAMETRICS_STATS, messages_)
-              << endingTheta << objectiveValue() << CoinMessageEol;
+            reportBreakpoint(endingTheta);
             problemStatus_ = 0;
           }
         } else {
@@ -3207,6 +3207,250 @@ int ClpSimplexOther::parametrics(const char *dataFile)
   fclose(fp);
   return returnCode;
 }
+// Reports breakpoint (message and parametricsBreakpoint event)
+void ClpSimplexOther::reportBreakpoint(double theta, int sequenceIn, int sequenceOut)
+{
+  ClpParametricsBreakpoint info;
+  info.theta = theta;
+  info.objective = objectiveValue();
+  info.sequenceIn = sequenceIn;
+  info.sequenceOut = sequenceOut;
+  info.numberChanged = 0;
+  info.which = NULL;
+  info.primal = NULL;
+  info.dual = NULL;
+  handler_->message(CLP_PARAMETRICS_STATS, messages_)
+    << info.theta << info.objective << CoinMessageEol;
+  if (eventHandler_)
+    eventHandler_->eventWithInfo(ClpEventHandler::parametricsBreakpoint, &info);
+}
+//#############################################################################
+// ClpParametricsStream
+//#############################################################################
+
+ClpParametricsStream::ClpParametricsStream(bool wantDeltas)
+  : ClpEventHandler()
+  , lastValues_(NULL)
+  , which_(NULL)
+  , changes_(NULL)
+  , numberTotal_(0)
+  , wantDeltas_(wantDeltas)
+{
+}
+ClpParametricsStream::ClpParametricsStream(const ClpParametricsStream &rhs)
+  : ClpEventHandler(rhs)
+  , lastValues_(NULL)
+  , which_(NULL)
+  , changes_(NULL)
+  , numberTotal_(0)
+  , wantDeltas_(rhs.wantDeltas_)
+{
+}
+ClpParametricsStream &
+ClpParametricsStream::operator=(const ClpParametricsStream &rhs)
+{
+  if (this != &rhs) {
+    ClpEventHandler::operator=(rhs);
+    restart();
+    wantDeltas_ = rhs.wantDeltas_;
+  }
+  return *this;
+}
+ClpParametricsStream::~ClpParametricsStream()
+{
+  restart();
+}
+// Forget saved values so next breakpoint gives everything
+void ClpParametricsStream::restart()
+{
+  delete[] lastValues_;
+  delete[] which_;
+  delete[] changes_;
+  lastValues_ = NULL;
+  which_ = NULL;
+  changes_ = NULL;
+  numberTotal_ = 0;
+}
+// Picks up parametricsBreakpoint
+int ClpParametricsStream::eventWithInfo(Event whichEvent, void *info)
+{
+  if (whichEvent == parametricsStart) {
+    // new run so first breakpoint gives everything
+    restart();
+    return -1;
+  } else if (whichEvent != parametricsBreakpoint) {
+    return -1;
+  }
+  ClpParametricsBreakpoint breakpointInfo = *reinterpret_cast< ClpParametricsBreakpoint * >(info);
+  if (wantDeltas_ && model_) {
+    int numberTotal = model_->numberRows() + model_->numberColumns();
+    const double *solution = model_->solutionRegion();
+    const double *dj = model_->djRegion();
+    if (numberTotal != numberTotal_) {
+      // first breakpoint of run - compare with zero
+      restart();
+      numberTotal_ = numberTotal;
+      lastValues_ = new double[2 * numberTotal];
+      CoinZeroN(lastValues_, 2 * numberTotal);
+      which_ = new int[numberTotal];
+      changes_ = new double[2 * numberTotal];
+    }
+    double *lastPrimal = lastValues_;
+    double *lastDual = lastValues_ + numberTotal;
+    double *primal = changes_;
+    double *dual = changes_ + numberTotal;
+    int numberChanged = 0;
+    for (int i = 0; i < numberTotal; i++) {
+      if (solution[i] != lastPrimal[i] || dj[i] != lastDual[i]) {
+        lastPrimal[i] = solution[i];
+        lastDual[i] = dj[i];
+        which_[numberChanged] = i;
+        primal[numberChanged] = solution[i];
+        dual[numberChanged++] = dj[i];
+      }
+    }
+    breakpointInfo.numberChanged = numberChanged;
+    breakpointInfo.which = which_;
+    breakpointInfo.primal = primal;
+    breakpointInfo.dual = dual;
+  }
+  breakpoint(breakpointInfo);
+  return -1;
+}
+// Records breakpoints for parametricsBatch
+class ClpBreakpointRecorder : public ClpParametricsStream {
+
+public:
+  ClpBreakpointRecorder()
+    : ClpParametricsStream(false)
+    , scenario_(NULL)
+  {
+  }
+  virtual ~ClpBreakpointRecorder() {}
+  virtual ClpEventHandler *clone() const
+  {
+    return new ClpBreakpointRecorder(*this);
+  }
+  virtual void breakpoint(const ClpParametricsBreakpoint &info)
+  {
+    if (!scenario_)
+      return;
+    int n = scenario_->numberBreakpoints;
+    // same theta reported at end of one section and start of next
+    if (n && n <= scenario_->maximumBreakpoints
+      && scenario_->theta[n - 1] == info.theta) {
+      scenario_->objective[n - 1] = info.objective;
+    } else {
+      if (n < scenario_->maximumBreakpoints) {
+        scenario_->theta[n] = info.theta;
+        scenario_->objective[n] = info.objective;
+      }
+      scenario_->numberBreakpoints++;
+    }
+  }
+  /// Direction being done
+  ClpSimplexOther::parametricsScenario *scenario_;
+};
+typedef struct {
+  const ClpSimplex *base;
+  CoinMessageHandler **handlers;
+  ClpSimplexOther::parametricsScenario *scenarios;
+  ClpTaskPool *pool;
+  double startingTheta;
+} clpParametricsBatch;
+typedef struct {
+  clpParametricsBatch *batch;
+  int which;
+} clpParametricsItem;
+// Does one direction of parametricsBatch (in a thread)
+static int clpParametricsTask(void *stuff)
+{
+  clpParametricsItem *task = reinterpret_cast< clpParametricsItem * >(stuff);
+  clpParametricsBatch *batch = task->batch;
+  ClpSimplexOther::parametricsScenario &scenario = batch->scenarios[task->which];
+  /* Copy of base has its optimal basis, solution and factorization
+     (base was solved keeping them) so parametrics starts without
+     factorizing */
+  ClpSimplex model(*batch->base);
+  // own quiet handler as messages come from several threads
+  model.passInMessageHandler(batch->handlers[batch->pool->whichThread()]);
+  ClpBreakpointRecorder *recorder = dynamic_cast< ClpBreakpointRecorder * >(model.eventHandler());
+  assert(recorder);
+  scenario.numberBreakpoints = 0;
+  recorder->scenario_ = &scenario;
+  ClpSimplexOther *other = static_cast< ClpSimplexOther * >(&model);
+  if (scenario.changeObjective) {
+    scenario.returnCode = other->parametrics(batch->startingTheta, scenario.endingTheta, 0.0,
+      scenario.changeLowerBound, scenario.changeUpperBound,
+      scenario.changeLowerRhs, scenario.changeUpperRhs,
+      scenario.changeObjective);
+  } else {
+    scenario.returnCode = other->parametrics(batch->startingTheta, scenario.endingTheta,
+      scenario.changeLowerBound, scenario.changeUpperBound,
+      scenario.changeLowerRhs, scenario.changeUpperRhs);
+  }
+  recorder->scenario_ = NULL;
+  return scenario.returnCode;
+}
+/* Parametrics for many independent directions on same model.
+   A copy of model is solved keeping its factorization and each
+   direction starts from a copy of that. */
+int ClpSimplexOther::parametricsBatch(double startingTheta, int numberScenarios,
+  parametricsScenario *scenarios, int numberThreads)
+{
+  if (problemStatus_ || !status_)
+    dual();
+  if (problemStatus_)
+    return -1;
+  if (!numberScenarios)
+    return 0;
+  ClpTaskPool *pool = ClpTaskPool::shared(numberThreads);
+  int numberCopies = pool->numberThreads() + 1;
+  CoinMessageHandler **handlers = new CoinMessageHandler *[numberCopies];
+  for (int i = 0; i < numberCopies; i++) {
+    handlers[i] = new CoinMessageHandler();
+    handlers[i]->setLogLevel(0);
+  }
+  ClpBreakpointRecorder recorder;
+  ClpSimplex base(*this);
+  base.passInMessageHandler(handlers[numberCopies - 1]);
+  base.passInEventHandler(&recorder);
+  // parametrics with objective changes needs unscaled model
+  base.scaling(0);
+  // optimal already so just factorizes - keep factorization and arrays
+  base.dual(0, 1);
+  int numberShort = 0;
+  if (!base.problemStatus()) {
+    clpParametricsBatch batch;
+    batch.base = &base;
+    batch.handlers = handlers;
+    batch.scenarios = scenarios;
+    batch.pool = pool;
+    batch.startingTheta = startingTheta;
+    clpParametricsItem *tasks = new clpParametricsItem[numberScenarios];
+    // wait on own tasks (pool may be doing other work)
+    ClpTaskFuture *futures = new ClpTaskFuture[numberScenarios];
+    for (int i = 0; i < numberScenarios; i++) {
+      tasks[i].batch = &batch;
+      tasks[i].which = i;
+      pool->submit(clpParametricsTask, tasks + i, futures + i);
+    }
+    for (int i = 0; i < numberScenarios; i++) {
+      if (futures[i].wait())
+        numberShort++;
+    }
+    delete[] futures;
+    delete[] tasks;
+  } else {
+    numberShort = -1;
+  }
+  // base points to last handler
+  base.setDefaultMessageHandler();
+  for (int i = 0; i < numberCopies; i++)
+    delete handlers[i];
+  delete[] handlers;
+  return numberShort;
+}
 int ClpSimplexOther::parametricsLoop(parametricsData &paramData, double reportIncrement,
   const double *lowerChange, const double *upperChange,
   const double *changeObjective, ClpDataSave &data,
@@ -3339,6 +3583,8 @@ int ClpSimplexOther::parametrics(double startingTheta, double &endingTheta,
   int savePerturbation = perturbation_;
   perturbation_ = 102; // switch off
   algorithm_ = -1;
+  if (eventHandler_)
+    eventHandler_->eventWithInfo(ClpEventHandler::parametricsStart, NULL);
   // extra region
   int maximumPivots = factorization_->maximumPivots();
   int numberDense = factorization_->numberDense();
@@ -3485,7 +3731,7 @@ int ClpSimplexOther::parametrics(double startingTheta, double &endingTheta,
   if (!returnCode) {
     assert(objective_->type() == 1);
     objective_->setType(2); // in case matrix empty
-    returnCode = reinterpret_cast< ClpSimplexDual * >(this)->startupSolve(0, NULL, 0);
+    returnCode = reinterpret_cast< ClpSimplexDual * >(this)->startupSolve(0, NULL, 2);
     objective_->setType(1);
     if (!returnCode) {
       double saveDualBound = dualBound_;
@@ -3571,8 +3817,7 @@ int ClpSimplexOther::parametrics(double startingTheta, double &endingTheta,
           //for (int i=0;i<numberRows_+numberColumns_;i++)
           //setFakeBound(i, noFake);
           // Now do parametrics
-          handler_->message(CLP_PARAMETRICS_STATS, messages_)
-            << startingTheta << objectiveValue() << CoinMessageEol;
+          reportBreakpoint(startingTheta);
           bool canSkipFactorization = true;
           while (!returnCode) {
             paramData.startingTheta = startingTheta;
@@ -3585,8 +3830,7 @@ int ClpSimplexOther::parametrics(double startingTheta, double &endingTheta,
             if (!returnCode) {
               //startingTheta = endingTheta;
               //endingTheta = saveEndingTheta;
-              handler_->message(CLP_PARAMETRICS_STATS, messages_)
-                << startingTheta << objectiveValue() << CoinMessageEol;
+              reportBreakpoint(startingTheta);
               if (startingTheta >= endingTheta - primalTolerance_
                 || problemStatus_ == 2)
                 break;
@@ -3595,8 +3839,7 @@ int ClpSimplexOther::parametrics(double startingTheta, double &endingTheta,
               abort(); //needToDoSomething = true;
             } else if (problemStatus_ == 1) {
               // can't move any further
-              handler_->message(CLP_PARAMETRICS_STATS, messages_)
-                << endingTheta << objectiveValue() << CoinMessageEol;
+              reportBreakpoint(endingTheta);
               problemStatus_ = 0;
             }
           }
@@ -4147,8 +4390,7 @@ int ClpSimplexOther::whileIterating(parametricsData &paramData, double /*reportI
     sequenceIn_ = -1;
     if (pivotType) {
       if (useTheta > lastTheta + 1.0e-9) {
-        handler_->message(CLP_PARAMETRICS_STATS, messages_)
-          << useTheta << objectiveValue() << CoinMessageEol;
+        reportBreakpoint(useTheta);
         lastTheta = useTheta;
       }
       problemStatus_ = -2;
@@ -4637,8 +4879,7 @@ int ClpSimplexOther::whileIterating(parametricsData &paramData, double /*reportI
             << in << out << CoinMessageEol;
         }
         if (useTheta > lastTheta + 1.0e-9) {
-          handler_->message(CLP_PARAMETRICS_STATS, messages_)
-            << useTheta << objectiveValue() << CoinMessageEol;
+          reportBreakpoint(useTheta, sequenceIn_, sequenceOut_);
           lastTheta = useTheta;
         }
         // and set bounds correctly
@@ -9014,6 +9255,9 @@ int ClpSimplex::outDuplicateRows(int numberLook, int *whichRows, bool noOverlaps
     // New model (put in modification to increase size of matrix) and pack
     bool needExtension = numberColumns_ > matrix_->getNumCols();
     if (needExtension) {
+      ClpPackedMatrix *clpMatrix = dynamic_cast< ClpPackedMatrix * >(matrix_);
+      if (clpMatrix)
+        clpMatrix->ownArrays();
       matrix()->reserve(numberColumns_, lastElement, true);
       CoinBigIndex *columnStart = matrix()->getMutableVectorStarts();
       for (int i = numberColumns_; i >= 0; i--) {
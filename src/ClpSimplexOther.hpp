@@ -11,6 +11,72 @@
 #define ClpSimplexOther_H
 
 #include "ClpSimplex.hpp"
+#include "ClpEventHandler.hpp"
+
+/** Passed as info with ClpEventHandler::parametricsBreakpoint
+    each time parametrics reports a breakpoint (start, basis change
+    and end of each section).
+    sequenceIn/Out are only filled in where parametrics does the pivot
+    itself (one breakpoint per basis change).  They are -1 at the start
+    and end of each section, when theta stops short for a bound crossing
+    and when a reportIncrement is given (then dual simplex does the
+    pivots and there may be several between breakpoints).
+    Changes are only filled in by ClpParametricsStream (if asked for).
+*/
+typedef struct {
+  double theta;
+  double objective;
+  int sequenceIn;
+  int sequenceOut;
+  /// Number of sequences whose value or dj changed since last breakpoint
+  int numberChanged;
+  /// Which sequences (columns then rows as numberColumns+iRow)
+  const int *which;
+  /// New primal values (working - so scaled if model is scaled)
+  const double *primal;
+  /// New reduced costs / row duals (working)
+  const double *dual;
+} ClpParametricsBreakpoint;
+
+/** Streams parametrics breakpoints to breakpoint() as they happen.
+
+    Derive from this (with clone) and pass to ClpSimplex::passInEventHandler
+    before calling parametrics (including the file version).  If deltas are
+    wanted then at each breakpoint just the variables whose value or
+    reduced cost changed since the last breakpoint are given, so a
+    consumer does not need full solutions at every breakpoint.  The first
+    breakpoint of each run gives all nonzero values (saved values are
+    forgotten on parametricsStart).
+*/
+class CLPLIB_EXPORT ClpParametricsStream : public ClpEventHandler {
+
+public:
+  /// Constructor - if wantDeltas then changes given at each breakpoint
+  ClpParametricsStream(bool wantDeltas = false);
+  /// Copy (does not copy saved values)
+  ClpParametricsStream(const ClpParametricsStream &rhs);
+  /// Assignment
+  ClpParametricsStream &operator=(const ClpParametricsStream &rhs);
+  /// Destructor
+  virtual ~ClpParametricsStream();
+  /// Called at each breakpoint
+  virtual void breakpoint(const ClpParametricsBreakpoint &info) = 0;
+  /// Picks up parametricsStart and parametricsBreakpoint
+  virtual int eventWithInfo(Event whichEvent, void *info);
+  /// Forget saved values so next breakpoint gives everything
+  void restart();
+
+protected:
+  /// Last values (primal then dual)
+  double *lastValues_;
+  /// Space for changes
+  int *which_;
+  double *changes_;
+  /// Length of saved arrays (numberColumns+numberRows)
+  int numberTotal_;
+  /// True if deltas wanted
+  bool wantDeltas_;
+};
 
 /** This is for Simplex stuff which is neither dual nor primal
 
@@ -88,7 +154,9 @@ public:
     const double *changeObjective);
   /** Version of parametrics which reads from file
 	 See CbcClpParam.cpp for details of format
-	 Returns -2 if unable to open file */
+	 Returns -2 if unable to open file.
+	 Breakpoints also go to any ClpParametricsStream passed in
+	 as event handler */
   int parametrics(const char *dataFile);
   /** Parametrics
          This is an initial slow version.
@@ -104,6 +172,40 @@ public:
     const double *changeLowerRhs, const double *changeUpperRhs);
   int parametricsObj(double startingTheta, double &endingTheta,
     const double *changeObjective);
+  /** One direction for parametricsBatch.
+      Change arrays are as for parametrics, are not owned and may be NULL.
+      theta and objective are given by caller (maximumBreakpoints long)
+      and on exit hold breakpoints of the piecewise linear objective.
+      numberBreakpoints is number found (may be more than maximum).
+      endingTheta is wanted on entry and reached on exit and
+      returnCode is as parametrics.
+  */
+  typedef struct {
+    const double *changeLowerBound;
+    const double *changeUpperBound;
+    const double *changeLowerRhs;
+    const double *changeUpperRhs;
+    const double *changeObjective;
+    double endingTheta;
+    double *theta;
+    double *objective;
+    int maximumBreakpoints;
+    int numberBreakpoints;
+    int returnCode;
+  } parametricsScenario;
+  /** Parametrics for many independent directions on same model.
+      Model is solved if not optimal.  Each direction starts from
+      startingTheta with optimal basis of model.  Directions are shared
+      over numberThreads threads (ClpTaskPool).  An unscaled copy of model
+      is solved keeping its factorization and each direction starts from
+      a copy of that, so directions do not factorize before their first
+      pivot.  Model is not changed.
+      Directions with only bound/rhs changes use fast version of parametrics.
+      Returns number of directions which did not get to endingTheta
+      or -1 if model could not be solved.
+  */
+  int parametricsBatch(double startingTheta, int numberScenarios,
+    parametricsScenario *scenarios, int numberThreads = 0);
   /// Finds best possible pivot
   double bestPivot(bool justColumns = false);
   typedef struct {
@@ -173,6 +275,8 @@ private:
     const double *changeObjective);
   int whileIteratingObj(parametricsData &paramData);
   int nextThetaObj(double maxTheta, parametricsData &paramData);
+  /// Reports breakpoint (message and parametricsBreakpoint event)
+  void reportBreakpoint(double theta, int sequenceIn = -1, int sequenceOut = -1);
   /// Restores bound to original bound
   void originalBound(int iSequence, double theta, const double *changeLower,
     const double *changeUpper);
@@ -33,6 +33,8 @@
 #include "ClpInterior.hpp"
 #include "ClpCholeskyDense.hpp"
 #include "ClpCholeskyBase.hpp"
+#include "ClpCholeskyPCG.hpp"
+#include "ClpCholeskyMixed.hpp"
 #include "ClpPlusMinusOneMatrix.hpp"
 #include "ClpNetworkMatrix.hpp"
 #endif
@@ -41,6 +43,7 @@
 #include "ClpSolve.hpp"
 #include "ClpPackedMatrix.hpp"
 #include "ClpMessage.hpp"
+#include "ClpTaskPool.hpp"
 #include "CoinTime.hpp"
 #if CLP_HAS_ABC
 #include "CoinAbcCommon.hpp"
@@ -583,6 +586,7 @@ ClpSimplex::dealWithAbc(int solveType, int startUp,
     // move factorization stuff
     abcModel2->factorization()->synchronize(this->factorization(), abcModel2);
     //}
+    abcModel2->factorization()->setMemoryMode((abcState_ / CLP_ABC_MEMORY_MODE) & 3);
     //abcModel2->startPermanentArrays();
     int crashState = abcModel2->abcState() & (256 + 512 + 1024);
     abcModel2->setAbcState(CLP_ABC_WANTED | crashState | (abcModel2->abcState() & 15));
@@ -837,6 +841,293 @@ ClpSimplex::dealWithAbc(int solveType, int startUp,
   return abcModel2;
 }
 #endif
+#ifndef SLIM_CLP
+typedef struct {
+  ClpSimplex *model;
+  int returnCode;
+} clpCrossoverPush;
+// Primal values pass on one set of columns (in a thread)
+static int clpCrossoverPushTask(void *stuff)
+{
+  clpCrossoverPush *push = reinterpret_cast< clpCrossoverPush * >(stuff);
+  push->model->primal(2);
+  push->returnCode = push->model->problemStatus();
+  return push->returnCode;
+}
+static int clpFindRoot(int *parent, int iRow)
+{
+  int root = iRow;
+  while (parent[root] != root)
+    root = parent[root];
+  while (parent[iRow] != root) {
+    int next = parent[iRow];
+    parent[iRow] = root;
+    iRow = next;
+  }
+  return root;
+}
+/* Crossover push after barrier.  Basic and superbasic columns are split
+   into sets which have no rows in common.  Columns at bounds are fixed
+   and moved into row bounds so each set (several small ones are put
+   together so that threads have about the same work) is independent and
+   primal values pass is done on them in parallel.  Solution and basis
+   are put back in model - rows in no set are basic.
+   Returns number of subproblems or 0 if not worth it (then caller should
+   just do primal values pass on whole model). */
+static int
+parallelCrossoverPush(ClpSimplex *model, ClpTaskPool *pool)
+{
+  int numberThreads = pool ? pool->numberThreads() : 0;
+  // not from inside a task (would wait on own pool)
+  if (!numberThreads || pool->whichThread() < numberThreads)
+    return 0;
+  int numberRows = model->numberRows();
+  int numberColumns = model->numberColumns();
+  const CoinPackedMatrix *matrix = model->matrix();
+  const int *row = matrix->getIndices();
+  const CoinBigIndex *columnStart = matrix->getVectorStarts();
+  const int *columnLength = matrix->getVectorLengths();
+  const double *element = matrix->getElements();
+  double *columnLower = model->columnLower();
+  double *columnUpper = model->columnUpper();
+  double *solution = model->primalColumnSolution();
+  // union of rows which share a basic or superbasic column
+  int *parent = new int[numberRows];
+  for (int iRow = 0; iRow < numberRows; iRow++)
+    parent[iRow] = iRow;
+  char *touched = new char[numberRows];
+  CoinZeroN(touched, numberRows);
+  double *fixedActivity = new double[numberRows];
+  CoinZeroN(fixedActivity, numberRows);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    ClpSimplex::Status status = model->getColumnStatus(iColumn);
+    CoinBigIndex start = columnStart[iColumn];
+    CoinBigIndex end = start + columnLength[iColumn];
+    if (status == ClpSimplex::basic || status == ClpSimplex::superBasic) {
+      if (start == end) {
+        // empty so just put to a bound
+        if (columnLower[iColumn] > -1.0e20) {
+          model->setColumnStatus(iColumn, ClpSimplex::atLowerBound);
+          solution[iColumn] = columnLower[iColumn];
+        } else if (columnUpper[iColumn] < 1.0e20) {
+          model->setColumnStatus(iColumn, ClpSimplex::atUpperBound);
+          solution[iColumn] = columnUpper[iColumn];
+        } else {
+          model->setColumnStatus(iColumn, ClpSimplex::isFree);
+          solution[iColumn] = 0.0;
+        }
+        continue;
+      }
+      int root = clpFindRoot(parent, row[start]);
+      for (CoinBigIndex j = start; j < end; j++) {
+        int iRow = row[j];
+        touched[iRow] = 1;
+        int other = clpFindRoot(parent, iRow);
+        if (other != root) {
+          parent[other] = root;
+        }
+      }
+    } else {
+      double value = solution[iColumn];
+      if (value) {
+        for (CoinBigIndex j = start; j < end; j++)
+          fixedActivity[row[j]] += value * element[j];
+      }
+    }
+  }
+  // number the sets and get work for each (elements plus rows)
+  int *whichSet = new int[numberRows];
+  int numberSets = 0;
+  for (int iRow = 0; iRow < numberRows; iRow++) {
+    if (touched[iRow] && parent[iRow] == iRow)
+      whichSet[iRow] = numberSets++;
+  }
+  double *work = new double[numberSets];
+  CoinZeroN(work, numberSets);
+  for (int iRow = 0; iRow < numberRows; iRow++) {
+    if (touched[iRow]) {
+      int iSet = whichSet[clpFindRoot(parent, iRow)];
+      whichSet[iRow] = iSet;
+      work[iSet] += 1.0;
+    } else {
+      whichSet[iRow] = -1;
+    }
+  }
+  double totalWork = 0.0;
+  double largestWork = 0.0;
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    ClpSimplex::Status status = model->getColumnStatus(iColumn);
+    if (status == ClpSimplex::basic || status == ClpSimplex::superBasic) {
+      int iSet = whichSet[row[columnStart[iColumn]]];
+      work[iSet] += columnLength[iColumn];
+    }
+  }
+  for (int iSet = 0; iSet < numberSets; iSet++) {
+    totalWork += work[iSet];
+    largestWork = CoinMax(largestWork, work[iSet]);
+  }
+  int numberProblems = CoinMin(numberSets, 4 * (numberThreads + 1));
+  if (numberProblems < 2 || largestWork > 0.75 * totalWork) {
+    delete[] parent;
+    delete[] touched;
+    delete[] fixedActivity;
+    delete[] whichSet;
+    delete[] work;
+    return 0;
+  }
+  // biggest first to least loaded subproblem
+  int *sort = new int[numberSets];
+  for (int iSet = 0; iSet < numberSets; iSet++) {
+    sort[iSet] = iSet;
+    work[iSet] = -work[iSet];
+  }
+  CoinSort_2(work, work + numberSets, sort);
+  double *problemWork = new double[numberProblems];
+  CoinZeroN(problemWork, numberProblems);
+  int *whichProblem = parent; // parent no longer needed
+  for (int i = 0; i < numberSets; i++) {
+    int best = 0;
+    for (int iProblem = 1; iProblem < numberProblems; iProblem++) {
+      if (problemWork[iProblem] < problemWork[best])
+        best = iProblem;
+    }
+    problemWork[best] -= work[i];
+    whichProblem[sort[i]] = best;
+  }
+  delete[] problemWork;
+  delete[] work;
+  delete[] sort;
+  // rows and columns of each subproblem (counting sort)
+  int *rowStart = new int[numberProblems + 1];
+  int *columnStartProblem = new int[numberProblems + 1];
+  CoinZeroN(rowStart, numberProblems + 1);
+  CoinZeroN(columnStartProblem, numberProblems + 1);
+  for (int iRow = 0; iRow < numberRows; iRow++) {
+    if (whichSet[iRow] >= 0)
+      rowStart[whichProblem[whichSet[iRow]] + 1]++;
+  }
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    ClpSimplex::Status status = model->getColumnStatus(iColumn);
+    if (status == ClpSimplex::basic || status == ClpSimplex::superBasic) {
+      int iSet = whichSet[row[columnStart[iColumn]]];
+      columnStartProblem[whichProblem[iSet] + 1]++;
+    }
+  }
+  for (int iProblem = 0; iProblem < numberProblems; iProblem++) {
+    rowStart[iProblem + 1] += rowStart[iProblem];
+    columnStartProblem[iProblem + 1] += columnStartProblem[iProblem];
+  }
+  int *whichRow = new int[rowStart[numberProblems]];
+  int *whichColumn = new int[columnStartProblem[numberProblems]];
+  int *put = new int[numberProblems];
+  CoinMemcpyN(rowStart, numberProblems, put);
+  for (int iRow = 0; iRow < numberRows; iRow++) {
+    if (whichSet[iRow] >= 0)
+      whichRow[put[whichProblem[whichSet[iRow]]]++] = iRow;
+  }
+  CoinMemcpyN(columnStartProblem, numberProblems, put);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    ClpSimplex::Status status = model->getColumnStatus(iColumn);
+    if (status == ClpSimplex::basic || status == ClpSimplex::superBasic) {
+      int iSet = whichSet[row[columnStart[iColumn]]];
+      whichColumn[put[whichProblem[iSet]]++] = iColumn;
+    }
+  }
+  delete[] put;
+  delete[] whichSet;
+  delete[] touched;
+  // make subproblems here (not thread safe) and push in threads
+  clpCrossoverPush *pushes = new clpCrossoverPush[numberProblems];
+  ClpTaskFuture *futures = new ClpTaskFuture[numberProblems];
+  CoinMessageHandler **handlers = new CoinMessageHandler *[numberProblems];
+  for (int iProblem = 0; iProblem < numberProblems; iProblem++) {
+    int numberRows2 = rowStart[iProblem + 1] - rowStart[iProblem];
+    const int *whichRow2 = whichRow + rowStart[iProblem];
+    int numberColumns2 = columnStartProblem[iProblem + 1] - columnStartProblem[iProblem];
+    const int *whichColumn2 = whichColumn + columnStartProblem[iProblem];
+    ClpSimplex *small = new ClpSimplex(model, numberRows2, whichRow2,
+      numberColumns2, whichColumn2);
+    double *rowLower = small->rowLower();
+    double *rowUpper = small->rowUpper();
+    double *rowActivity = small->primalRowSolution();
+    for (int i = 0; i < numberRows2; i++) {
+      double value = fixedActivity[whichRow2[i]];
+      if (rowLower[i] > -1.0e20)
+        rowLower[i] -= value;
+      if (rowUpper[i] < 1.0e20)
+        rowUpper[i] -= value;
+      rowActivity[i] -= value;
+    }
+    // not more basic than rows
+    int numberBasic = 0;
+    for (int i = 0; i < numberColumns2; i++) {
+      if (small->getColumnStatus(i) == ClpSimplex::basic) {
+        if (numberBasic < numberRows2)
+          numberBasic++;
+        else
+          small->setColumnStatus(i, ClpSimplex::superBasic);
+      }
+    }
+    small->setObjectiveScale(model->objectiveScale());
+    small->setPerturbation(model->perturbation());
+    // own quiet handler as messages come from several threads
+    handlers[iProblem] = new CoinMessageHandler();
+    handlers[iProblem]->setLogLevel(0);
+    small->passInMessageHandler(handlers[iProblem]);
+    pushes[iProblem].model = small;
+    pushes[iProblem].returnCode = -1;
+    pool->submit(clpCrossoverPushTask, pushes + iProblem, futures + iProblem);
+  }
+  // only wait for own subproblems - pool may be shared
+  for (int iProblem = 0; iProblem < numberProblems; iProblem++)
+    futures[iProblem].wait();
+  delete[] futures;
+  // put back - rows in no subproblem are basic
+  double *rowActivity = model->primalRowSolution();
+  double *dual = model->dualRowSolution();
+  double *dj = model->dualColumnSolution();
+  for (int iRow = 0; iRow < numberRows; iRow++) {
+    model->setRowStatus(iRow, ClpSimplex::basic);
+    rowActivity[iRow] = fixedActivity[iRow];
+    dual[iRow] = 0.0;
+  }
+  for (int iProblem = 0; iProblem < numberProblems; iProblem++) {
+    ClpSimplex *small = pushes[iProblem].model;
+    int numberRows2 = rowStart[iProblem + 1] - rowStart[iProblem];
+    const int *whichRow2 = whichRow + rowStart[iProblem];
+    int numberColumns2 = columnStartProblem[iProblem + 1] - columnStartProblem[iProblem];
+    const int *whichColumn2 = whichColumn + columnStartProblem[iProblem];
+    const double *rowActivity2 = small->primalRowSolution();
+    const double *dual2 = small->dualRowSolution();
+    for (int i = 0; i < numberRows2; i++) {
+      int iRow = whichRow2[i];
+      model->setRowStatus(iRow, small->getRowStatus(i));
+      rowActivity[iRow] += rowActivity2[i];
+      dual[iRow] = dual2[i];
+    }
+    const double *solution2 = small->primalColumnSolution();
+    const double *dj2 = small->dualColumnSolution();
+    for (int i = 0; i < numberColumns2; i++) {
+      int iColumn = whichColumn2[i];
+      model->setColumnStatus(iColumn, small->getColumnStatus(i));
+      solution[iColumn] = solution2[i];
+      dj[iColumn] = dj2[i];
+    }
+    model->setNumberIterations(model->numberIterations() + small->numberIterations());
+    delete small;
+    delete handlers[iProblem];
+  }
+  delete[] pushes;
+  delete[] handlers;
+  delete[] rowStart;
+  delete[] columnStartProblem;
+  delete[] whichRow;
+  delete[] whichColumn;
+  delete[] fixedActivity;
+  delete[] parent;
+  return numberProblems;
+}
+#endif
 /** General solve algorithm which can do presolve
     special options (bits)
     1 - do not perturb
@@ -856,13 +1147,24 @@ int ClpSimplex::initialSolve(ClpSolve &options)
   int finalStatus = -1;
   int numberIterations = 0;
   double time1 = CoinCpuTime();
+#ifndef ABC_INHERIT
+  // elapsed time for parts done in threads (cpu time adds up over threads)
+  double wallTime1 = CoinWallclockTime();
+#endif
   double timeX = time1;
   double time2 = 0.0;
   ClpMatrixBase *saveMatrix = NULL;
   ClpObjective *savedObjective = NULL;
   int idiotOptions = 0;
-  if (options.getSpecialOption(6))
+  if ((options.getSpecialOption(6) & 1) != 0)
     idiotOptions = options.getExtraInfo(6) * 32768;
+#ifdef ABC_INHERIT
+  if ((abcState() & 15) != 0) {
+    // pass on memory mode for abc factorization
+    int memoryMode = (options.getSpecialOption(6) >> 1) & 3;
+    setAbcState((abcState() & ~(3 * CLP_ABC_MEMORY_MODE)) | (memoryMode * CLP_ABC_MEMORY_MODE));
+  }
+#endif
 #ifdef CLP_USEFUL_PRINTOUT
   debugInt[0] = numberRows();
   debugInt[1] = numberColumns();
@@ -1259,21 +1561,63 @@ int ClpSimplex::initialSolve(ClpSolve &options)
   int primalStartup = 1;
   model2->eventHandler()->event(ClpEventHandler::presolveBeforeSolve);
 #if CLP_POOL_MATRIX
-  if (vectorMode() >= 10) {
+  /* vectorMode 10 and above forces a pool matrix.  If asked for
+     (special option 3 bit 2) try one for large dual solves - a pool
+     element is 4 bytes against 12 so pricing streams a third of the
+     data.  As pool matrix is not scaled only accept if element range
+     is modest.  Original is kept in saveMatrix and put back at end. */
+#ifndef CLP_POOL_AUTO_ELEMENTS
+#define CLP_POOL_AUTO_ELEMENTS 500000
+#endif
+  bool autoPool = false;
+  if (!vectorMode() && (options.getSpecialOption(3) & 2) != 0
+    && method == ClpSolve::useDual && (specialOptions_ & 1024) == 0) {
+#ifndef NO_RTTI
+    ClpPackedMatrix *clpMatrix = dynamic_cast< ClpPackedMatrix * >(model2->clpMatrix());
+#else
+    ClpPackedMatrix *clpMatrix = NULL;
+    if (model2->clpMatrix()->type() == 1)
+      clpMatrix = static_cast< ClpPackedMatrix * >(model2->clpMatrix());
+#endif
+    if (clpMatrix && !clpMatrix->wantsSpecialColumnCopy()
+      && model2->numberRows() < (1 << CLP_POOL_MATRIX)
+      && clpMatrix->getNumElements() >= CLP_POOL_AUTO_ELEMENTS
+      && !clpMatrix->matrix()->hasGaps())
+      autoPool = true;
+  }
+  if (vectorMode() >= 10 || autoPool) {
     ClpPoolMatrix *poolMatrix = new ClpPoolMatrix(*model2->matrix());
     char output[80];
     int numberDifferent = poolMatrix->getNumDifferentElements();
+    if (numberDifferent > 0 && autoPool) {
+      double smallestNegative, largestNegative, smallestPositive, largestPositive;
+      poolMatrix->rangeOfElements(smallestNegative, largestNegative,
+        smallestPositive, largestPositive);
+      double smallest = CoinMin(-smallestNegative, smallestPositive);
+      double largest = CoinMax(-largestNegative, largestPositive);
+      if (largest > 100.0 * smallest)
+        numberDifferent = 0; // would want scaling
+    }
     if (numberDifferent > 0) {
       sprintf(output, "Pool matrix has %d different values",
         numberDifferent);
-      model2->replaceMatrix(poolMatrix, true);
+      if (!autoPool) {
+        model2->replaceMatrix(poolMatrix, true);
+      } else {
+        saveMatrix = model2->clpMatrix();
+        model2->replaceMatrix(poolMatrix, false);
+      }
     } else {
       delete poolMatrix;
-      sprintf(output, "Pool matrix has more than %d different values - no good",
-        -numberDifferent);
+      if (numberDifferent < 0)
+        sprintf(output, "Pool matrix has more than %d different values - no good",
+          -numberDifferent);
+      else
+        sprintf(output, "Pool matrix not used as elements need scaling");
     }
-    handler_->message(CLP_GENERAL, messages_) << output
-                                              << CoinMessageEol;
+    if (!autoPool || numberDifferent > 0)
+      handler_->message(CLP_GENERAL, messages_) << output
+                                                << CoinMessageEol;
   }
 #endif
   int tryItSave = 0;
@@ -1497,7 +1841,7 @@ int ClpSimplex::initialSolve(ClpSolve &options)
     doCrash = 0;
     //doSprint=0;
   }
-  if (options.getSpecialOption(3) == 0) {
+  if ((options.getSpecialOption(3) & 1) == 0) {
     if (numberElements > 100000)
       plusMinus = true;
     if (numberElements > 10000 && (doIdiot || doSprint))
@@ -1508,6 +1852,10 @@ int ClpSimplex::initialSolve(ClpSolve &options)
 #ifndef SLIM_CLP
   // Statistics (+1,-1, other) - used to decide on strategy if not +-1
   CoinBigIndex statistics[3] = { -1, 0, 0 };
+  if (saveMatrix) {
+    // already swapped to pool matrix
+    plusMinus = false;
+  }
   if (plusMinus) {
     saveMatrix = model2->clpMatrix();
 #ifndef NO_RTTI
@@ -2358,6 +2706,7 @@ int ClpSimplex::initialSolve(ClpSolve &options)
             // move factorization stuff
             abcModel2->factorization()->synchronize(model2->factorization(), abcModel2);
           }
+          abcModel2->factorization()->setMemoryMode((model2->abcState() / CLP_ABC_MEMORY_MODE) & 3);
           abcModel2->startPermanentArrays();
           abcModel2->setAbcState(CLP_ABC_WANTED);
 #if ABC_PARALLEL
@@ -3162,7 +3511,28 @@ int ClpSimplex::initialSolve(ClpSolve &options)
     bool scale = false;
     bool doKKT = false;
     bool forceFixing = false;
+    bool matrixFree = false;
+    bool mixedPrecision = false;
     int speed = 0;
+    if (barrierOptions & 8192) {
+      barrierOptions &= ~8192;
+      matrixFree = true;
+    }
+    if (barrierOptions & 16384) {
+      barrierOptions &= ~16384;
+      // presolved model has no useful duals so only warm start without
+      if (presolve == ClpSolve::presolveOff) {
+        barrier.setWarmStart(1);
+      } else {
+        handler_->message(CLP_GENERAL2, messages_)
+          << "Barrier warm start ignored as presolve on"
+          << CoinMessageEol;
+      }
+    }
+    if (barrierOptions & 32768) {
+      barrierOptions &= ~32768;
+      mixedPrecision = true;
+    }
     if (barrierOptions & 16) {
       barrierOptions &= ~16;
       doKKT = true;
@@ -3195,11 +3565,29 @@ int ClpSimplex::initialSolve(ClpSolve &options)
     if (quadraticObj) {
       doKKT = true;
     }
+    if (matrixFree && !doKKT) {
+      // conjugate gradients on normal equations (factorizes if struggling)
+      ClpCholeskyPCG *cholesky = new ClpCholeskyPCG();
+      barrier.setCholesky(cholesky);
+      barrierOptions = -1;
+    } else if (mixedPrecision && !doKKT) {
+      // single precision factor with refinement (double if struggling)
+      ClpCholeskyMixed *cholesky = new ClpCholeskyMixed();
+      barrier.setCholesky(cholesky);
+      barrierOptions = -1;
+    }
     switch (barrierOptions) {
+    case -1:
+      // already set
+      break;
     case 0:
     default:
       if (!doKKT) {
-        ClpCholeskyBase *cholesky = new ClpCholeskyBase(options.getExtraInfo(1));
+        // dense columns chosen automatically unless threshold given
+        int denseThreshold = options.getExtraInfo(1);
+        if (denseThreshold < 0)
+          denseThreshold = -2;
+        ClpCholeskyBase *cholesky = new ClpCholeskyBase(denseThreshold);
         cholesky->setIntegerParameter(0, speed);
         barrier.setCholesky(cholesky);
       } else {
@@ -3560,6 +3948,11 @@ int ClpSimplex::initialSolve(ClpSolve &options)
           // User did not touch preset
           model2->defaultFactorizationFrequency();
         }
+#ifndef ABC_INHERIT
+        // for timing breakdown of crossover
+        double timeCross = CoinCpuTime();
+        double timeStep;
+#endif
 #if 1 //ndef ABC_INHERIT
   // throw some into basis
         if (!forceFixing) {
@@ -3628,11 +4021,29 @@ int ClpSimplex::initialSolve(ClpSolve &options)
           }
         }
 #else
-            // just primal values pass
+            // just primal values pass (on independent sets in parallel if can)
             double saveScale = model2->objectiveScale();
             model2->setObjectiveScale(1.0e-3);
-            model2->primal(2);
+            double wallCross = CoinWallclockTime();
+            int numberPushed = parallelCrossoverPush(model2,
+              ClpTaskPool::sharedIfExists());
+            if (numberPushed) {
+              char line[100];
+              sprintf(line, "Crossover pushed %d independent subproblems in parallel",
+                numberPushed);
+              handler_->message(CLP_GENERAL2, messages_)
+                << line
+                << CoinMessageEol;
+            } else {
+              model2->primal(2);
+            }
             model2->setObjectiveScale(saveScale);
+            timeStep = CoinCpuTime();
+            double wallStep = CoinWallclockTime();
+            handler_->message(CLP_INTERVAL_TIMING, messages_)
+              << "Crossover push (elapsed)" << wallStep - wallCross << wallStep - wallTime1
+              << CoinMessageEol;
+            timeCross = timeStep;
             // save primal solution and copy back dual
             CoinMemcpyN(model2->primalRowSolution(),
               numberRows, rowPrimal);
@@ -3687,8 +4098,14 @@ int ClpSimplex::initialSolve(ClpSolve &options)
               // just dual values pass
               //model2->setLogLevel(63);
               //model2->setFactorizationFrequency(1);
-              if (!gap)
+              if (!gap) {
                 model2->dual(2);
+                timeStep = CoinCpuTime();
+                handler_->message(CLP_INTERVAL_TIMING, messages_)
+                  << "Crossover dual" << timeStep - timeCross << timeStep - time1
+                  << CoinMessageEol;
+                timeCross = timeStep;
+              }
               CoinMemcpyN(saveCost, numberColumns, cost);
               delete[] saveCost;
               CoinMemcpyN(saveLower, numberColumns, lower);
@@ -3709,6 +4126,10 @@ int ClpSimplex::initialSolve(ClpSolve &options)
         model2->primal(2);
         model2->setObjectiveScale(saveScale);
         model2->primal(1);
+        timeStep = CoinCpuTime();
+        handler_->message(CLP_INTERVAL_TIMING, messages_)
+          << "Crossover cleanup" << timeStep - timeCross << timeStep - time1
+          << CoinMessageEol;
 #endif
 #else
         // just primal
@@ -5177,71 +5598,17 @@ ClpSimplex::scaleObjective(double value)
   }
   return largest;
 }
-#if defined(ABC_INHERIT) || defined(THREADS_IN_ANALYZE)
-void *clp_parallelManager(void *stuff)
+#ifdef ABC_INHERIT
+// Solves a block (in a thread)
+static int clpDualBlock(void *stuff)
 {
-  CoinPthreadStuff *driver = reinterpret_cast< CoinPthreadStuff * >(stuff);
-  int whichThread = driver->whichThread();
-  CoinThreadInfo *threadInfo = driver->threadInfoPointer(whichThread);
-  threadInfo->status = -1;
-  int *which = threadInfo->stuff;
-#ifdef PTHREAD_BARRIER_SERIAL_THREAD
-  pthread_barrier_wait(driver->barrierPointer());
-#endif
-#if 0
-  int status=-1;
-  while (status!=100)
-    status=timedWait(driver,1000,2);
-  pthread_cond_signal(driver->conditionPointer(1));
-  pthread_mutex_unlock(driver->mutexPointer(1,whichThread));
-#endif
-  // so now mutex_ is locked
-  int whichLocked = 0;
-  while (true) {
-    pthread_mutex_t *mutexPointer = driver->mutexPointer(whichLocked, whichThread);
-    // wait
-    //printf("Child waiting for %d - status %d %d %d\n",
-    //	   whichLocked,lockedX[0],lockedX[1],lockedX[2]);
-#ifdef DETAIL_THREAD
-    printf("thread %d about to lock mutex %d\n", whichThread, whichLocked);
-#endif
-    pthread_mutex_lock(mutexPointer);
-    whichLocked++;
-    if (whichLocked == 3)
-      whichLocked = 0;
-    int unLock = whichLocked + 1;
-    if (unLock == 3)
-      unLock = 0;
-    //printf("child pointer %x status %d\n",threadInfo,threadInfo->status);
-    assert(threadInfo->status >= 0);
-    if (threadInfo->status == 1000)
-      pthread_exit(NULL);
-    int type = threadInfo->status;
-    int &returnCode = which[0];
-    int iPass = which[1];
-    ClpSimplex *clpSimplex = reinterpret_cast< ClpSimplex * >(threadInfo->extraInfo);
-    //CoinIndexedVector * array;
-    //double dummy;
-    switch (type) {
-      // dummy
-    case 0:
-      break;
-    case 1:
-      if (!clpSimplex->problemStatus() || !iPass)
-        returnCode = clpSimplex->dual();
-      else
-        returnCode = clpSimplex->primal();
-      break;
-    case 100:
-      // initialization
-      break;
-    }
-    threadInfo->status = -1;
-#ifdef DETAIL_THREAD
-    printf("thread %d about to unlock mutex %d\n", whichThread, unLock);
-#endif
-    pthread_mutex_unlock(driver->mutexPointer(unLock, whichThread));
-  }
+  ClpSimplex *model = reinterpret_cast< ClpSimplex * >(stuff);
+  return model->dual();
+}
+static int clpPrimalBlock(void *stuff)
+{
+  ClpSimplex *model = reinterpret_cast< ClpSimplex * >(stuff);
+  return model->primal();
 }
 #endif
 // Solve using Dantzig-Wolfe decomposition and maybe in parallel
@@ -5522,7 +5889,6 @@ int ClpSimplex::solveDW(CoinStructuredModel *model, ClpSolve &options)
   //if (!this->abcState())
   //setAbcState(1);
   int numberCpu = CoinMin((this->abcState() & 15), 4);
-  CoinPthreadStuff threadInfo(numberCpu, clp_parallelManager);
   master.setAbcState(this->abcState());
   //AbcSimplex * tempMaster=master.dealWithAbc(2,10,true);
   //abcMaster=*tempMaster;
@@ -5742,20 +6108,11 @@ int ClpSimplex::solveDW(CoinStructuredModel *model, ClpSolve &options)
       }
 #if defined(ABC_INHERIT)
     } else {
-      int iBlock = 0;
-      while (iBlock < numberBlocks) {
-        if (sub[iBlock].secondaryStatus() != 99 || true) {
-          int iThread;
-          threadInfo.waitParallelTask(1, iThread, true);
-#ifdef DETAIL_THREAD
-          printf("Starting block %d on thread %d\n",
-            iBlock, iThread);
-#endif
-          threadInfo.startParallelTask(1, iThread, sub + iBlock);
-        }
-        iBlock++;
-      }
-      threadInfo.waitAllTasks();
+      // only start threads when blocks are to be done in parallel
+      ClpTaskPool *threadPool = ClpTaskPool::shared(numberCpu);
+      for (int iBlock = 0; iBlock < numberBlocks; iBlock++)
+        threadPool->submit(iPass ? clpPrimalBlock : clpDualBlock, sub + iBlock);
+      threadPool->waitAllTasks();
     }
 #endif
     for (iBlock = 0; iBlock < numberBlocks; iBlock++) {
@@ -6500,7 +6857,6 @@ int ClpSimplex::solveBenders(CoinStructuredModel *model, ClpSolve &options)
   //if (!this->abcState())
   //setAbcState(1);
   int numberCpu = CoinMin((this->abcState() & 15), 4);
-  CoinPthreadStuff threadInfo(numberCpu, clp_parallelManager);
   masterModel.setAbcState(this->abcState());
   //AbcSimplex * tempMaster=masterModel.dealWithAbc(2,10,true);
   //abcMaster=*tempMaster;
@@ -7048,20 +7404,12 @@ int ClpSimplex::solveBenders(CoinStructuredModel *model, ClpSolve &options)
       }
 #ifdef ABC_INHERIT
     } else {
-      int iBlock = 0;
-      while (iBlock < numberBlocks) {
-        if (sub[iBlock].secondaryStatus() != 99) {
-          int iThread;
-          threadInfo.waitParallelTask(1, iThread, true);
-#ifdef DETAIL_THREAD
-          printf("Starting block %d on thread %d\n",
-            iBlock, iThread);
-#endif
-          threadInfo.startParallelTask(1, iThread, sub + iBlock);
-        }
-        iBlock++;
+      ClpTaskPool *threadPool = ClpTaskPool::shared(numberCpu);
+      for (int iBlock = 0; iBlock < numberBlocks; iBlock++) {
+        if (sub[iBlock].secondaryStatus() != 99)
+          threadPool->submit(clpDualBlock, sub + iBlock);
       }
-      threadInfo.waitAllTasks();
+      threadPool->waitAllTasks();
     }
 #endif
     for (iBlock = 0; iBlock < numberBlocks; iBlock++) {
@@ -85,7 +85,9 @@ public:
        	   10 - slp before
        	   11 - no nothing and primal(0)
          2 - interrupt handling - 0 yes, 1 no (for threadsafe)
-         3 - whether to make +- 1matrix - 0 yes, 1 no
+         3 - matrix form - bits
+                      1 - do not make +- 1 matrix
+                      2 - try pool matrix for large dual (if CLP_POOL_MATRIX)
          4 - for barrier
                       0 - dense cholesky
        	   1 - Wssmp allowing some long columns
@@ -95,10 +97,16 @@ public:
        	   8 - bit set to do scaling
        	   16 - set to be aggressive with gamma/delta?
                       32 - Use KKT
+                      8192 - matrix free (conjugate gradients)
+                      16384 - warm start from current solution
+                              (only if presolve off - else cold start)
+                      32768 - single precision Cholesky with refinement
          5 - for presolve
                       1 - switch off dual stuff
          6 - extra switches
-                      
+                      1 - idiot options from extra info
+                      2 - abc factorization areas sized from last time
+                      4 - abc factorization areas advised huge pages
      */
   void setSpecialOption(int which, int value, int extraInfo = -1);
   int getSpecialOption(int which) const;
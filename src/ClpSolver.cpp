@@ -208,6 +208,7 @@ int ClpMain1(std::deque<std::string> inputQueue, AbcSimplex &model,
   int printMode = 0;
   int presolveOptions = 0;
   int doCrash = 0;
+  int abcMemory = 0;
   int doVector = 0;
   int doSprint = -1;
   // set reasonable defaults
@@ -743,6 +744,9 @@ int ClpMain1(std::deque<std::string> inputQueue, AbcSimplex &model,
           omp_set_num_threads(mode);
 #endif
           break;
+        case ClpParam::ABCMEMORY:
+          abcMemory = mode;
+          break;
         case ClpParam::INTPRINT:
           printMode = mode;
           break;
@@ -1072,6 +1076,10 @@ int ClpMain1(std::deque<std::string> inputQueue, AbcSimplex &model,
           } else if (method == ClpSolve::useBarrier ||
                      method == ClpSolve::useBarrierNoCross) {
             int barrierOptions = choleskyType;
+            if (choleskyType == 8)
+              barrierOptions = 8192; // pcg
+            else if (choleskyType == 9)
+              barrierOptions = 32768; // mixed precision
             if (scaleBarrier) {
               if ((scaleBarrier & 1) != 0)
                 barrierOptions |= 8;
@@ -1085,6 +1093,9 @@ int ClpMain1(std::deque<std::string> inputQueue, AbcSimplex &model,
               barrierOptions |= 256; // try presolve in crossover
             solveOptions.setSpecialOption(4, barrierOptions);
           }
+          if (abcMemory)
+            solveOptions.setSpecialOption(6, solveOptions.getSpecialOption(6) | (2 * abcMemory),
+                                          solveOptions.getExtraInfo(6));
           int status;
           if (cppValue >= 0) {
             // generate code
@@ -0,0 +1,396 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <cassert>
+#include <cstdio>
+
+#include "CoinPragma.hpp"
+#include "CoinIndexedVector.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "ClpTaskPool.hpp"
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+//#############################################################################
+// ClpTaskFuture
+//#############################################################################
+
+ClpTaskFuture::ClpTaskFuture()
+  : pool_(NULL)
+  , next_(NULL)
+  , function_(NULL)
+  , rangeFunction_(NULL)
+  , info_(NULL)
+  , first_(0)
+  , last_(0)
+  , result_(0)
+  , status_(0)
+  , owned_(false)
+{
+}
+ClpTaskFuture::~ClpTaskFuture()
+{
+  // finished is final so no need for lock then
+  if (status_ == 1 && pool_)
+    pool_->waitFor(this);
+}
+// Wait for task and return its status
+int ClpTaskFuture::wait()
+{
+  // always go through lock so result is safe to read
+  if (pool_)
+    return pool_->waitFor(this);
+  else
+    return result_;
+}
+// True if finished (or never started)
+bool ClpTaskFuture::finished() const
+{
+  return status_ != 1;
+}
+
+//#############################################################################
+// ClpTaskPool
+//#############################################################################
+
+#ifdef CLP_USE_PTHREADS
+typedef struct {
+  ClpTaskPool *pool;
+  int iThread;
+} ClpTaskPoolStart;
+static void *clpTaskPoolThread(void *stuff)
+{
+  ClpTaskPoolStart *start = reinterpret_cast< ClpTaskPoolStart * >(stuff);
+  ClpTaskPool *pool = start->pool;
+  int iThread = start->iThread;
+  delete start;
+  pool->workerLoop(iThread);
+  return NULL;
+}
+#endif
+ClpTaskPool::ClpTaskPool(int numberThreads)
+  : head_(NULL)
+  , tail_(NULL)
+  , scratch_(NULL)
+  , scratchCapacity_(0)
+  , numberOutstanding_(0)
+  , numberThreads_(0)
+  , affinityFirst_(0)
+  , affinityStride_(0)
+  , stop_(false)
+{
+#ifdef CLP_USE_PTHREADS
+  pthread_mutex_init(&mutex_, NULL);
+  pthread_cond_init(&workWanted_, NULL);
+  pthread_cond_init(&workDone_, NULL);
+#endif
+  addThreads(numberThreads);
+}
+// Starts more threads (pool must be idle)
+void ClpTaskPool::addThreads(int numberThreads)
+{
+  int oldNumber = numberThreads_;
+#ifdef CLP_USE_PTHREADS
+  numberThreads = CoinMax(0, CoinMin(numberThreads, CLP_MAX_POOL_THREADS));
+  assert(!numberOutstanding_);
+  for (int iThread = oldNumber; iThread < numberThreads; iThread++) {
+    ClpTaskPoolStart *start = new ClpTaskPoolStart;
+    start->pool = this;
+    start->iThread = iThread;
+    if (pthread_create(thread_ + iThread, NULL, clpTaskPoolThread, start)) {
+      // could not create - make do with what we have
+      delete start;
+      break;
+    }
+    // only count once thread_ set so whichThread is safe
+    numberThreads_ = iThread + 1;
+    if (affinityStride_)
+      pinThread(iThread);
+  }
+  if (scratch_ && numberThreads_ == oldNumber)
+    return;
+#endif
+  // scratch vectors are reserved again lazily by the thread using them
+  delete[] scratch_;
+  scratch_ = new CoinIndexedVector[2 * (numberThreads_ + 1)];
+}
+ClpTaskPool::~ClpTaskPool()
+{
+  waitAllTasks();
+#ifdef CLP_USE_PTHREADS
+  pthread_mutex_lock(&mutex_);
+  stop_ = true;
+  pthread_cond_broadcast(&workWanted_);
+  pthread_mutex_unlock(&mutex_);
+  for (int iThread = 0; iThread < numberThreads_; iThread++)
+    pthread_join(thread_[iThread], NULL);
+  pthread_cond_destroy(&workDone_);
+  pthread_cond_destroy(&workWanted_);
+  pthread_mutex_destroy(&mutex_);
+#endif
+  delete[] scratch_;
+}
+// Runs task (in worker or caller)
+void ClpTaskPool::runTask(ClpTaskFuture *task, int iThread)
+{
+  if (task->rangeFunction_) {
+    task->rangeFunction_(task->info_, task->first_, task->last_, iThread);
+    task->result_ = 0;
+  } else {
+    task->result_ = task->function_(task->info_);
+  }
+}
+// Does work in thread
+void ClpTaskPool::workerLoop(int iThread)
+{
+#ifdef CLP_USE_PTHREADS
+  pthread_mutex_lock(&mutex_);
+  while (true) {
+    // sleep until something to do
+    while (!head_ && !stop_)
+      pthread_cond_wait(&workWanted_, &mutex_);
+    if (!head_)
+      break;
+    ClpTaskFuture *task = head_;
+    head_ = task->next_;
+    if (!head_)
+      tail_ = NULL;
+    pthread_mutex_unlock(&mutex_);
+    runTask(task, iThread);
+    // owner may free task as soon as status set
+    bool owned = task->owned_;
+    pthread_mutex_lock(&mutex_);
+    task->status_ = 2;
+    numberOutstanding_--;
+    if (owned)
+      delete task;
+    pthread_cond_broadcast(&workDone_);
+  }
+  pthread_mutex_unlock(&mutex_);
+#endif
+}
+// Puts task on queue
+void ClpTaskPool::queueTask(ClpTaskFuture *task)
+{
+  task->pool_ = this;
+  task->next_ = NULL;
+  task->status_ = 1;
+#ifdef CLP_USE_PTHREADS
+  if (numberThreads_) {
+    pthread_mutex_lock(&mutex_);
+    numberOutstanding_++;
+    if (tail_)
+      tail_->next_ = task;
+    else
+      head_ = task;
+    tail_ = task;
+    pthread_cond_signal(&workWanted_);
+    pthread_mutex_unlock(&mutex_);
+    return;
+  }
+#endif
+  // no threads - just do it
+  runTask(task, numberThreads_);
+  task->status_ = 2;
+  if (task->owned_)
+    delete task;
+}
+// Submit a task
+void ClpTaskPool::submit(ClpTaskFunction function, void *info,
+  ClpTaskFuture *future)
+{
+  ClpTaskFuture *task = future;
+  if (!task) {
+    task = new ClpTaskFuture();
+    task->owned_ = true;
+  } else {
+    assert(task->status_ != 1);
+    task->owned_ = false;
+  }
+  task->function_ = function;
+  task->rangeFunction_ = NULL;
+  task->info_ = info;
+  queueTask(task);
+}
+// Do function over [first,last) in chunks of at least grain
+void ClpTaskPool::parallelFor(int first, int last, int grain,
+  ClpRangeFunction function, void *info)
+{
+  int n = last - first;
+  if (n <= 0)
+    return;
+  int iThread = whichThread();
+  grain = CoinMax(grain, 1);
+  int numberChunks = CoinMin(numberThreads_ + 1, (n - 1) / grain + 1);
+  if (numberChunks <= 1 || iThread < numberThreads_) {
+    // small or nested inside a task (which could deadlock)
+    function(info, first, last, iThread);
+    return;
+  }
+  ClpTaskFuture futures[CLP_MAX_POOL_THREADS];
+  int size = n / numberChunks;
+  int extra = n - size * numberChunks;
+  int start = first;
+  for (int i = 0; i < numberChunks; i++) {
+    int end = start + size + ((i < extra) ? 1 : 0);
+    if (i < numberChunks - 1) {
+      ClpTaskFuture *task = futures + i;
+      task->function_ = NULL;
+      task->rangeFunction_ = function;
+      task->info_ = info;
+      task->first_ = start;
+      task->last_ = end;
+      queueTask(task);
+    } else {
+      // do last chunk ourselves
+      assert(end == last);
+      function(info, start, end, numberThreads_);
+    }
+    start = end;
+  }
+  for (int i = 0; i < numberChunks - 1; i++)
+    futures[i].wait();
+}
+// Called from ClpTaskFuture
+int ClpTaskPool::waitFor(ClpTaskFuture *future)
+{
+#ifdef CLP_USE_PTHREADS
+  pthread_mutex_lock(&mutex_);
+  while (future->status_ == 1)
+    pthread_cond_wait(&workDone_, &mutex_);
+  int result = future->result_;
+  pthread_mutex_unlock(&mutex_);
+  return result;
+#else
+  return future->result_;
+#endif
+}
+// Wait for all submitted tasks
+void ClpTaskPool::waitAllTasks()
+{
+#ifdef CLP_USE_PTHREADS
+  if (!numberThreads_)
+    return;
+  pthread_mutex_lock(&mutex_);
+  while (numberOutstanding_)
+    pthread_cond_wait(&workDone_, &mutex_);
+  pthread_mutex_unlock(&mutex_);
+#endif
+}
+// Which thread this is
+int ClpTaskPool::whichThread() const
+{
+#ifdef CLP_USE_PTHREADS
+  pthread_t thisThread = pthread_self();
+  for (int iThread = 0; iThread < numberThreads_; iThread++) {
+    if (pthread_equal(thisThread, thread_[iThread]))
+      return iThread;
+  }
+#endif
+  return numberThreads_;
+}
+// Scratch vector for thread
+CoinIndexedVector *ClpTaskPool::scratch(int iThread, int which)
+{
+  assert(iThread >= 0 && iThread <= numberThreads_ && which >= 0 && which < 2);
+  CoinIndexedVector *vector = scratch_ + 2 * iThread + which;
+  // reserve in thread which uses it so pages are local
+  if (vector->capacity() < scratchCapacity_)
+    vector->reserve(scratchCapacity_);
+  return vector;
+}
+// Make sure scratch vectors have at least this capacity
+void ClpTaskPool::reserveScratch(int capacity)
+{
+  scratchCapacity_ = CoinMax(scratchCapacity_, capacity);
+}
+// Pins thread as given by setAffinity
+bool ClpTaskPool::pinThread(int iThread)
+{
+#if defined(CLP_USE_PTHREADS) && defined(__linux__) && defined(CPU_SET)
+  int numberCpus = static_cast< int >(sysconf(_SC_NPROCESSORS_ONLN));
+  if (numberCpus <= 0)
+    return false;
+  int iCpu = (affinityFirst_ + iThread * affinityStride_) % numberCpus;
+  if (iCpu < 0)
+    iCpu += numberCpus;
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(iCpu, &cpuSet);
+  return !pthread_setaffinity_np(thread_[iThread], sizeof(cpu_set_t), &cpuSet);
+#else
+  return false;
+#endif
+}
+// Pin threads to cpus
+int ClpTaskPool::setAffinity(int firstCpu, int stride)
+{
+  affinityFirst_ = firstCpu;
+  affinityStride_ = stride;
+  int numberPinned = 0;
+  if (stride) {
+    for (int iThread = 0; iThread < numberThreads_; iThread++) {
+      if (pinThread(iThread))
+        numberPinned++;
+    }
+  }
+  return numberPinned;
+}
+static ClpTaskPool *clpSharedPool = NULL;
+#ifdef CLP_USE_PTHREADS
+// Protects creation, growth and deletion of shared pool
+static pthread_mutex_t clpSharedMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+// Shared pool
+ClpTaskPool *ClpTaskPool::shared(int numberThreads)
+{
+#ifndef CLP_USE_PTHREADS
+  if (!clpSharedPool)
+    clpSharedPool = new ClpTaskPool(0);
+  return clpSharedPool;
+#else
+  numberThreads = CoinMax(0, CoinMin(numberThreads, CLP_MAX_POOL_THREADS));
+  pthread_mutex_lock(&clpSharedMutex);
+  if (!clpSharedPool) {
+    clpSharedPool = new ClpTaskPool(numberThreads);
+  } else if (numberThreads > clpSharedPool->numberThreads_) {
+    // grow in place (existing threads kept) but only if idle
+    pthread_mutex_lock(&clpSharedPool->mutex_);
+    if (!clpSharedPool->numberOutstanding_)
+      clpSharedPool->addThreads(numberThreads);
+    pthread_mutex_unlock(&clpSharedPool->mutex_);
+  }
+  ClpTaskPool *pool = clpSharedPool;
+  pthread_mutex_unlock(&clpSharedMutex);
+  return pool;
+#endif
+}
+// Shared pool if it exists
+ClpTaskPool *ClpTaskPool::sharedIfExists()
+{
+#ifdef CLP_USE_PTHREADS
+  pthread_mutex_lock(&clpSharedMutex);
+  ClpTaskPool *pool = clpSharedPool;
+  pthread_mutex_unlock(&clpSharedMutex);
+  return pool;
+#else
+  return clpSharedPool;
+#endif
+}
+// Delete shared pool
+void ClpTaskPool::deleteShared()
+{
+#ifdef CLP_USE_PTHREADS
+  pthread_mutex_lock(&clpSharedMutex);
+#endif
+  delete clpSharedPool;
+  clpSharedPool = NULL;
+#ifdef CLP_USE_PTHREADS
+  pthread_mutex_unlock(&clpSharedMutex);
+#endif
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
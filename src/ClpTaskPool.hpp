@@ -0,0 +1,211 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef ClpTaskPool_H
+#define ClpTaskPool_H
+
+#include <cstddef>
+
+#include "CoinPragma.hpp"
+#include "ClpConfig.h"
+class CoinIndexedVector;
+
+#if defined(ABC_INHERIT) || defined(THREADS_IN_ANALYZE) || defined(CLP_THREAD_POOL)
+// Use pthreads
+#ifndef CLP_USE_PTHREADS
+#define CLP_USE_PTHREADS
+#endif
+#include <pthread.h>
+#endif
+#ifndef CLP_MAX_POOL_THREADS
+#define CLP_MAX_POOL_THREADS 64
+#endif
+class ClpTaskPool;
+/// Task - returns a status which can be got from ClpTaskFuture
+typedef int (*ClpTaskFunction)(void *info);
+/** Range task for parallelFor - does [first,last).
+    iThread is 0 to numberThreads (numberThreads is calling thread)
+    so can be used to pick up scratch arrays */
+typedef void (*ClpRangeFunction)(void *info, int first, int last, int iThread);
+
+/** Handle for a submitted task.
+
+    The caller owns it and it must stay in scope until the task has
+    finished (wait() or ClpTaskPool::waitAllTasks()).
+*/
+class CLPLIB_EXPORT ClpTaskFuture {
+  friend class ClpTaskPool;
+
+public:
+  /// Default constructor
+  ClpTaskFuture();
+  /// Destructor - waits for task if still running
+  ~ClpTaskFuture();
+  /// Wait for task and return its status
+  int wait();
+  /// True if finished (or never started)
+  bool finished() const;
+  /// Return code of task (valid once finished)
+  inline int result() const
+  {
+    return result_;
+  }
+
+private:
+  /// Not allowed
+  ClpTaskFuture(const ClpTaskFuture &);
+  ClpTaskFuture &operator=(const ClpTaskFuture &);
+  /// Pool doing task
+  ClpTaskPool *pool_;
+  /// Next in queue
+  ClpTaskFuture *next_;
+  /// Function (if normal task)
+  ClpTaskFunction function_;
+  /// Function (if range task)
+  ClpRangeFunction rangeFunction_;
+  /// Information for function
+  void *info_;
+  /// First in range
+  int first_;
+  /// Last in range
+  int last_;
+  /// Return code
+  int result_;
+  /// 0 not started, 1 queued or running, 2 finished
+  volatile int status_;
+  /// True if pool should delete when finished
+  bool owned_;
+};
+
+/** Persistent pool of worker threads.
+
+    Threads are created once and sleep on a condition variable when
+    there is nothing to do, so there is no cost in keeping a pool
+    around between solves.  Work is given either as single tasks
+    (submit, with an optional ClpTaskFuture to wait on) or as a range
+    split into chunks (parallelFor).  Each thread (and the calling
+    thread) has its own scratch CoinIndexedVectors.
+
+    If Clp is built without threads (CLP_THREAD_POOL, ABC_INHERIT or
+    THREADS_IN_ANALYZE not defined) everything is done in the calling
+    thread, so code can use the pool unconditionally.
+
+    shared() gives a pool which lives until deleteShared() so that
+    matrix, Cholesky and solve code need not create threads each time.
+*/
+class CLPLIB_EXPORT ClpTaskPool {
+
+public:
+  /**@name Constructors and destructor */
+  //@{
+  /** Constructor - numberThreads worker threads (caller also does work
+      in parallelFor so numberThreads+1 can be busy) */
+  ClpTaskPool(int numberThreads = 0);
+  /// Destructor - waits for all tasks then stops threads
+  ~ClpTaskPool();
+  //@}
+
+  /**@name Work */
+  //@{
+  /** Submit a task.  If future given then it can be waited on,
+      otherwise use waitAllTasks */
+  void submit(ClpTaskFunction function, void *info,
+    ClpTaskFuture *future = NULL);
+  /** Do function over [first,last) in chunks of at least grain.
+      Caller does a chunk and returns when all done. */
+  void parallelFor(int first, int last, int grain,
+    ClpRangeFunction function, void *info);
+  /// Wait for all submitted tasks
+  void waitAllTasks();
+  //@}
+
+  /**@name Information and control */
+  //@{
+  /// Number of worker threads (0 if all done in calling thread)
+  inline int numberThreads() const
+  {
+    return numberThreads_;
+  }
+  /// Which thread this is (numberThreads() if not a worker)
+  int whichThread() const;
+  /** Scratch vector for thread (0 to numberThreads()) - which is 0 or 1.
+      Capacity is at least that given in reserveScratch */
+  CoinIndexedVector *scratch(int iThread, int which = 0);
+  /// Make sure scratch vectors have at least this capacity
+  void reserveScratch(int capacity);
+  /** Pin thread i to cpu firstCpu+i*stride (modulo number of cpus).
+      So on a two socket machine with cpus numbered by socket a stride
+      of half the cpus alternates sockets.  Remembered so threads
+      added later are pinned as well; stride 0 stops pinning new threads.
+      Returns number of threads pinned (0 if not supported on platform) */
+  int setAffinity(int firstCpu = 0, int stride = 1);
+  //@}
+
+  /**@name Shared pool */
+  //@{
+  /** Shared pool.  Created on first call with numberThreads
+      (or grown in place if more threads asked for and idle).
+      Safe to call from several threads at once.  Growing should not
+      be asked for while another thread is in parallelFor on the pool
+      (its chunk is not counted as outstanding work). */
+  static ClpTaskPool *shared(int numberThreads = 0);
+  /// Shared pool if it exists (or NULL)
+  static ClpTaskPool *sharedIfExists();
+  /// Delete shared pool (no other thread may be using it)
+  static void deleteShared();
+  //@}
+
+  /// Does work in thread (not for users)
+  void workerLoop(int iThread);
+  /// Called from ClpTaskFuture
+  int waitFor(ClpTaskFuture *future);
+
+private:
+  /// Not allowed
+  ClpTaskPool(const ClpTaskPool &);
+  ClpTaskPool &operator=(const ClpTaskPool &);
+  /// Runs task (in worker or caller)
+  void runTask(ClpTaskFuture *task, int iThread);
+  /// Puts task on queue
+  void queueTask(ClpTaskFuture *task);
+  /// Starts threads up to numberThreads in total (pool must be idle)
+  void addThreads(int numberThreads);
+  /// Pins thread as given by setAffinity - returns true if done
+  bool pinThread(int iThread);
+  /**@name Data */
+  //@{
+#ifdef CLP_USE_PTHREADS
+  /// Protects everything below
+  pthread_mutex_t mutex_;
+  /// Signalled when work is added (or stopping)
+  pthread_cond_t workWanted_;
+  /// Signalled when a task finishes
+  pthread_cond_t workDone_;
+  /// Threads
+  pthread_t thread_[CLP_MAX_POOL_THREADS];
+#endif
+  /// First in queue
+  ClpTaskFuture *head_;
+  /// Last in queue
+  ClpTaskFuture *tail_;
+  /// Scratch vectors (two per thread plus two for caller)
+  CoinIndexedVector *scratch_;
+  /// Capacity wanted for scratch vectors
+  int scratchCapacity_;
+  /// Number of tasks not finished
+  int numberOutstanding_;
+  /// Number of threads
+  int numberThreads_;
+  /// First cpu for setAffinity
+  int affinityFirst_;
+  /// Stride for setAffinity (0 if threads not pinned)
+  int affinityStride_;
+  /// True if threads should stop
+  bool stop_;
+  //@}
+};
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,178 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <cassert>
+
+#include "CoinPragma.hpp"
+#include "CoinIndexedVector.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "ClpSimplex.hpp"
+#include "ClpWorkArena.hpp"
+#include "ClpNonLinearCost.hpp"
+
+//#############################################################################
+// Constructors / Destructor
+//#############################################################################
+
+ClpWorkArena::ClpWorkArena()
+  : pivots_(NULL)
+  , pivotsLength_(0)
+  , pivotsOut_(NULL)
+  , pivotsOutLength_(0)
+  , nonLinearCost_(NULL)
+  , active_(true)
+{
+  for (int i = 0; i < numberWorkArrays; i++) {
+    array_[i] = NULL;
+    arrayLength_[i] = 0;
+    arrayOut_[i] = NULL;
+    arrayOutLength_[i] = 0;
+  }
+  for (int i = 0; i < numberVectors; i++)
+    vector_[i] = NULL;
+}
+ClpWorkArena::~ClpWorkArena()
+{
+  clear();
+}
+// Array of length (kept one if same length or new)
+double *
+ClpWorkArena::takeArray(int which, int length)
+{
+  assert(which >= 0 && which < numberWorkArrays);
+  double *array = array_[which];
+  if (!array || arrayLength_[which] != length) {
+    delete[] array;
+    array = new double[length];
+  }
+  array_[which] = NULL;
+  arrayLength_[which] = 0;
+  arrayOut_[which] = array;
+  arrayOutLength_[which] = length;
+  return array;
+}
+// Give back array
+void ClpWorkArena::giveArray(int which, double *array, int length)
+{
+  assert(which >= 0 && which < numberWorkArrays);
+  if (!array)
+    return;
+  if (active_ && array == arrayOut_[which] && length == arrayOutLength_[which]) {
+    delete[] array_[which];
+    array_[which] = array;
+    arrayLength_[which] = length;
+  } else {
+    // replaced since (or size changed)
+    delete[] array;
+  }
+  arrayOut_[which] = NULL;
+  arrayOutLength_[which] = 0;
+}
+// Pivot array of length (kept one if same length or new)
+int *ClpWorkArena::takePivots(int length)
+{
+  int *array = pivots_;
+  if (!array || pivotsLength_ != length) {
+    delete[] array;
+    array = new int[length];
+  }
+  pivots_ = NULL;
+  pivotsLength_ = 0;
+  pivotsOut_ = array;
+  pivotsOutLength_ = length;
+  return array;
+}
+// Give back pivot array
+void ClpWorkArena::givePivots(int *array, int length)
+{
+  if (!array)
+    return;
+  if (active_ && array == pivotsOut_ && length == pivotsOutLength_) {
+    delete[] pivots_;
+    pivots_ = array;
+    pivotsLength_ = length;
+  } else {
+    delete[] array;
+  }
+  pivotsOut_ = NULL;
+  pivotsOutLength_ = 0;
+}
+// Vector (kept one cleaned or new)
+CoinIndexedVector *
+ClpWorkArena::takeVector(int which)
+{
+  assert(which >= 0 && which < numberVectors);
+  CoinIndexedVector *vector = vector_[which];
+  vector_[which] = NULL;
+  if (vector) {
+    // may have been left with values not in index
+    CoinZeroN(vector->denseVector(), vector->capacity());
+    vector->setNumElements(0);
+    vector->setPackedMode(false);
+  } else {
+    vector = new CoinIndexedVector();
+  }
+  return vector;
+}
+// Give back vector
+void ClpWorkArena::giveVector(int which, CoinIndexedVector *vector)
+{
+  assert(which >= 0 && which < numberVectors);
+  if (!active_) {
+    delete vector;
+  } else if (vector) {
+    delete vector_[which];
+    vector_[which] = vector;
+  }
+}
+// Nonlinear cost set up for model
+ClpNonLinearCost *
+ClpWorkArena::takeNonLinearCost(ClpSimplex *model)
+{
+  ClpNonLinearCost *cost = nonLinearCost_;
+  nonLinearCost_ = NULL;
+  if (cost && !cost->reuse(model)) {
+    delete cost;
+    cost = NULL;
+  }
+  return cost;
+}
+// Give back nonlinear cost
+void ClpWorkArena::giveNonLinearCost(ClpNonLinearCost *cost)
+{
+  if (!active_) {
+    delete cost;
+  } else if (cost) {
+    delete nonLinearCost_;
+    nonLinearCost_ = cost;
+  }
+}
+// Switch on or off
+void ClpWorkArena::setActive(bool yesNo)
+{
+  active_ = yesNo;
+  if (!active_)
+    clear();
+}
+// Free everything kept
+void ClpWorkArena::clear()
+{
+  for (int i = 0; i < numberWorkArrays; i++) {
+    delete[] array_[i];
+    array_[i] = NULL;
+    arrayLength_[i] = 0;
+  }
+  delete[] pivots_;
+  pivots_ = NULL;
+  pivotsLength_ = 0;
+  for (int i = 0; i < numberVectors; i++) {
+    delete vector_[i];
+    vector_[i] = NULL;
+  }
+  delete nonLinearCost_;
+  nonLinearCost_ = NULL;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,119 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef ClpWorkArena_H
+#define ClpWorkArena_H
+
+#include <cstddef>
+
+#include "CoinPragma.hpp"
+#include "ClpConfig.h"
+class CoinIndexedVector;
+class ClpNonLinearCost;
+class ClpSimplex;
+
+/** Work storage kept by ClpSimplex between solves.
+
+    When a solve finishes the work regions (cost, bounds, djs, solution),
+    pivot list, CoinIndexedVectors and ClpNonLinearCost are handed here
+    instead of being freed, and the next createRim takes them back.  So
+    repeated solves of a problem of the same size do no allocation.
+
+    Arrays are only kept if they are the ones handed out and the
+    problem size is unchanged - otherwise they are just freed.
+    Vectors are kept whatever their size as users reserve them.
+*/
+class CLPLIB_EXPORT ClpWorkArena {
+
+public:
+  /// Which double array
+  enum workArray {
+    costArray = 0,
+    lowerArray,
+    upperArray,
+    djArray,
+    solutionArray,
+    numberWorkArrays
+  };
+  /// Number of vectors (rowArray_ then columnArray_)
+  enum {
+    numberVectors = 12
+  };
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor
+  ClpWorkArena();
+  /// Destructor
+  ~ClpWorkArena();
+  //@}
+
+  /**@name Taking and giving back */
+  //@{
+  /// Array of length (kept one if same length or new)
+  double *takeArray(int which, int length);
+  /** Give back array - kept if handed out by takeArray with this length
+         (so still right size) otherwise deleted */
+  void giveArray(int which, double *array, int length);
+  /// Pivot array of length (kept one if same length or new)
+  int *takePivots(int length);
+  /// Give back pivot array (as giveArray)
+  void givePivots(int *array, int length);
+  /// Vector (kept one cleaned or new)
+  CoinIndexedVector *takeVector(int which);
+  /// Give back vector
+  void giveVector(int which, CoinIndexedVector *vector);
+  /** Nonlinear cost set up for model as if just constructed.
+         NULL if none kept or kept one can not be used for model */
+  ClpNonLinearCost *takeNonLinearCost(ClpSimplex *model);
+  /// Give back nonlinear cost
+  void giveNonLinearCost(ClpNonLinearCost *cost);
+  /// Free everything kept
+  void clear();
+  //@}
+
+  /**@name Control */
+  //@{
+  /// If false everything given back is freed
+  inline bool active() const
+  {
+    return active_;
+  }
+  /// Switch on or off (off frees what is kept)
+  void setActive(bool yesNo);
+  //@}
+
+private:
+  /// Not allowed
+  ClpWorkArena(const ClpWorkArena &);
+  ClpWorkArena &operator=(const ClpWorkArena &);
+  /**@name Data */
+  //@{
+  /// Kept arrays
+  double *array_[numberWorkArrays];
+  /// Lengths of kept arrays
+  int arrayLength_[numberWorkArrays];
+  /// Arrays handed out (so can be recognized when given back)
+  double *arrayOut_[numberWorkArrays];
+  /// Lengths of arrays handed out
+  int arrayOutLength_[numberWorkArrays];
+  /// Kept pivot array
+  int *pivots_;
+  /// Length of kept pivot array
+  int pivotsLength_;
+  /// Pivot array handed out
+  int *pivotsOut_;
+  /// Length of pivot array handed out
+  int pivotsOutLength_;
+  /// Kept vectors
+  CoinIndexedVector *vector_[numberVectors];
+  /// Kept nonlinear cost
+  ClpNonLinearCost *nonLinearCost_;
+  /// False if nothing to be kept
+  bool active_;
+  //@}
+};
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
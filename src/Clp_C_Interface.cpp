@@ -12,6 +12,7 @@
 #include "CoinHelperFunctions.hpp"
 #include "ClpSimplex.hpp"
 #include "ClpInterior.hpp"
+#include "ClpTaskPool.hpp"
 #ifndef SLIM_CLP
 #include "Idiot.hpp"
 #endif
@@ -270,6 +271,18 @@ Clp_loadProblem(Clp_Simplex *model, const int numcols, const int numrows,
   model->model_->loadProblem(numcols, numrows, start, index, value,
     collb, colub, obj, rowlb, rowub);
 }
+/* As Clp_loadProblem but matrix arrays are not copied */
+void CLP_LINKAGE
+Clp_loadProblemBorrowed(Clp_Simplex *model, const int numcols, const int numrows,
+  const CoinBigIndex *start, const int *index,
+  const double *value,
+  const double *collb, const double *colub,
+  const double *obj,
+  const double *rowlb, const double *rowub)
+{
+  model->model_->loadProblem(numcols, numrows, start, index, value,
+    collb, colub, obj, rowlb, rowub, NULL, true);
+}
 
 /* read quadratic part of the objective (the matrix part) */
 void CLP_LINKAGE
@@ -1385,6 +1398,154 @@ ClpSolveSetIntProperty(setInfeasibleReturn)
                                                 ClpSolveGetIntProperty(substitution)
                                                   ClpSolveSetIntProperty(setSubstitution)
 
+typedef struct {
+  const ClpSimplex *base; // NULL for Clp_solveBatch
+  ClpSimplex **work;
+  Clp_BatchProblem *problems;
+  ClpTaskPool *pool;
+  int algorithm;
+} ClpBatchInfo;
+typedef struct {
+  ClpBatchInfo *batch;
+  int which;
+} ClpBatchItem;
+// Copies array (or default if NULL)
+static void batchCopy(double *to, const double *from, int n,
+  const double *defaultArray, double defaultValue)
+{
+  if (from)
+    CoinMemcpyN(from, n, to);
+  else if (defaultArray)
+    CoinMemcpyN(defaultArray, n, to);
+  else
+    CoinFillN(to, n, defaultValue);
+}
+// Solves one problem of a batch (in a thread)
+static int batchSolve(void *stuff)
+{
+  ClpBatchItem *item = reinterpret_cast< ClpBatchItem * >(stuff);
+  ClpBatchInfo *batch = item->batch;
+  Clp_BatchProblem &problem = batch->problems[item->which];
+  ClpSimplex *model = batch->work[batch->pool ? batch->pool->whichThread() : 0];
+  const ClpSimplex *base = batch->base;
+  if (!base) {
+    model->loadProblem(problem.numberColumns, problem.numberRows,
+      problem.start, problem.index, problem.value,
+      problem.collb, problem.colub, problem.obj,
+      problem.rowlb, problem.rowub, NULL, true);
+  } else {
+    // back to optimal basis of base and put in this variant
+    int numberRows = base->numberRows();
+    int numberColumns = base->numberColumns();
+    CoinMemcpyN(base->statusArray(), numberRows + numberColumns, model->statusArray());
+    CoinMemcpyN(base->primalColumnSolution(), numberColumns, model->primalColumnSolution());
+    CoinMemcpyN(base->primalRowSolution(), numberRows, model->primalRowSolution());
+    CoinMemcpyN(base->dualColumnSolution(), numberColumns, model->dualColumnSolution());
+    CoinMemcpyN(base->dualRowSolution(), numberRows, model->dualRowSolution());
+    batchCopy(model->columnLower(), problem.collb, numberColumns, base->columnLower(), 0.0);
+    batchCopy(model->columnUpper(), problem.colub, numberColumns, base->columnUpper(), 0.0);
+    batchCopy(model->objective(), problem.obj, numberColumns, base->objective(), 0.0);
+    batchCopy(model->rowLower(), problem.rowlb, numberRows, base->rowLower(), 0.0);
+    batchCopy(model->rowUpper(), problem.rowub, numberRows, base->rowUpper(), 0.0);
+  }
+  switch (batch->algorithm) {
+  case 1:
+    model->primal();
+    break;
+  case 2:
+    model->initialSolve();
+    break;
+  default:
+    model->dual();
+    break;
+  }
+  int numberRows = model->numberRows();
+  int numberColumns = model->numberColumns();
+  if (problem.primalColumnSolution)
+    CoinMemcpyN(model->primalColumnSolution(), numberColumns, problem.primalColumnSolution);
+  if (problem.dualColumnSolution)
+    CoinMemcpyN(model->dualColumnSolution(), numberColumns, problem.dualColumnSolution);
+  if (problem.primalRowSolution)
+    CoinMemcpyN(model->primalRowSolution(), numberRows, problem.primalRowSolution);
+  if (problem.dualRowSolution)
+    CoinMemcpyN(model->dualRowSolution(), numberRows, problem.dualRowSolution);
+  problem.objectiveValue = model->objectiveValue();
+  problem.status = model->status();
+  problem.numberIterations = model->numberIterations();
+  return problem.status;
+}
+// Solves batch (base NULL) or variants of base
+static int batchSolveAll(const ClpSimplex *base, int numberProblems,
+  Clp_BatchProblem *problems, int numberThreads, int algorithm)
+{
+  if (numberProblems <= 0)
+    return 0;
+  // no threads wanted - do not use shared pool as it may have some
+  ClpTaskPool *pool = (numberThreads > 0) ? ClpTaskPool::shared(numberThreads) : NULL;
+  // in calling thread if that is a worker (waiting there could deadlock)
+  if (pool && pool->whichThread() < pool->numberThreads())
+    pool = NULL;
+  int numberModels = pool ? pool->numberThreads() + 1 : 1;
+  ClpBatchInfo batch;
+  batch.base = base;
+  batch.work = new ClpSimplex *[numberModels];
+  batch.problems = problems;
+  batch.pool = pool;
+  batch.algorithm = algorithm;
+  for (int i = 0; i < numberModels; i++) {
+    ClpSimplex *model = base ? new ClpSimplex(*base) : new ClpSimplex();
+    // own handler as several threads - and quiet
+    model->setDefaultMessageHandler();
+    model->setLogLevel(0);
+    batch.work[i] = model;
+  }
+  ClpBatchItem *items = new ClpBatchItem[numberProblems];
+  // wait on own tasks (pool may be doing other work)
+  ClpTaskFuture *futures = pool ? new ClpTaskFuture[numberProblems] : NULL;
+  for (int i = 0; i < numberProblems; i++) {
+    items[i].batch = &batch;
+    items[i].which = i;
+    problems[i].status = -1;
+    if (pool)
+      pool->submit(batchSolve, items + i, futures + i);
+    else
+      batchSolve(items + i);
+  }
+  if (pool) {
+    for (int i = 0; i < numberProblems; i++)
+      futures[i].wait();
+    delete[] futures;
+  }
+  int numberBad = 0;
+  for (int i = 0; i < numberProblems; i++) {
+    if (problems[i].status)
+      numberBad++;
+  }
+  delete[] items;
+  for (int i = 0; i < numberModels; i++)
+    delete batch.work[i];
+  delete[] batch.work;
+  return numberBad;
+}
+/* Solves independent problems */
+int CLP_LINKAGE
+Clp_solveBatch(int numberProblems, Clp_BatchProblem *problems,
+  int numberThreads, int algorithm)
+{
+  return batchSolveAll(NULL, numberProblems, problems, numberThreads, algorithm);
+}
+/* Solves variants of model which only differ in bounds and objective */
+int CLP_LINKAGE
+Clp_solveVariants(Clp_Simplex *model, int numberVariants,
+  Clp_BatchProblem *variants, int numberThreads, int algorithm)
+{
+  ClpSimplex *base = model->model_;
+  if (base->status() || !base->statusExists())
+    base->dual();
+  if (base->status())
+    return -1;
+  return batchSolveAll(base, numberVariants, variants, numberThreads, algorithm);
+}
 /** give pointer to ClpSimplex object (C++ class) */
 void* CLP_LINKAGE Clp_getClpSimplex(Clp_Simplex *model)
 {
@@ -104,6 +104,17 @@ CLPLIB_EXPORT void CLP_LINKAGE Clp_loadProblem(Clp_Simplex *model, const int num
   const double *collb, const double *colub,
   const double *obj,
   const double *rowlb, const double *rowub);
+/** As Clp_loadProblem but start, index and value are not copied.
+     They must stay valid and unchanged until the problem is replaced or
+     the model deleted (Clp makes its own copy if it needs to change the
+     matrix).  Bounds and objective are copied. */
+CLPLIB_EXPORT void CLP_LINKAGE Clp_loadProblemBorrowed(Clp_Simplex *model,
+  const int numcols, const int numrows,
+  const CoinBigIndex *start, const int *index,
+  const double *value,
+  const double *collb, const double *colub,
+  const double *obj,
+  const double *rowlb, const double *rowub);
 
 /* read quadratic part of the objective (the matrix part) */
 CLPLIB_EXPORT void CLP_LINKAGE
@@ -548,6 +559,57 @@ CLPLIB_EXPORT int CLP_LINKAGE ClpSolve_substitution(Clp_Solve *);
 CLPLIB_EXPORT void CLP_LINKAGE ClpSolve_setSubstitution(Clp_Solve *, int value);
 /*@}*/
 
+/**@name Batch solve
+        For many small independent problems.  Problems are solved on an
+        internal thread pool (ClpTaskPool) with one ClpSimplex per thread
+        which is reused from problem to problem.  Solutions go into
+        buffers given by the caller (any of which may be NULL).
+     */
+/*@{*/
+/** One problem (or variant) for Clp_solveBatch or Clp_solveVariants.
+    Input is as Clp_loadProblem - NULL bounds or objective take the
+    defaults for Clp_solveBatch and the model values for Clp_solveVariants
+    (where matrix fields are ignored). */
+typedef struct {
+  /* input */
+  int numberColumns;
+  int numberRows;
+  const CoinBigIndex *start;
+  const int *index;
+  const double *value;
+  const double *collb;
+  const double *colub;
+  const double *obj;
+  const double *rowlb;
+  const double *rowub;
+  /* output (caller buffers - may be NULL) */
+  double *primalColumnSolution;
+  double *dualColumnSolution;
+  double *primalRowSolution;
+  double *dualRowSolution;
+  double objectiveValue;
+  /** status as Clp_status (-1 if not solved) */
+  int status;
+  int numberIterations;
+} Clp_BatchProblem;
+/** Solves independent problems.
+    algorithm 0 - dual, 1 - primal, 2 - as Clp_initialSolve.
+    numberThreads 0 solves in calling thread, otherwise the shared
+    ClpTaskPool is used (which may already have more threads).
+    Returns number of problems not proven optimal */
+CLPLIB_EXPORT int CLP_LINKAGE Clp_solveBatch(int numberProblems,
+  Clp_BatchProblem *problems, int numberThreads, int algorithm);
+/** Solves variants of model which only differ in bounds and objective.
+    Model is solved first if needed and each variant starts from its
+    optimal basis (dual is normally best for bound changes and primal
+    for objective changes).  Model is not changed.
+    Returns number of variants not proven optimal (or -1 if model
+    could not be solved) */
+CLPLIB_EXPORT int CLP_LINKAGE Clp_solveVariants(Clp_Simplex *model,
+  int numberVariants, Clp_BatchProblem *variants,
+  int numberThreads, int algorithm);
+/*@}*/
+
 /**@name Functions for expert users */
 /*@{*/
 /** gives pointer to ClpSimplex object (C++ class), return should be cast to ClpSimplex* */
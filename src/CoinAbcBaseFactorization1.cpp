@@ -565,6 +565,15 @@ void CoinAbcTypeFactorization::gutsOfCopy(const CoinAbcTypeFactorization &other)
   doAddresses();
 }
 
+// Gets area and if wanted asks for huge pages when (re)allocated
+template < class T >
+static void abcAreaNew(T &area, CoinBigIndex size, bool hugePages)
+{
+  const void *old = area.array();
+  area.conditionalNew(size);
+  if (hugePages && area.array() != old)
+    CoinAbcAdviseHugePages(area.array(), area.getSize() * sizeof(*area.array()));
+}
 //  getAreas.  Gets space for a factorization
 //called by constructors
 void CoinAbcTypeFactorization::getAreas(CoinSimplexInt numberOfRows,
@@ -572,6 +581,14 @@ void CoinAbcTypeFactorization::getAreas(CoinSimplexInt numberOfRows,
   CoinBigIndex maximumL,
   CoinBigIndex maximumU)
 {
+  // what last factorization and its updates used (if same size)
+  CoinBigIndex usedU = 0;
+  CoinBigIndex usedL = 0;
+  if ((memoryMode_ & 1) != 0 && numberOfRows == numberRows_) {
+    usedU = CoinMax(lastEntryByColumnU_, lengthU_);
+    usedL = lengthL_ + lengthR_;
+  }
+  bool hugePages = (memoryMode_ & 2) != 0;
   gutsOfInitialize(2);
 
   numberRows_ = numberOfRows;
@@ -590,16 +607,28 @@ void CoinAbcTypeFactorization::getAreas(CoinSimplexInt numberOfRows,
     lengthAreaU_ = static_cast< CoinBigIndex >(areaFactor_ * lengthAreaU_);
     lengthAreaL_ = static_cast< CoinBigIndex >(areaFactor_ * lengthAreaL_);
   }
+  if ((memoryMode_ & 1) != 0) {
+    // allow a quarter more than used last time
+    lengthAreaU_ = CoinMax(lengthAreaU_, usedU + (usedU >> 2));
+    lengthAreaL_ = CoinMax(lengthAreaL_, usedL + (usedL >> 2));
+    // and if have to get more then get at least half as much again
+    CoinBigIndex size = CoinMin(elementU_.getSize(), indexRowU_.getSize() - 1);
+    if (size > 0 && lengthAreaU_ > size)
+      lengthAreaU_ = CoinMax(lengthAreaU_, size + (size >> 1));
+    size = CoinMin(elementL_.getSize(), indexRowL_.getSize());
+    if (size > 0 && lengthAreaL_ > size)
+      lengthAreaL_ = CoinMax(lengthAreaL_, size + (size >> 1));
+  }
 #ifdef ABC_USE_FUNCTION_POINTERS
   lengthAreaUPlus_ = (lengthAreaU_ * 3) / 2 + maximumRowsExtra_;
-  elementU_.conditionalNew(lengthAreaUPlus_);
+  abcAreaNew(elementU_, lengthAreaUPlus_, hugePages);
 #else
-  elementU_.conditionalNew(lengthAreaU_);
+  abcAreaNew(elementU_, lengthAreaU_, hugePages);
 #endif
-  indexRowU_.conditionalNew(lengthAreaU_ + 1);
-  indexColumnU_.conditionalNew(lengthAreaU_ + 1);
-  elementL_.conditionalNew(lengthAreaL_);
-  indexRowL_.conditionalNew(lengthAreaL_);
+  abcAreaNew(indexRowU_, lengthAreaU_ + 1, hugePages);
+  abcAreaNew(indexColumnU_, lengthAreaU_ + 1, hugePages);
+  abcAreaNew(elementL_, lengthAreaL_, hugePages);
+  abcAreaNew(indexRowL_, lengthAreaL_, hugePages);
   // But we can use all we have if bigger
   CoinBigIndex length;
   length = CoinMin(elementU_.getSize(), indexRowU_.getSize());
@@ -634,11 +663,11 @@ void CoinAbcTypeFactorization::getAreas(CoinSimplexInt numberOfRows,
   numberInColumnPlus_.conditionalNew(maximumRowsExtra_ + 1);
 #ifdef ABC_USE_FUNCTION_POINTERS
   scatterUColumn_.conditionalNew(sizeof(scatterStruct), maximumRowsExtra_ + 1);
-  elementRowU_.conditionalNew(lengthAreaUPlus_);
+  abcAreaNew(elementRowU_, lengthAreaUPlus_, hugePages);
   elementRowUAddress_ = elementRowU_.array();
   firstZeroed_ = 0;
 #elif ABC_SMALL < 2
-  elementRowU_.conditionalNew(lengthAreaU_);
+  abcAreaNew(elementRowU_, lengthAreaU_, hugePages);
   elementRowUAddress_ = elementRowU_.array();
 #endif
 #if COIN_BIG_DOUBLE == 1
@@ -655,10 +684,10 @@ void CoinAbcTypeFactorization::getAreas(CoinSimplexInt numberOfRows,
   firstCount_.conditionalNew(CoinMax(5 * numberRows_, 4 * numberRows_ + 2 * maximumPivots_ + 4) + 2);
 #if CONVERTROW
   //space for cross reference
-  convertRowToColumnU_.conditionalNew(lengthAreaU_);
+  abcAreaNew(convertRowToColumnU_, lengthAreaU_, hugePages);
   convertRowToColumnUAddress_ = convertRowToColumnU_.array();
 #if CONVERTROW > 1
-  convertColumnToRowU_.conditionalNew(lengthAreaU_);
+  abcAreaNew(convertColumnToRowU_, lengthAreaU_, hugePages);
   convertColumnToRowUAddress_ = convertColumnToRowU_.array();
 #endif
 #endif
@@ -704,6 +704,7 @@ CoinAbcAnyFactorization::CoinAbcAnyFactorization()
   , numberPivots_(0)
   , status_(-1)
   , solveMode_(0)
+  , memoryMode_(0)
 {
 }
 // Copy constructor
@@ -719,6 +720,7 @@ CoinAbcAnyFactorization::CoinAbcAnyFactorization(const CoinAbcAnyFactorization &
   , numberPivots_(other.numberPivots_)
   , status_(other.status_)
   , solveMode_(other.solveMode_)
+  , memoryMode_(other.memoryMode_)
 {
 }
 // Destructor
@@ -740,6 +742,7 @@ CoinAbcAnyFactorization &CoinAbcAnyFactorization::operator=(const CoinAbcAnyFact
     numberPivots_ = other.numberPivots_;
     status_ = other.status_;
     solveMode_ = other.solveMode_;
+    memoryMode_ = other.memoryMode_;
   }
   return *this;
 }
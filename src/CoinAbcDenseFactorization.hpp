@@ -184,6 +184,20 @@ public:
   {
     solveMode_ = value;
   }
+  /** Get memory mode (default 0 - sized as before)
+      If 1 set then areas sized from what last factorization used
+      (and grown by half when too small) so fewer reallocations
+      If 2 set then large areas advised to use huge pages (Linux)
+  */
+  inline int memoryMode() const
+  {
+    return memoryMode_;
+  }
+  /// Set memory mode (see memoryMode)
+  inline void setMemoryMode(int value)
+  {
+    memoryMode_ = value;
+  }
   /// Returns true if wants tableauColumn in replaceColumn
   virtual bool wantsTableauColumn() const;
   /** Useful information for factorization
@@ -429,6 +443,11 @@ protected:
       if 8 set then has iterated
   */
   int solveMode_;
+  /** Memory mode
+      1 size areas from last factorization
+      2 ask for huge pages for large areas
+  */
+  int memoryMode_;
   //@}
 };
 /** This deals with Factorization and Updates
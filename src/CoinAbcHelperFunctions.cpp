@@ -10,6 +10,9 @@
 #include "CoinTypes.h"
 #include "CoinFinite.hpp"
 #include "CoinAbcCommon.hpp"
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
 //#define AVX2 1
 #if AVX2 == 1
 #define set_const_v2df(bb, b)                         \
@@ -707,6 +710,20 @@ int CoinAbcCompact(int numberSections, int alreadyDone, int *array, const int *s
   }
   return alreadyDone;
 }
+// Asks for transparent huge pages for aligned part of array
+size_t CoinAbcAdviseHugePages(void *array, size_t size)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  const size_t hugePage = 2 * 1024 * 1024;
+  size_t start = reinterpret_cast< size_t >(array);
+  size_t end = start + size;
+  start = (start + hugePage - 1) & ~(hugePage - 1);
+  end &= ~(hugePage - 1);
+  if (end > start && !madvise(reinterpret_cast< void * >(start), end - start, MADV_HUGEPAGE))
+    return end - start;
+#endif
+  return 0;
+}
 void CoinAbcScatterUpdate0(int number, CoinFactorizationDouble /*pivotValue*/,
   const CoinFactorizationDouble *COIN_RESTRICT /*thisElement*/,
   const int *COIN_RESTRICT /*thisIndex*/,
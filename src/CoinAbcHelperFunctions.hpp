@@ -802,6 +802,9 @@ void CoinAbcMemmoveAndZero(double *array, double *arrayFrom, int size);
 int CoinAbcCompact(int numberSections, int alreadyDone, double *array, const int *starts, const int *lengths);
 /// This compacts several sections (returns number)
 int CoinAbcCompact(int numberSections, int alreadyDone, int *array, const int *starts, const int *lengths);
+/** Asks for transparent huge pages for the part of array (size bytes)
+    on huge page boundaries.  Returns bytes advised (0 if not Linux) */
+size_t CoinAbcAdviseHugePages(void *array, size_t size);
 #endif
 #if ABC_CREATE_SCATTER_FUNCTION
 SCATTER_ATTRIBUTE void functionName(ScatterUpdate1)(int numberIn, CoinFactorizationDouble multiplier,
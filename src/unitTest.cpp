@@ -11,6 +11,7 @@
 #include <cassert>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <cmath>
 #include <cfloat>
 #include <string>
@@ -26,16 +27,22 @@
 
 #if CLP_HAS_ABC
 #include "CoinAbcCommon.hpp"
+#include "CoinAbcCommonFactorization.hpp"
 #endif
 #ifdef ABC_INHERIT
 #include "CoinAbcFactorization.hpp"
 #endif
 #include "ClpFactorization.hpp"
+#include "ClpBlockBasis.hpp"
 #include "ClpSimplex.hpp"
 #include "ClpSimplexOther.hpp"
 #include "ClpSimplexNonlinear.hpp"
 #include "ClpInterior.hpp"
+#include "ClpPdcoBase.hpp"
+#include "ClpCholeskyPCG.hpp"
+#include "ClpCholeskyMixed.hpp"
 #include "ClpLinearObjective.hpp"
+#include "ClpQuadraticObjective.hpp"
 #include "ClpDualRowSteepest.hpp"
 #include "ClpDualRowDantzig.hpp"
 #include "ClpPrimalColumnSteepest.hpp"
@@ -43,6 +50,9 @@
 #include "ClpModelParameters.hpp"
 #include "ClpNetworkMatrix.hpp"
 #include "ClpPlusMinusOneMatrix.hpp"
+#include "ClpCompressedMatrix.hpp"
+#include "ClpTaskPool.hpp"
+#include "Clp_C_Interface.h"
 #include "MyMessageHandler.hpp"
 #include "MyEventHandler.hpp"
 
@@ -217,6 +227,206 @@ ClpSolve setupForSolve(int algorithm, std::string &nameAlgorithm,
   }
   return solveOptions;
 }
+// Picks up number of subproblems from crossover push message
+class ClpPushMessageHandler : public CoinMessageHandler {
+
+public:
+  ClpPushMessageHandler()
+    : CoinMessageHandler()
+    , numberPushed_(0)
+  {
+  }
+  virtual int print()
+  {
+    const char *found = strstr(messageBuffer(), "Crossover pushed ");
+    if (found)
+      numberPushed_ = atoi(found + strlen("Crossover pushed "));
+    return 0;
+  }
+  virtual CoinMessageHandler *clone() const
+  {
+    return new ClpPushMessageHandler(*this);
+  }
+  /// Number of subproblems pushed in parallel (0 if not)
+  int numberPushed_;
+};
+/* Entropy objective sum x log x for pdco with the constraint matrix
+   loaded into model - products are ClpPdcoBase ones with that matrix */
+class ClpEntropyPdco : public ClpPdcoBase {
+public:
+  ClpEntropyPdco(double d1, double d2)
+    : ClpPdcoBase()
+  {
+    d1_ = d1;
+    d2_ = d2;
+  }
+  virtual void matVecMult(ClpInterior *model, int mode, double *x, double *y) const
+  {
+    matrixVecMult(model, mode, x, y);
+  }
+  virtual void matPrecon(ClpInterior *model, double delta, double *x, double *y) const
+  {
+    matrixPrecon(model, delta, x, y);
+  }
+  virtual double getObj(ClpInterior *model, CoinDenseVector< double > &x) const
+  {
+    const double *xElements = x.getElements();
+    double obj = 0.0;
+    for (int k = 0; k < model->numberColumns(); k++)
+      obj += xElements[k] * log(xElements[k]);
+    return obj;
+  }
+  virtual void getGrad(ClpInterior *model, CoinDenseVector< double > &x,
+    CoinDenseVector< double > &grad) const
+  {
+    const double *xElements = x.getElements();
+    double *gradElements = grad.getElements();
+    for (int k = 0; k < model->numberColumns(); k++)
+      gradElements[k] = 1.0 + log(xElements[k]);
+  }
+  virtual void getHessian(ClpInterior *model, CoinDenseVector< double > &x,
+    CoinDenseVector< double > &H) const
+  {
+    const double *xElements = x.getElements();
+    double *hElements = H.getElements();
+    for (int k = 0; k < model->numberColumns(); k++)
+      hElements[k] = 1.0 / xElements[k];
+  }
+  virtual ClpPdcoBase *clone() const
+  {
+    return new ClpEntropyPdco(*this);
+  }
+};
+/* Sets up model for pdco with entropy objective - three elements in
+   each column and right hand side from a non uniform x */
+static void loadEntropyModel(ClpInterior &model, int numberRows, int numberColumns)
+{
+  CoinBigIndex *start = new CoinBigIndex[numberColumns + 1];
+  int *row = new int[3 * numberColumns];
+  double *element = new double[3 * numberColumns];
+  double *columnLower = new double[numberColumns];
+  double *columnUpper = new double[numberColumns];
+  double *rhs = new double[numberRows];
+  CoinZeroN(rhs, numberRows);
+  start[0] = 0;
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    double value = (1.0 + 0.5 * (iColumn % 3)) / numberColumns;
+    for (int j = 0; j < 3; j++) {
+      int iRow = (iColumn + 7 * j) % numberRows;
+      row[3 * iColumn + j] = iRow;
+      element[3 * iColumn + j] = 1.0 + 0.25 * j;
+      rhs[iRow] += value * (1.0 + 0.25 * j);
+    }
+    start[iColumn + 1] = 3 * (iColumn + 1);
+    columnLower[iColumn] = 0.0;
+    columnUpper[iColumn] = 1.0e20;
+  }
+  CoinPackedMatrix matrix(true, numberRows, numberColumns, 3 * numberColumns,
+    element, row, start, NULL);
+  model.loadProblem(matrix, columnLower, columnUpper, NULL, rhs, rhs);
+  model.rhs_ = new CoinWorkDouble[numberRows];
+  model.y_ = new CoinWorkDouble[numberRows];
+  for (int iRow = 0; iRow < numberRows; iRow++) {
+    model.rhs_[iRow] = rhs[iRow];
+    model.y_[iRow] = 0.0;
+  }
+  model.x_ = new CoinWorkDouble[numberColumns];
+  model.dj_ = new CoinWorkDouble[numberColumns];
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    model.x_[iColumn] = 1.0 / numberColumns;
+    model.dj_[iColumn] = 1.0;
+  }
+  model.xsize_ = CoinMin(50.0 / numberColumns, 1.0);
+  model.zsize_ = 1.0;
+  delete[] start;
+  delete[] row;
+  delete[] element;
+  delete[] columnLower;
+  delete[] columnUpper;
+  delete[] rhs;
+}
+// Keeps last parametrics breakpoint
+class ClpLastBreakpoint : public ClpParametricsStream {
+
+public:
+  ClpLastBreakpoint()
+    : ClpParametricsStream(false)
+    , numberBreakpoints_(0)
+    , numberBasisChanges_(0)
+    , theta_(0.0)
+    , objective_(0.0)
+  {
+  }
+  virtual ClpEventHandler *clone() const
+  {
+    return new ClpLastBreakpoint(*this);
+  }
+  virtual void breakpoint(const ClpParametricsBreakpoint &info)
+  {
+    if (info.sequenceIn >= 0) {
+      // basis change - both given
+      assert(numberBreakpoints_);
+      assert(info.sequenceOut >= 0 && info.sequenceOut != info.sequenceIn);
+      numberBasisChanges_++;
+    } else {
+      assert(info.sequenceOut < 0);
+    }
+    numberBreakpoints_++;
+    theta_ = info.theta;
+    objective_ = info.objective;
+  }
+  int numberBreakpoints_;
+  int numberBasisChanges_;
+  double theta_;
+  double objective_;
+};
+// For task pool test - adds one to each in range
+static void clpPoolAddOne(void *info, int first, int last, int)
+{
+  int *count = reinterpret_cast< int * >(info);
+  for (int i = first; i < last; i++)
+    count[i]++;
+}
+// For task pool test - returns one more than value
+static int clpPoolTask(void *info)
+{
+  int *value = reinterpret_cast< int * >(info);
+  return *value + 1;
+}
+#ifdef CLP_USE_PTHREADS
+// For shared pool test - gets shared pool from several threads at once
+static void *clpGetSharedPool(void *info)
+{
+  *reinterpret_cast< ClpTaskPool ** >(info) = ClpTaskPool::shared(2);
+  return NULL;
+}
+// For batch test - keeps a worker busy until told to stop (or 10 seconds)
+static int clpPoolBusyTask(void *info)
+{
+  volatile int *stop = reinterpret_cast< volatile int * >(info);
+  double start = CoinWallclockTime();
+  while (!*stop && CoinWallclockTime() - start < 10.0) {
+  }
+  return *stop ? 0 : 1;
+}
+#endif
+/* Reads sample problem name into model - returns false (with message)
+   if it can not be read */
+static bool loadSample(const std::string &dirSample, const char *name,
+  ClpModel &model)
+{
+  CoinMpsIO m;
+  std::string fn = dirSample + name;
+  if (m.readMps(fn.c_str(), "mps") != 0) {
+    std::cerr << "Error reading " << name
+              << " from sample data. Skipping test." << std::endl;
+    return false;
+  }
+  model.loadProblem(*m.getMatrixByCol(), m.getColLower(), m.getColUpper(),
+    m.getObjCoefficients(),
+    m.getRowLower(), m.getRowUpper());
+  return true;
+}
 static void printSol(ClpSimplex &model)
 {
   int numberRows = model.numberRows();
@@ -1708,6 +1918,115 @@ void ClpSimplexUnitTest(const std::string &dirSample)
                               NULL, NULL, rhs, rhs, NULL);
 #endif
   }
+  // Test batch of parametrics directions against one at a time
+  {
+    ClpSimplex model;
+    if (loadSample(dirSample, "afiro", model)) {
+      model.dual();
+      int numberRows = model.numberRows();
+      int numberColumns = model.numberColumns();
+      const double *rowLower = model.rowLower();
+      const double *rowUpper = model.rowUpper();
+      int numberScenarios = 4;
+      double *changeLower = new double[3 * numberRows];
+      double *changeUpper = new double[3 * numberRows];
+      CoinZeroN(changeLower, 3 * numberRows);
+      CoinZeroN(changeUpper, 3 * numberRows);
+      double *changeObjective = new double[numberColumns];
+      for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+        changeObjective[iColumn] = (iColumn % 3) ? 0.0 : 1.0;
+      ClpSimplexOther::parametricsScenario scenarios[4];
+      double theta[4][50];
+      double objective[4][50];
+      for (int i = 0; i < numberScenarios; i++) {
+        ClpSimplexOther::parametricsScenario &scenario = scenarios[i];
+        memset(&scenario, 0, sizeof(scenario));
+        if (i < 3) {
+          // move one row
+          int iRow = 7 * i;
+          if (rowLower[iRow] > -1.0e30)
+            changeLower[i * numberRows + iRow] = 1.0;
+          if (rowUpper[iRow] < 1.0e30)
+            changeUpper[i * numberRows + iRow] = 1.0;
+          scenario.changeLowerRhs = changeLower + i * numberRows;
+          scenario.changeUpperRhs = changeUpper + i * numberRows;
+        } else {
+          scenario.changeObjective = changeObjective;
+        }
+        scenario.endingTheta = 10.0;
+        scenario.theta = theta[i];
+        scenario.objective = objective[i];
+        scenario.maximumBreakpoints = 50;
+      }
+      // more directions than threads so copies are made again
+      ClpSimplexOther *other = static_cast< ClpSimplexOther * >(&model);
+      int numberShort = other->parametricsBatch(0.0, numberScenarios, scenarios, 2);
+      ClpTaskPool::deleteShared();
+      assert(numberShort >= 0);
+      // model not changed
+      assert(!model.problemStatus());
+      CoinRelFltEq eq(1.0e-7);
+      assert(eq(model.objectiveValue(), -4.6475314286e+02));
+      for (int i = 0; i < numberScenarios; i++) {
+        ClpSimplexOther::parametricsScenario &scenario = scenarios[i];
+        assert(scenario.numberBreakpoints > 0);
+        // same as factorizing from scratch
+        ClpSimplex direct(model);
+        direct.scaling(0);
+        direct.dual();
+        ClpLastBreakpoint last;
+        direct.passInEventHandler(&last);
+        ClpSimplexOther *directOther = static_cast< ClpSimplexOther * >(&direct);
+        double endingTheta = 10.0;
+        int returnCode;
+        if (scenario.changeObjective)
+          returnCode = directOther->parametrics(0.0, endingTheta, 0.0,
+            NULL, NULL, NULL, NULL, scenario.changeObjective);
+        else
+          returnCode = directOther->parametrics(0.0, endingTheta, NULL, NULL,
+            scenario.changeLowerRhs, scenario.changeUpperRhs);
+        assert(returnCode == scenario.returnCode);
+        assert(fabs(endingTheta - scenario.endingTheta) < 1.0e-8);
+        const ClpLastBreakpoint *directLast = dynamic_cast< const ClpLastBreakpoint * >(direct.eventHandler());
+        assert(directLast && directLast->numberBreakpoints_);
+        int n = CoinMin(scenario.numberBreakpoints, scenario.maximumBreakpoints) - 1;
+        assert(fabs(scenario.theta[n] - directLast->theta_) < 1.0e-8);
+        assert(fabs(scenario.objective[n] - directLast->objective_) < 1.0e-6 * (1.0 + fabs(directLast->objective_)));
+      }
+      delete[] changeLower;
+      delete[] changeUpper;
+      delete[] changeObjective;
+    }
+  }
+  // Test parametrics breakpoints give entering and leaving variables
+  {
+    ClpSimplex model;
+    if (loadSample(dirSample, "afiro", model)) {
+      model.scaling(0);
+      model.dual();
+      int numberRows = model.numberRows();
+      int numberColumns = model.numberColumns();
+      // move all finite rhs so basis has to change
+      double *changeLower = new double[numberRows];
+      double *changeUpper = new double[numberRows];
+      for (int iRow = 0; iRow < numberRows; iRow++) {
+        changeLower[iRow] = (model.rowLower()[iRow] > -1.0e30) ? 1.0 : 0.0;
+        changeUpper[iRow] = (model.rowUpper()[iRow] < 1.0e30) ? 1.0 : 0.0;
+      }
+      ClpLastBreakpoint stream;
+      model.passInEventHandler(&stream);
+      double endingTheta = 100.0;
+      static_cast< ClpSimplexOther * >(&model)->parametrics(0.0, endingTheta,
+        NULL, NULL, changeLower, changeUpper);
+      const ClpLastBreakpoint *last = dynamic_cast< const ClpLastBreakpoint * >(model.eventHandler());
+      assert(last);
+      // checks on sequences are in breakpoint()
+      assert(last->numberBasisChanges_ > 0);
+      assert(last->numberBreakpoints_ > last->numberBasisChanges_);
+      delete[] changeLower;
+      delete[] changeUpper;
+    }
+  }
   // Test binv etc
   {
     /*
@@ -1979,6 +2298,741 @@ void ClpSimplexUnitTest(const std::string &dirSample)
       std::cerr << "Error reading afiro from sample data. Skipping test." << std::endl;
     }
   }
+  // test scaling is same when sweeps are split over threads
+  {
+    // big enough to be split into chunks
+    int numberRows = 10000;
+    int numberColumns = 12000;
+    CoinBigIndex *start = new CoinBigIndex[numberColumns + 1];
+    int *row = new int[3 * numberColumns];
+    double *element = new double[3 * numberColumns];
+    double *columnLower = new double[numberColumns];
+    double *columnUpper = new double[numberColumns];
+    double *rowLower = new double[numberRows];
+    double *rowUpper = new double[numberRows];
+    start[0] = 0;
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+      for (int j = 0; j < 3; j++) {
+        row[3 * iColumn + j] = (iColumn + 1013 * j) % numberRows;
+        element[3 * iColumn + j] = (1.0 + (iColumn % 7)) * pow(10.0, (iColumn + j) % 5 - 2);
+      }
+      start[iColumn + 1] = 3 * (iColumn + 1);
+      columnLower[iColumn] = 0.0;
+      // some fixed and some with small gaps
+      columnUpper[iColumn] = (iColumn % 11) ? 10.0 : ((iColumn % 2) ? 0.0 : 1.0e-7);
+    }
+    for (int iRow = 0; iRow < numberRows; iRow++) {
+      rowLower[iRow] = -1.0;
+      rowUpper[iRow] = 1.0;
+    }
+    CoinPackedMatrix matrix(true, numberRows, numberColumns, 3 * numberColumns,
+      element, row, start, NULL);
+    ClpSimplex model[2];
+    for (int iPass = 0; iPass < 2; iPass++) {
+      if (iPass)
+        ClpTaskPool::shared(2);
+      model[iPass].loadProblem(matrix, columnLower, columnUpper, NULL,
+        rowLower, rowUpper);
+      model[iPass].scaling(1);
+      model[iPass].clpMatrix()->scale(model + iPass);
+      assert(model[iPass].rowScale());
+    }
+    ClpTaskPool::deleteShared();
+    // scales and smallest element do not depend on how sweeps were split
+    for (int iRow = 0; iRow < numberRows; iRow++)
+      assert(model[0].rowScale()[iRow] == model[1].rowScale()[iRow]);
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+      assert(model[0].columnScale()[iColumn] == model[1].columnScale()[iColumn]);
+    delete[] start;
+    delete[] row;
+    delete[] element;
+    delete[] columnLower;
+    delete[] columnUpper;
+    delete[] rowLower;
+    delete[] rowUpper;
+  }
+#if CLP_POOL_MATRIX
+  // test pool matrix kernels against packed matrix
+  {
+    ClpSimplex solution;
+    if (loadSample(dirSample, "afiro", solution)) {
+      ClpPackedMatrix packed(*solution.matrix());
+      ClpPoolMatrix pool(*solution.matrix());
+      assert(pool.getNumDifferentElements() > 0);
+      int numberRows = solution.numberRows();
+      int numberColumns = solution.numberColumns();
+      double *x = new double[numberColumns];
+      double *y = new double[numberRows];
+      double *columnScale = new double[numberColumns];
+      double *rowScale = new double[numberRows];
+      for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+        x[iColumn] = 1.0 + 0.1 * (iColumn % 5);
+        columnScale[iColumn] = 0.5 + 0.25 * (iColumn % 3);
+      }
+      for (int iRow = 0; iRow < numberRows; iRow++) {
+        y[iRow] = (iRow % 7) - 3.0;
+        rowScale[iRow] = 2.0 - 0.5 * (iRow % 3);
+      }
+      for (int iScale = 0; iScale < 2; iScale++) {
+        const double *useRow = iScale ? rowScale : NULL;
+        const double *useColumn = iScale ? columnScale : NULL;
+        double *result = new double[2 * (numberRows + numberColumns)];
+        double *result2 = result + numberRows + numberColumns;
+        CoinZeroN(result, 2 * (numberRows + numberColumns));
+        pool.times(1.5, x, result, useRow, useColumn);
+        packed.times(1.5, x, result2, useRow, useColumn);
+        for (int iRow = 0; iRow < numberRows; iRow++)
+          assert(fabs(result[iRow] - result2[iRow]) < 1.0e-10 * (1.0 + fabs(result2[iRow])));
+        CoinZeroN(result, 2 * (numberRows + numberColumns));
+        pool.transposeTimes(-1.0, y, result, useRow, useColumn);
+        packed.transposeTimes(-1.0, y, result2, useRow, useColumn);
+        for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+          assert(fabs(result[iColumn] - result2[iColumn]) < 1.0e-10 * (1.0 + fabs(result2[iColumn])));
+        delete[] result;
+      }
+      delete[] x;
+      delete[] y;
+      delete[] columnScale;
+      delete[] rowScale;
+      // and in simplex (dual, then primal with steepest edge updates)
+      solution.replaceMatrix(new ClpPoolMatrix(pool), true);
+      solution.scaling(0);
+      solution.dual();
+      assert(solution.status() == 0);
+      CoinRelFltEq eq(1.0e-8);
+      assert(eq(solution.objectiveValue(), -4.6475314286e+02));
+      solution.allSlackBasis(true);
+      ClpPrimalColumnSteepest steepest(1);
+      solution.setPrimalColumnPivotAlgorithm(steepest);
+      solution.primal();
+      assert(solution.status() == 0);
+      assert(eq(solution.objectiveValue(), -4.6475314286e+02));
+    }
+  }
+#endif
+  // test compressed matrix
+  {
+    CoinMpsIO m;
+    std::string fn = dirSample + "afiro";
+    if (m.readMps(fn.c_str(), "mps") == 0) {
+      // pass 0 pooled values, pass 1 doubles
+      for (int iPass = 0; iPass < 2; iPass++) {
+        ClpSimplex solution;
+        solution.loadProblem(*m.getMatrixByCol(), m.getColLower(), m.getColUpper(),
+          m.getObjCoefficients(),
+          m.getRowLower(), m.getRowUpper());
+        ClpCompressedMatrix *compressed = new ClpCompressedMatrix(*m.getMatrixByCol(),
+          iPass == 0);
+        assert(compressed->getNumElements() == m.getNumElements());
+        assert(compressed->compressedBytes() < 12 * m.getNumElements());
+        solution.replaceMatrix(compressed, true);
+        solution.dual();
+        assert(solution.status() == 0);
+        CoinRelFltEq eq(1.0e-8);
+        assert(eq(solution.objectiveValue(), -4.6475314286e+02));
+        solution.allSlackBasis(true);
+        solution.primal();
+        assert(eq(solution.objectiveValue(), -4.6475314286e+02));
+        // check products against packed copy
+        int numberRows = solution.numberRows();
+        int numberColumns = solution.numberColumns();
+        double *result = new double[numberRows];
+        CoinFillN(result, numberRows, 0.0);
+        compressed->times(1.0, solution.primalColumnSolution(), result);
+        const double *rowActivity = solution.primalRowSolution();
+        for (int iRow = 0; iRow < numberRows; iRow++)
+          assert(fabs(result[iRow] - rowActivity[iRow]) < 1.0e-7);
+        delete[] result;
+        result = new double[2 * numberColumns];
+        double *result2 = result + numberColumns;
+        CoinFillN(result, 2 * numberColumns, 0.0);
+        compressed->transposeTimes(1.0, solution.dualRowSolution(), result2);
+        m.getMatrixByCol()->transposeTimes(solution.dualRowSolution(), result);
+        for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+          assert(fabs(result[iColumn] - result2[iColumn]) < 1.0e-10);
+        delete[] result;
+      }
+    } else {
+      std::cerr << "Error reading afiro from sample data. Skipping test." << std::endl;
+    }
+    /* Rows far apart need escaped deltas and all different values
+       which are exactly floats go in as floats */
+    {
+      int numberRows = 140000;
+      int numberColumns = 300;
+      CoinBigIndex *start = new CoinBigIndex[numberColumns + 1];
+      int *row = new int[3 * numberColumns];
+      double *element = new double[3 * numberColumns];
+      CoinBigIndex numberElements = 0;
+      for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+        start[iColumn] = numberElements;
+        row[numberElements] = iColumn;
+        element[numberElements] = 0.5 * (numberElements + 1);
+        numberElements++;
+        // gap of more than 65535
+        row[numberElements] = iColumn + 70000;
+        element[numberElements] = -0.25 * (numberElements + 1);
+        numberElements++;
+        if ((iColumn & 1) != 0) {
+          // first row also needs escape
+          row[numberElements] = numberRows - 1 - iColumn;
+          element[numberElements] = 0.125 * (numberElements + 1);
+          numberElements++;
+        }
+      }
+      start[numberColumns] = numberElements;
+      CoinPackedMatrix matrix(true, numberRows, numberColumns, numberElements,
+        element, row, start, NULL);
+      ClpCompressedMatrix compressed(matrix);
+      assert(compressed.valueType() == ClpCompressedMatrix::valuesFloat);
+      assert(compressed.getNumElements() == numberElements);
+      double *x = new double[numberColumns + numberRows];
+      double *y = x + numberColumns;
+      for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+        x[iColumn] = 1.0 + 0.01 * iColumn;
+      for (int iRow = 0; iRow < numberRows; iRow++)
+        y[iRow] = (iRow % 7) - 3.0;
+      double *result = new double[2 * (numberColumns + numberRows)];
+      double *result2 = result + numberColumns + numberRows;
+      CoinZeroN(result, 2 * (numberColumns + numberRows));
+      compressed.times(1.0, x, result);
+      matrix.times(x, result2);
+      for (int iRow = 0; iRow < numberRows; iRow++)
+        assert(fabs(result[iRow] - result2[iRow]) < 1.0e-12 * (1.0 + fabs(result2[iRow])));
+      CoinZeroN(result, 2 * (numberColumns + numberRows));
+      compressed.transposeTimes(1.0, y, result);
+      matrix.transposeTimes(y, result2);
+      for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+        assert(fabs(result[iColumn] - result2[iColumn]) < 1.0e-12 * (1.0 + fabs(result2[iColumn])));
+      delete[] result;
+      delete[] x;
+      delete[] start;
+      delete[] row;
+      delete[] element;
+    }
+  }
+  // test borrowed matrix arrays
+  {
+    CoinMpsIO m;
+    std::string fn = dirSample + "afiro";
+    if (m.readMps(fn.c_str(), "mps") == 0) {
+      const CoinPackedMatrix *matrix = m.getMatrixByCol();
+      int numberColumns = matrix->getNumCols();
+      CoinBigIndex numberElements = matrix->getNumElements();
+      // arrays are caller's so keep copies to check not changed
+      CoinPackedMatrix copy(*matrix, 0, 0);
+      CoinBigIndex *start = CoinCopyOfArray(copy.getVectorStarts(), numberColumns + 1);
+      int *row = CoinCopyOfArray(copy.getIndices(), numberElements);
+      double *element = CoinCopyOfArray(copy.getElements(), numberElements);
+      ClpSimplex solution;
+      solution.loadProblem(numberColumns, m.getNumRows(), start, row, element,
+        m.getColLower(), m.getColUpper(), m.getObjCoefficients(),
+        m.getRowLower(), m.getRowUpper(), NULL, true);
+      ClpPackedMatrix *clpMatrix = dynamic_cast< ClpPackedMatrix * >(solution.clpMatrix());
+      assert(clpMatrix && clpMatrix->borrowed());
+      assert(clpMatrix->getElements() == element);
+      assert(clpMatrix->getNumRows() == m.getNumRows());
+      solution.dual();
+      assert(solution.status() == 0);
+      CoinRelFltEq eq(1.0e-8);
+      assert(eq(solution.objectiveValue(), -4.6475314286e+02));
+      // copy of model has own arrays
+      ClpSimplex solution2(solution);
+      assert(!dynamic_cast< ClpPackedMatrix * >(solution2.clpMatrix())->borrowed());
+      // changing matrix makes a copy
+      int deleteRow = 0;
+      solution.deleteRows(1, &deleteRow);
+      assert(!clpMatrix->borrowed());
+      for (CoinBigIndex j = 0; j < numberElements; j++)
+        assert(row[j] == copy.getIndices()[j] && element[j] == copy.getElements()[j]);
+      solution2.primal();
+      assert(eq(solution2.objectiveValue(), -4.6475314286e+02));
+      // asking for CoinPackedMatrix makes a copy as it may be changed
+      ClpSimplex solution3;
+      solution3.loadProblem(numberColumns, m.getNumRows(), start, row, element,
+        m.getColLower(), m.getColUpper(), m.getObjCoefficients(),
+        m.getRowLower(), m.getRowUpper(), NULL, true);
+      clpMatrix = dynamic_cast< ClpPackedMatrix * >(solution3.clpMatrix());
+      assert(clpMatrix->borrowed());
+      solution3.matrix()->modifyCoefficient(row[0], 0, 2.0 * element[0]);
+      assert(!clpMatrix->borrowed());
+      assert(clpMatrix->getElements() != element);
+      assert(element[0] == copy.getElements()[0]);
+      delete[] start;
+      delete[] row;
+      delete[] element;
+    } else {
+      std::cerr << "Error reading afiro from sample data. Skipping test." << std::endl;
+    }
+  }
+  // test scaling borrowed matrix arrays with tiny elements
+  {
+    CoinMpsIO m;
+    std::string fn = dirSample + "afiro";
+    if (m.readMps(fn.c_str(), "mps") == 0) {
+      const CoinPackedMatrix *matrix = m.getMatrixByCol();
+      int numberRows = matrix->getNumRows();
+      int numberColumns = matrix->getNumCols();
+      CoinBigIndex numberElements = matrix->getNumElements();
+      // add an element of 1.0e-25 to every third column
+      CoinBigIndex *start = new CoinBigIndex[numberColumns + 1];
+      int *row = new int[numberElements + numberColumns];
+      double *element = new double[numberElements + numberColumns];
+      char *mark = new char[numberRows];
+      CoinBigIndex n = 0;
+      start[0] = 0;
+      for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+        CoinShallowPackedVector column = matrix->getVector(iColumn);
+        CoinZeroN(mark, numberRows);
+        for (int j = 0; j < column.getNumElements(); j++) {
+          row[n] = column.getIndices()[j];
+          mark[row[n]] = 1;
+          element[n++] = column.getElements()[j];
+        }
+        if ((iColumn % 3) == 0) {
+          int iRow = 0;
+          while (mark[iRow])
+            iRow++;
+          row[n] = iRow;
+          element[n++] = 1.0e-25;
+        }
+        start[iColumn + 1] = n;
+      }
+      CoinBigIndex numberWithTiny = n;
+      int *saveRow = CoinCopyOfArray(row, numberWithTiny);
+      double *saveElement = CoinCopyOfArray(element, numberWithTiny);
+      ClpSimplex solution;
+      solution.loadProblem(numberColumns, numberRows, start, row, element,
+        m.getColLower(), m.getColUpper(), m.getObjCoefficients(),
+        m.getRowLower(), m.getRowUpper(), NULL, true);
+      ClpPackedMatrix *clpMatrix = dynamic_cast< ClpPackedMatrix * >(solution.clpMatrix());
+      assert(clpMatrix && clpMatrix->borrowed());
+      // scale directly (solve would drop tiny elements before scaling)
+      solution.scaling(3);
+      clpMatrix->scale(&solution);
+      // scaling dropped tiny elements in own copy - each counted once
+      assert(!clpMatrix->borrowed());
+      assert(clpMatrix->getNumElements() == numberElements);
+      const CoinBigIndex *columnStart = clpMatrix->getVectorStarts();
+      const int *columnLength = clpMatrix->getVectorLengths();
+      const double *elementByColumn = clpMatrix->getElements();
+      for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+        assert(columnLength[iColumn] == matrix->getVectorSize(iColumn));
+        for (CoinBigIndex j = columnStart[iColumn];
+             j < columnStart[iColumn] + columnLength[iColumn]; j++)
+          assert(fabs(elementByColumn[j]) > 1.0e-20);
+      }
+      // caller's arrays not changed
+      for (CoinBigIndex j = 0; j < numberWithTiny; j++)
+        assert(row[j] == saveRow[j] && element[j] == saveElement[j]);
+      // and model still solves (scaled afresh)
+      solution.scaling(0);
+      solution.scaling(3);
+      solution.dual();
+      assert(solution.status() == 0);
+      CoinRelFltEq eq(1.0e-8);
+      assert(eq(solution.objectiveValue(), -4.6475314286e+02));
+      delete[] start;
+      delete[] row;
+      delete[] element;
+      delete[] mark;
+      delete[] saveRow;
+      delete[] saveElement;
+    } else {
+      std::cerr << "Error reading afiro from sample data. Skipping test." << std::endl;
+    }
+  }
+  // test resolves with kept work arrays
+  {
+    CoinMpsIO m;
+    std::string fn = dirSample + "afiro";
+    if (m.readMps(fn.c_str(), "mps") == 0) {
+      ClpSimplex solution;
+      solution.loadProblem(*m.getMatrixByCol(), m.getColLower(), m.getColUpper(),
+        m.getObjCoefficients(),
+        m.getRowLower(), m.getRowUpper());
+      assert(solution.keepWorkArrays());
+      CoinRelFltEq eq(1.0e-8);
+      int numberColumns = solution.numberColumns();
+      double *objective = solution.objective();
+      // alternate primal and dual from scratch with arrays kept
+      for (int iPass = 0; iPass < 4; iPass++) {
+        solution.allSlackBasis(true);
+        if ((iPass & 1) == 0)
+          solution.primal();
+        else
+          solution.dual();
+        assert(solution.status() == 0);
+        assert(eq(solution.objectiveValue(), -4.6475314286e+02));
+      }
+      // change objective and check against fresh model
+      for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+        objective[iColumn] *= 1.0 + 0.01 * (iColumn % 3);
+      solution.primal();
+      assert(solution.factorization()->persistenceFlag() == 1);
+      ClpSimplex fresh(solution);
+      fresh.setKeepWorkArrays(false);
+      fresh.allSlackBasis(true);
+      fresh.primal();
+      // factorization arrays no longer kept either
+      assert(!fresh.factorization()->persistenceFlag());
+      assert(solution.status() == 0 && fresh.status() == 0);
+      assert(eq(solution.objectiveValue(), fresh.objectiveValue()));
+    } else {
+      std::cerr << "Error reading afiro from sample data. Skipping test." << std::endl;
+    }
+  }
+  // test abc factorization memory modes give same solution
+  {
+    CoinMpsIO m;
+    std::string fn = dirSample + "brandy";
+    if (m.readMps(fn.c_str(), "mps") == 0) {
+      double objectiveValue[4];
+      for (int memoryMode = 0; memoryMode < 4; memoryMode++) {
+        ClpSimplex solution;
+        solution.loadProblem(*m.getMatrixByCol(), m.getColLower(), m.getColUpper(),
+          m.getObjCoefficients(),
+          m.getRowLower(), m.getRowUpper());
+#ifdef ABC_INHERIT
+        solution.setAbcState(1);
+#endif
+        ClpSolve solveOptions;
+        solveOptions.setSolveType(ClpSolve::useDual);
+        solveOptions.setSpecialOption(6, 2 * memoryMode);
+        solution.initialSolve(solveOptions);
+        assert(solution.status() == 0);
+        objectiveValue[memoryMode] = solution.objectiveValue();
+      }
+      CoinRelFltEq eq(1.0e-8);
+      for (int memoryMode = 1; memoryMode < 4; memoryMode++)
+        assert(eq(objectiveValue[memoryMode], objectiveValue[0]));
+    } else {
+      std::cerr << "Error reading brandy from sample data. Skipping test." << std::endl;
+    }
+  }
+  // test sparse statistics and adaptive hypersparse
+  {
+    CoinMpsIO m;
+    std::string fn = dirSample + "brandy";
+    if (m.readMps(fn.c_str(), "mps") == 0) {
+      ClpSimplex solution;
+      solution.loadProblem(*m.getMatrixByCol(), m.getColLower(), m.getColUpper(),
+        m.getObjCoefficients(),
+        m.getRowLower(), m.getRowUpper());
+      ClpFactorization *factorization = solution.factorization();
+      factorization->setSparseStatisticsLevel(2);
+      factorization->setAdaptiveSparse(true);
+      solution.dual();
+      assert(solution.status() == 0);
+      CoinRelFltEq eq(1.0e-8);
+      assert(eq(solution.objectiveValue(), 1.5185098965e+03));
+      const ClpSparseStatistics &stats = factorization->sparseStatistics();
+      assert(stats.numberCalls[2] > 0);
+      int total = 0;
+      for (int j = 0; j < CLP_SPARSE_BUCKETS; j++)
+        total += stats.histogram[2][j];
+      assert(total == stats.numberCalls[2]);
+      solution.allSlackBasis(true);
+      solution.primal();
+      assert(eq(solution.objectiveValue(), 1.5185098965e+03));
+    } else {
+      std::cerr << "Error reading brandy from sample data. Skipping test." << std::endl;
+    }
+  }
+  // test block triangular factorization
+  {
+    CoinMpsIO m;
+    std::string fn = dirSample + "afiro";
+    if (m.readMps(fn.c_str(), "mps") == 0) {
+      ClpSimplex solution;
+      solution.loadProblem(*m.getMatrixByCol(), m.getColLower(), m.getColUpper(),
+        m.getObjCoefficients(),
+        m.getRowLower(), m.getRowUpper());
+      CoinRelFltEq eq(1.0e-8);
+      solution.factorization()->setBlockTriangular(100);
+      solution.primal();
+      assert(solution.status() == 0);
+      assert(eq(solution.objectiveValue(), -4.6475314286e+02));
+      solution.allSlackBasis(true);
+      solution.dual();
+      assert(solution.status() == 0);
+      assert(eq(solution.objectiveValue(), -4.6475314286e+02));
+      // only triangular bases done by blocks
+      solution.factorization()->setBlockTriangular(1);
+      solution.allSlackBasis(true);
+      solution.primal();
+      assert(solution.status() == 0);
+      assert(eq(solution.objectiveValue(), -4.6475314286e+02));
+    } else {
+      std::cerr << "Error reading afiro from sample data. Skipping test." << std::endl;
+    }
+  }
+  // test block triangular FTRAN and BTRAN where dense block needs pivoting
+  {
+    /* Columns 0-3 (matched to rows 0-3) are one 4x4 block whose
+       partial pivoting swaps rows after the first step.
+       Columns 4 and 5 are 1x1 blocks below it. */
+    int numberRows = 6;
+    double block[4][4] = { { 1.0, 2.0, 0.0, 1.0 }, { 1.0, 1.0, 3.0, 0.0 },
+      { 0.0, 4.0, 1.0, 2.0 }, { 3.0, 0.0, 1.0, 1.0 } };
+    CoinPackedMatrix matrix(true, 0, 0);
+    matrix.setDimensions(numberRows, 0);
+    for (int iColumn = 0; iColumn < 4; iColumn++) {
+      CoinPackedVector column;
+      // diagonal first so that is match
+      column.insert(iColumn, block[iColumn][iColumn]);
+      for (int iRow = 0; iRow < 4; iRow++) {
+        if (iRow != iColumn && block[iRow][iColumn])
+          column.insert(iRow, block[iRow][iColumn]);
+      }
+      matrix.appendCol(column);
+    }
+    int row4[] = { 4, 0 };
+    double element4[] = { 2.0, 1.0 };
+    matrix.appendCol(2, row4, element4);
+    int row5[] = { 5, 4, 2 };
+    double element5[] = { -3.0, 1.0, 0.5 };
+    matrix.appendCol(3, row5, element5);
+    double rhs[] = { 1.0, -2.0, 3.0, 0.5, -1.0, 2.0 };
+    double lower[] = { -COIN_DBL_MAX, -COIN_DBL_MAX, -COIN_DBL_MAX,
+      -COIN_DBL_MAX, -COIN_DBL_MAX, -COIN_DBL_MAX };
+    double upper[] = { COIN_DBL_MAX, COIN_DBL_MAX, COIN_DBL_MAX,
+      COIN_DBL_MAX, COIN_DBL_MAX, COIN_DBL_MAX };
+    ClpSimplex model;
+    model.loadProblem(matrix, lower, upper, NULL, rhs, rhs);
+    model.scaling(0);
+    model.setLogLevel(0);
+    model.factorization()->setBlockTriangular(10);
+    model.dual();
+    assert(model.status() == 0);
+    // all columns basic so factorize that basis directly
+    int pivotTemp[] = { 0, 1, 2, 3, 4, 5 };
+    ClpBlockBasis blockBasis;
+    int returnCode = blockBasis.factorize(&model, pivotTemp, 0, 10, 1.0e-13);
+    assert(!returnCode);
+    assert(blockBasis.numberBlocks() == 3 && blockBasis.largestBlock() == 4);
+    const int *pivotVariable = model.pivotVariable();
+    const CoinBigIndex *columnStart = matrix.getVectorStarts();
+    const int *columnLength = matrix.getVectorLengths();
+    const int *row = matrix.getIndices();
+    const double *element = matrix.getElements();
+    CoinIndexedVector work;
+    CoinIndexedVector region;
+    work.reserve(numberRows);
+    region.reserve(numberRows);
+    // FTRAN - result is by pivot row so check B x - rhs
+    for (int iRow = 0; iRow < numberRows; iRow++)
+      region.insert(iRow, rhs[iRow]);
+    blockBasis.updateColumn(&work, &region);
+    double residual[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    const double *x = region.denseVector();
+    for (int iPivot = 0; iPivot < numberRows; iPivot++) {
+      int iColumn = pivotVariable[iPivot];
+      assert(iColumn < numberRows);
+      for (CoinBigIndex j = columnStart[iColumn];
+           j < columnStart[iColumn] + columnLength[iColumn]; j++)
+        residual[row[j]] += element[j] * x[iPivot];
+    }
+    for (int iRow = 0; iRow < numberRows; iRow++)
+      assert(fabs(residual[iRow] - rhs[iRow]) < 1.0e-12);
+    // same as simplex solution
+    for (int iPivot = 0; iPivot < numberRows; iPivot++)
+      assert(fabs(x[iPivot] - model.primalColumnSolution()[pivotVariable[iPivot]]) < 1.0e-7);
+    region.clear();
+    // BTRAN - input by pivot row so check B(transpose) y - cost
+    double cost[] = { 2.0, 1.0, -1.0, 0.5, 3.0, -2.0 };
+    for (int iPivot = 0; iPivot < numberRows; iPivot++)
+      region.insert(iPivot, cost[iPivot]);
+    blockBasis.updateColumnTranspose(&work, &region);
+    const double *y = region.denseVector();
+    for (int iPivot = 0; iPivot < numberRows; iPivot++) {
+      int iColumn = pivotVariable[iPivot];
+      double value = 0.0;
+      for (CoinBigIndex j = columnStart[iColumn];
+           j < columnStart[iColumn] + columnLength[iColumn]; j++)
+        value += element[j] * y[row[j]];
+      assert(fabs(value - cost[iPivot]) < 1.0e-12);
+    }
+  }
+  // test task pool
+  {
+    ClpTaskPool pool(2);
+#ifdef CLP_USE_PTHREADS
+    // --enable-clp-threads (or Abc inherit) so really threaded
+    assert(pool.numberThreads() == 2);
+#else
+    assert(pool.numberThreads() == 0);
+#endif
+    // tasks with futures
+    int value[4] = { 1, 2, 3, 4 };
+    ClpTaskFuture futures[4];
+    for (int i = 0; i < 4; i++)
+      pool.submit(clpPoolTask, value + i, futures + i);
+    for (int i = 0; i < 4; i++) {
+      assert(futures[i].wait() == value[i] + 1);
+      assert(futures[i].finished());
+    }
+    // caller is not a worker
+    assert(pool.whichThread() == pool.numberThreads());
+    int count[1000];
+    CoinZeroN(count, 1000);
+    pool.parallelFor(0, 1000, 10, clpPoolAddOne, count);
+    // pin threads - may not be allowed so just check count
+    int numberPinned = pool.setAffinity(0, 1);
+    assert(numberPinned >= 0 && numberPinned <= pool.numberThreads());
+    // still works when pinned (and for threads added later)
+    pool.parallelFor(0, 1000, 10, clpPoolAddOne, count);
+    for (int i = 0; i < 1000; i++)
+      assert(count[i] == 2);
+    assert(pool.setAffinity(0, 0) == 0);
+  }
+#ifdef CLP_USE_PTHREADS
+  // test shared pool made once when asked for by several threads
+  {
+    ClpTaskPool::deleteShared();
+    pthread_t threads[8];
+    ClpTaskPool *pools[8];
+    for (int i = 0; i < 8; i++)
+      pthread_create(threads + i, NULL, clpGetSharedPool, pools + i);
+    for (int i = 0; i < 8; i++)
+      pthread_join(threads[i], NULL);
+    for (int i = 0; i < 8; i++)
+      assert(pools[i] == ClpTaskPool::sharedIfExists());
+    assert(pools[0]->numberThreads() == 2);
+    ClpTaskPool::deleteShared();
+  }
+  // test batch solve only waits for its own problems
+  {
+    ClpSimplex model;
+    if (loadSample(dirSample, "afiro", model)) {
+      ClpTaskPool *pool = ClpTaskPool::shared(2);
+      volatile int stop = 0;
+      ClpTaskFuture busy;
+      // one worker busy with something else
+      pool->submit(clpPoolBusyTask, const_cast< int * >(&stop), &busy);
+      const CoinPackedMatrix *matrix = model.matrix();
+      Clp_BatchProblem problems[3];
+      memset(problems, 0, sizeof(problems));
+      for (int i = 0; i < 3; i++) {
+        problems[i].numberColumns = model.numberColumns();
+        problems[i].numberRows = model.numberRows();
+        problems[i].start = matrix->getVectorStarts();
+        problems[i].index = matrix->getIndices();
+        problems[i].value = matrix->getElements();
+        problems[i].collb = model.columnLower();
+        problems[i].colub = model.columnUpper();
+        problems[i].obj = model.objective();
+        problems[i].rowlb = model.rowLower();
+        problems[i].rowub = model.rowUpper();
+      }
+      int numberBad = Clp_solveBatch(3, problems, 2, 0);
+      // busy task still going so batch did not wait for it
+      assert(!busy.finished());
+      stop = 1;
+      assert(busy.wait() == 0);
+      assert(!numberBad);
+      CoinRelFltEq eq(1.0e-8);
+      for (int i = 0; i < 3; i++)
+        assert(eq(problems[i].objectiveValue, -4.6475314286e+02));
+      ClpTaskPool::deleteShared();
+    }
+  }
+#if CLP_HAS_ABC && ABC_PARALLEL != 2
+  // test dense LU with trailing update on threads same as serial
+  {
+    int n = 65 * BLOCKING8;
+    double *a = new double[2 * n * n];
+    double *a2 = a + n * n;
+    int *ipiv = new int[2 * n];
+    int *ipiv2 = ipiv + n;
+    CoinThreadRandom randomGenerator(1234567);
+    for (int i = 0; i < n * n; i++)
+      a[i] = randomGenerator.randomDouble() - 0.5;
+    CoinMemcpyN(a, n * n, a2);
+    ClpTaskPool::deleteShared();
+    int status = CoinAbcDgetrf(n, n, a, n, ipiv);
+    ClpTaskPool::shared(2);
+    int status2 = CoinAbcDgetrf(n, n, a2, n, ipiv2);
+    ClpTaskPool::deleteShared();
+    assert(!status && !status2);
+    for (int i = 0; i < n; i++)
+      assert(ipiv[i] == ipiv2[i]);
+    for (int i = 0; i < n * n; i++)
+      assert(a[i] == a2[i]);
+    delete[] a;
+    delete[] ipiv;
+  }
+#endif
+#endif
+  // test barrier with crossover pushing in parallel
+  {
+    CoinMpsIO m;
+    std::string fn = dirSample + "afiro";
+    if (m.readMps(fn.c_str(), "mps") == 0) {
+      // four copies of afiro with no rows in common
+      const CoinPackedMatrix *matrix = m.getMatrixByCol();
+      int numberRows = m.getNumRows();
+      int numberColumns = m.getNumCols();
+      int numberCopies = 4;
+      CoinPackedMatrix big(true, 0, 0);
+      big.setDimensions(numberCopies * numberRows, 0);
+      double *columnLower = new double[numberCopies * numberColumns];
+      double *columnUpper = new double[numberCopies * numberColumns];
+      double *objective = new double[numberCopies * numberColumns];
+      double *rowLower = new double[numberCopies * numberRows];
+      double *rowUpper = new double[numberCopies * numberRows];
+      int *row = new int[numberRows];
+      for (int iCopy = 0; iCopy < numberCopies; iCopy++) {
+        for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+          CoinShallowPackedVector column = matrix->getVector(iColumn);
+          for (int j = 0; j < column.getNumElements(); j++)
+            row[j] = column.getIndices()[j] + iCopy * numberRows;
+          big.appendCol(column.getNumElements(), row, column.getElements());
+        }
+        CoinMemcpyN(m.getColLower(), numberColumns, columnLower + iCopy * numberColumns);
+        CoinMemcpyN(m.getColUpper(), numberColumns, columnUpper + iCopy * numberColumns);
+        CoinMemcpyN(m.getObjCoefficients(), numberColumns, objective + iCopy * numberColumns);
+        CoinMemcpyN(m.getRowLower(), numberRows, rowLower + iCopy * numberRows);
+        CoinMemcpyN(m.getRowUpper(), numberRows, rowUpper + iCopy * numberRows);
+      }
+      ClpSimplex solution;
+      solution.loadProblem(big, columnLower, columnUpper, objective,
+        rowLower, rowUpper);
+      delete[] columnLower;
+      delete[] columnUpper;
+      delete[] objective;
+      delete[] rowLower;
+      delete[] rowUpper;
+      delete[] row;
+      ClpPushMessageHandler handler;
+      handler.setLogLevel(2);
+      solution.passInMessageHandler(&handler);
+      ClpTaskPool::shared(2);
+      ClpSolve solveOptions;
+      solveOptions.setSolveType(ClpSolve::useBarrier);
+      solveOptions.setPresolveType(ClpSolve::presolveOff);
+      solution.initialSolve(solveOptions);
+      assert(solution.status() == 0);
+      CoinRelFltEq eq(1.0e-8);
+      assert(eq(solution.objectiveValue(), numberCopies * -4.6475314286e+02));
+#ifndef ABC_INHERIT
+      // copies were pushed as separate subproblems (if really threaded)
+      if (ClpTaskPool::sharedIfExists()->numberThreads() > 0)
+        assert(handler.numberPushed_ >= 2);
+#endif
+      // and a proper basis
+      int numberBasic = 0;
+      for (int i = 0; i < solution.numberRows() + solution.numberColumns(); i++) {
+        if (solution.getStatus(i) == ClpSimplex::basic)
+          numberBasic++;
+      }
+      assert(numberBasic == solution.numberRows());
+      solution.setDefaultMessageHandler();
+      ClpTaskPool::deleteShared();
+    } else {
+      std::cerr << "Error reading afiro from sample data. Skipping test." << std::endl;
+    }
+  }
   // test unbounded
   {
     CoinMpsIO m;
@@ -2344,6 +3398,294 @@ void ClpSimplexUnitTest(const std::string &dirSample)
       std::cerr << "Error reading exmip1 from sample data. Skipping test." << std::endl;
     }
   }
+  // Test barrier with conjugate gradients on normal equations
+  {
+    ClpInterior solution;
+    if (loadSample(dirSample, "afiro", solution)) {
+      ClpCholeskyPCG *cholesky = new ClpCholeskyPCG();
+      solution.setCholesky(cholesky);
+      solution.primalDual();
+      assert(!solution.status());
+      CoinRelFltEq eq(1.0e-5);
+      assert(eq(solution.objectiveValue(), -4.6475314286e+02));
+      // some solves must have been done by conjugate gradients
+      assert(cholesky->numberSolves() > 0);
+      assert(cholesky->numberIterations() > 0);
+    }
+  }
+  // Test barrier with single precision Cholesky and refinement
+  {
+    ClpInterior solution;
+    if (loadSample(dirSample, "afiro", solution)) {
+      ClpCholeskyMixed *cholesky = new ClpCholeskyMixed();
+      solution.setCholesky(cholesky);
+      solution.primalDual();
+      assert(!solution.status());
+      CoinRelFltEq eq(1.0e-5);
+      assert(eq(solution.objectiveValue(), -4.6475314286e+02));
+      /* some solves must have been done in single precision and
+         single precision alone can not reach default tolerance */
+      assert(cholesky->numberSolves() > 0);
+      assert(cholesky->numberRefinements() > 0);
+    }
+  }
+  // Test barrier with dense columns taken out of Cholesky
+  {
+    ClpInterior solution;
+    if (loadSample(dirSample, "afiro", solution)) {
+      // two expensive columns in every row
+      int numberRows = solution.numberRows();
+      int *which = new int[numberRows];
+      double *element = new double[numberRows];
+      for (int iColumn = 0; iColumn < 2; iColumn++) {
+        for (int iRow = 0; iRow < numberRows; iRow++) {
+          which[iRow] = iRow;
+          element[iRow] = 1.0 + 0.1 * ((iRow + iColumn) % 3);
+        }
+        solution.addColumn(numberRows, which, element, 0.0, 1.0, 1.0e4);
+      }
+      delete[] which;
+      delete[] element;
+      ClpCholeskyBase *cholesky = new ClpCholeskyBase(20);
+      solution.setCholesky(cholesky);
+      solution.primalDual();
+      assert(!solution.status());
+      CoinRelFltEq eq(1.0e-5);
+      assert(eq(solution.objectiveValue(), -4.6475314286e+02));
+      assert(cholesky->numberDense() == 2);
+    }
+  }
+  // Test automatic choice of dense columns (as used by ClpSolve)
+  {
+    // each row covered by its own column or by two columns in every row
+    int numberRows = 60;
+    int numberColumns = numberRows + 2;
+    CoinBigIndex *start = new CoinBigIndex[numberColumns + 1];
+    int *row = new int[3 * numberRows];
+    double *element = new double[3 * numberRows];
+    double *columnLower = new double[numberColumns];
+    double *columnUpper = new double[numberColumns];
+    double *objective = new double[numberColumns];
+    double *rowLower = new double[numberRows];
+    double *rowUpper = new double[numberRows];
+    CoinBigIndex numberElements = 0;
+    start[0] = 0;
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+      columnLower[iColumn] = 0.0;
+      columnUpper[iColumn] = COIN_DBL_MAX;
+      if (iColumn < numberRows) {
+        objective[iColumn] = 1.0 + 0.01 * iColumn;
+        row[numberElements] = iColumn;
+        element[numberElements++] = 1.0;
+      } else {
+        objective[iColumn] = 20.0;
+        for (int iRow = 0; iRow < numberRows; iRow++) {
+          row[numberElements] = iRow;
+          element[numberElements++] = 1.0 + 0.1 * ((iRow + iColumn) % 3);
+        }
+      }
+      start[iColumn + 1] = numberElements;
+    }
+    for (int iRow = 0; iRow < numberRows; iRow++) {
+      rowLower[iRow] = 1.0 + 0.01 * iRow;
+      rowUpper[iRow] = COIN_DBL_MAX;
+    }
+    ClpInterior solution;
+    solution.loadProblem(numberColumns, numberRows, start, row, element,
+      columnLower, columnUpper, objective, rowLower, rowUpper);
+    ClpSimplex simplex;
+    simplex.loadProblem(numberColumns, numberRows, start, row, element,
+      columnLower, columnUpper, objective, rowLower, rowUpper);
+    delete[] start;
+    delete[] row;
+    delete[] element;
+    delete[] columnLower;
+    delete[] columnUpper;
+    delete[] objective;
+    delete[] rowLower;
+    delete[] rowUpper;
+    ClpCholeskyBase *cholesky = new ClpCholeskyBase(-2);
+    solution.setCholesky(cholesky);
+    solution.primalDual();
+    assert(!solution.status());
+    // two long columns are nearly all the work of forming A D A'
+    assert(cholesky->numberDense() == 2);
+    simplex.dual();
+    CoinRelFltEq eq(1.0e-5);
+    assert(eq(solution.objectiveValue(), simplex.objectiveValue()));
+  }
+  // Test barrier with no and with fixed number of centrality correctors
+  for (int iPass = 0; iPass < 2; iPass++) {
+    ClpInterior solution;
+    if (!loadSample(dirSample, "afiro", solution))
+      break;
+    solution.setCholesky(new ClpCholeskyBase());
+    solution.setMaximumCorrectors(iPass ? 3 : 0);
+    solution.primalDual();
+    assert(!solution.status());
+    CoinRelFltEq eq(1.0e-5);
+    assert(eq(solution.objectiveValue(), -4.6475314286e+02));
+    if (iPass)
+      assert(solution.numberCorrectors() > 0);
+    else
+      assert(!solution.numberCorrectors());
+  }
+  // Test warm started barrier after small change in costs
+  {
+    ClpInterior solution;
+    ClpInterior cold;
+    ClpSimplex simplex;
+    if (loadSample(dirSample, "afiro", solution)
+      && loadSample(dirSample, "afiro", cold)
+      && loadSample(dirSample, "afiro", simplex)) {
+      solution.setCholesky(new ClpCholeskyBase());
+      solution.primalDual();
+      assert(!solution.status());
+      assert(solution.coldStartIterations() == solution.numberIterations());
+      int numberColumns = solution.numberColumns();
+      double *objective = solution.objective();
+      double *objective2 = simplex.objective();
+      double *objective3 = cold.objective();
+      for (int iColumn = 0; iColumn < numberColumns; iColumn += 3) {
+        objective[iColumn] *= 1.05;
+        objective2[iColumn] *= 1.05;
+        objective3[iColumn] *= 1.05;
+      }
+      simplex.dual();
+      solution.setWarmStart(1);
+      solution.primalDual();
+      assert(!solution.status());
+      // cold start on same changed model
+      cold.setCholesky(new ClpCholeskyBase());
+      cold.primalDual();
+      assert(!cold.status());
+      CoinRelFltEq eq(1.0e-5);
+      assert(eq(solution.objectiveValue(), simplex.objectiveValue()));
+      assert(eq(cold.objectiveValue(), simplex.objectiveValue()));
+      // starting near the old optimum must save iterations
+      assert(solution.numberIterations() < cold.numberIterations());
+    }
+  }
+  // Test barrier keeps symbolic factorization when only costs change
+  {
+    ClpInterior solution;
+    if (loadSample(dirSample, "afiro", solution)) {
+      ClpCholeskyBase *cholesky = new ClpCholeskyBase();
+      solution.setCholesky(cholesky);
+      solution.primalDual();
+      assert(!solution.status());
+      assert(!cholesky->symbolicReused());
+      assert(cholesky->symbolicHash() == cholesky->patternHash(&solution));
+      // double costs and solve again
+      int numberColumns = solution.numberColumns();
+      double *objective = solution.objective();
+      for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+        objective[iColumn] *= 2.0;
+      solution.primalDual();
+      assert(!solution.status());
+      assert(cholesky->symbolicReused());
+      CoinRelFltEq eq(1.0e-5);
+      assert(eq(solution.objectiveValue(), -9.2950628572e+02));
+      // and through file
+      ClpInterior solution2;
+      if (!cholesky->saveSymbolic("afiro.sym")
+        && loadSample(dirSample, "afiro", solution2)) {
+        ClpCholeskyBase *cholesky2 = new ClpCholeskyBase();
+        int returnCode = cholesky2->restoreSymbolic("afiro.sym");
+        assert(!returnCode);
+        solution2.setCholesky(cholesky2);
+        solution2.primalDual();
+        assert(!solution2.status());
+        assert(cholesky2->symbolicReused());
+        assert(eq(solution2.objectiveValue(), -4.6475314286e+02));
+        remove("afiro.sym");
+      }
+    }
+  }
+  // Test pdco products with model matrix and residuals over threads
+  {
+    // enough columns for products and residuals to be split
+    int numberRows = 20;
+    int numberColumns = 40000;
+    ClpEntropyPdco stuff(1.0e-3, 1.0e-3);
+    double r3norm[2];
+    int inform[2];
+#ifdef CLP_USE_PTHREADS
+    // second pass with threads
+    int numberPasses = 2;
+#else
+    // pool would have no threads so second pass same as first
+    int numberPasses = 1;
+#endif
+    for (int iPass = 0; iPass < numberPasses; iPass++) {
+      if (iPass) {
+        ClpTaskPool *pool = ClpTaskPool::shared(2);
+        assert(pool->numberThreads() == 2);
+      }
+      ClpInterior model;
+      loadEntropyModel(model, numberRows, numberColumns);
+      // products against plain ones
+      double *y = new double[numberColumns];
+      double *x = new double[numberRows];
+      double *x2 = new double[numberRows];
+      for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+        y[iColumn] = 1.0 + 0.001 * (iColumn % 17);
+      CoinZeroN(x, numberRows);
+      CoinZeroN(x2, numberRows);
+      stuff.matVecMult(&model, 1, x, y);
+      model.clpMatrix()->times(1.0, y, x2);
+      for (int iRow = 0; iRow < numberRows; iRow++)
+        assert(fabs(x[iRow] - x2[iRow]) < 1.0e-8 * fabs(x2[iRow]));
+      stuff.matPrecon(&model, 1.0e-3, x, y);
+      const CoinPackedMatrix *matrix = model.matrix();
+      CoinZeroN(x2, numberRows);
+      for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+        CoinShallowPackedVector column = matrix->getVector(iColumn);
+        for (int j = 0; j < column.getNumElements(); j++) {
+          double value = column.getElements()[j] * y[iColumn];
+          x2[column.getIndices()[j]] += value * value;
+        }
+      }
+      for (int iRow = 0; iRow < numberRows; iRow++) {
+        double value = 1.0 / sqrt(x2[iRow] + 1.0e-6);
+        assert(fabs(x[iRow] - value) < 1.0e-10 * value);
+      }
+      delete[] y;
+      delete[] x;
+      delete[] x2;
+      Info info;
+      Outfo outfo;
+      Options options;
+      options.gamma = stuff.getD1();
+      options.delta = stuff.getD2();
+      options.MaxIter = 20;
+      options.FeaTol = 5.0e-4;
+      options.OptTol = 5.0e-4;
+      options.StepTol = 0.99;
+      options.x0min = 0.01;
+      options.z0min = 0.01;
+      options.mu0 = 1.0e-6;
+      options.LSmethod = 3; // LSQR
+      options.LSproblem = 1;
+      options.LSQRMaxIter = 999;
+      options.LSQRatol1 = 1.0e-3;
+      options.LSQRatol2 = 1.0e-6;
+      options.LSQRconlim = 1.0e12;
+      options.wait = 0;
+      info.atolmin = options.LSQRatol2;
+      info.LSdamp = 0.0;
+      info.r3norm = 0.0;
+      info.deltay = NULL;
+      inform[iPass] = model.pdco(&stuff, options, info, outfo);
+      r3norm[iPass] = info.r3norm;
+    }
+#ifdef CLP_USE_PTHREADS
+    ClpTaskPool::deleteShared();
+    // threads only change order of sums
+    assert(inform[0] == inform[1]);
+    assert(fabs(r3norm[0] - r3norm[1]) <= 1.0e-5 * CoinMax(1.0, r3norm[0]));
+#endif
+  }
 #endif
 #if COINUTILS_BIGINDEX_IS_INT
   // test network
@@ -2483,6 +3825,40 @@ void ClpSimplexUnitTest(const std::string &dirSample)
       double time1 = CoinCpuTime();
       model.dual();
       std::cout << "Network problem, ClpPackedMatrix took " << CoinCpuTime() - time1 << " seconds" << std::endl;
+      {
+        // add side constraints so only nearly network
+        ClpSimplex side(model);
+        const double *solution = side.primalColumnSolution();
+        int which[20];
+        double weight[20];
+        for (int iSide = 0; iSide < 3; iSide++) {
+          double sum = 0.0;
+          for (i = 0; i < 20; i++) {
+            which[i] = (7 * i + 5 * iSide) % numberColumns;
+            weight[i] = 1.0 + 0.5 * iSide;
+            sum += weight[i] * solution[which[i]];
+          }
+          side.addRow(20, which, weight, -COIN_DBL_MAX, 0.9 * sum);
+        }
+        ClpSimplex side2(side);
+        side.factorization()->setEmbeddedNetwork(100);
+        time1 = CoinCpuTime();
+        side.dual();
+        std::cout << "Network with side constraints, embedded network took " << CoinCpuTime() - time1 << " seconds" << std::endl;
+        time1 = CoinCpuTime();
+        side2.dual();
+        std::cout << "Network with side constraints, ordinary factorization took " << CoinCpuTime() - time1 << " seconds" << std::endl;
+#ifndef SLIM_CLP
+        // network found with the added rows (at least) as side rows
+        int numberSideRows = side.factorization()->numberSideRows();
+        assert(numberSideRows >= 1 && numberSideRows <= 100);
+        assert(side2.factorization()->numberSideRows() == -1);
+#endif
+        assert(side.status() == side2.status());
+        CoinRelFltEq eq(1.0e-7);
+        if (!side.status())
+          assert(eq(side.objectiveValue(), side2.objectiveValue()));
+      }
       ClpPlusMinusOneMatrix *plusMinus = new ClpPlusMinusOneMatrix(matrix);
       assert(plusMinus->getIndices()); // would be zero if not +- one
       //ClpPlusMinusOneMatrix *plusminus_matrix;
@@ -2649,6 +4025,41 @@ void ClpSimplexUnitTest(const std::string &dirSample)
       model.allSlackBasis();
       model.primal();
       //printSol(model);
+#ifndef NDEBUG
+      // half and full storage give same Hessian times vector
+      ClpQuadraticObjective *quadraticObj = dynamic_cast< ClpQuadraticObjective * >(model.objectiveAsObject());
+      if (quadraticObj) {
+        ClpQuadraticObjective fullObj(*quadraticObj, 1);
+        double *y1 = new double[2 * numberColumns];
+        double *y2 = y1 + numberColumns;
+        CoinZeroN(y1, 2 * numberColumns);
+        const double *solution = model.primalColumnSolution();
+        double form1 = quadraticObj->hessianTimes(solution, y1);
+        double form2 = fullObj.hessianTimes(solution, y2);
+        assert(eq(form1, form2));
+        double form = 0.0;
+        for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+          assert(fabs(y1[iColumn] - y2[iColumn]) < 1.0e-8 * (1.0 + fabs(y1[iColumn])));
+          form += 0.5 * solution[iColumn] * y1[iColumn];
+        }
+        assert(fabs(form - form1) < 1.0e-8 * (1.0 + fabs(form)));
+        delete[] y1;
+        // full storage so primal keeps model objective (and counts)
+        model.setObjective(&fullObj);
+        quadraticObj = dynamic_cast< ClpQuadraticObjective * >(model.objectiveAsObject());
+        model.allSlackBasis();
+        model.primal();
+        assert(eq(model.getObjValue(), -400.92));
+        // gradient was updated from changed columns some of the time
+        assert(quadraticObj->numberIncrementalGradients() > 0);
+        // same answer with full gradient every pass
+        quadraticObj->setIncrementalGradient(false);
+        model.allSlackBasis();
+        model.primal();
+        assert(eq(model.getObjValue(), -400.92));
+        quadraticObj->setIncrementalGradient(true);
+      }
+#endif
     } else {
       std::cerr << "Error reading share2qp from sample data. Skipping test." << std::endl;
     }